@@ -0,0 +1,136 @@
+/*
+    bench/nanobind_bench.cpp: bindings exercised by the microbenchmarks in
+    nanobind_bench.py (measuring per-call overhead, not the work done)
+
+    Copyright (c) 2022 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#include <nanobind/nanobind.h>
+#include <nanobind/trampoline.h>
+#include <nanobind/tensor.h>
+#include <nanobind/stl/function.h>
+#include <nanobind/stl/map.h>
+#include <nanobind/stl/pair.h>
+#include <nanobind/stl/string.h>
+#include <nanobind/stl/tuple.h>
+#include <nanobind/stl/vector.h>
+
+namespace nb = nanobind;
+
+using namespace nb::literals;
+
+struct Item {
+    int value = 0;
+};
+
+struct Holder {
+    Item item;
+};
+
+struct Wrapper {
+    Wrapper(int value) : value(value) { }
+    int value;
+};
+
+struct Base {
+    virtual ~Base() = default;
+    virtual int f(int i) const { return i; }
+};
+
+struct PyBase : Base {
+    NB_TRAMPOLINE(Base, 1);
+
+    int f(int i) const override {
+        NB_OVERRIDE(int, Base, f, i);
+    }
+};
+
+static float tensor_data[1024];
+
+static void bench_init(nb::module_ &m) {
+    // Calls with positional and keyword arguments
+    m.def("call_0", []() { });
+    m.def("call_3", [](int a, int b, int c) { return a + b + c; });
+    m.def("call_3_kw", [](int a, int b, int c) { return a + b + c; },
+          "a"_a, "b"_a, "c"_a = 3);
+
+    // Overload resolution, the last overload matches 'Item' arguments
+    m.def("overloaded", [](int) { return 0; });
+    m.def("overloaded", [](float) { return 1; });
+    m.def("overloaded", [](const std::string &) { return 2; });
+    m.def("overloaded", [](const std::vector<int> &) { return 3; });
+    m.def("overloaded", [](const Item &) { return 4; });
+
+    nb::class_<Item>(m, "Item")
+        .def(nb::init<>())
+        .def_readwrite("value", &Item::value);
+
+    nb::class_<Holder>(m, "Holder")
+        .def(nb::init<>())
+        .def("get", [](Holder &h) -> Item & { return h.item; },
+             nb::rv_policy::reference_internal);
+
+    // Implicit conversions
+    nb::class_<Wrapper>(m, "Wrapper")
+        .def(nb::init_implicit<int>());
+    m.def("take_wrapper", [](const Wrapper &w) { return w.value; });
+    m.def("take_float", [](float f) { return f; });
+
+    // STL round trips
+    m.def("vector_roundtrip", [](const std::vector<int> &v) { return v; });
+    m.def("map_roundtrip", [](const std::map<std::string, int> &v) { return v; });
+
+    // Sequence access (differs between full and limited API builds)
+    m.def("take_pair", [](const std::pair<int, int> &p) { return p.first; });
+    m.def("take_tuple", [](const std::tuple<int, double, std::string> &t) {
+        return std::get<0>(t);
+    });
+    m.def("take_strings", [](const std::vector<std::string> &v) {
+        return v.size();
+    });
+
+    // Callbacks
+    m.def("call_callback", [](const std::function<int(int)> &f, int n) {
+        int result = 0;
+        for (int i = 0; i < n; ++i)
+            result += f(i);
+        return result;
+    });
+
+    // Trampolines
+    nb::class_<Base, PyBase>(m, "Base")
+        .def(nb::init<>())
+        .def("f", &Base::f);
+    m.def("call_virtual", [](const Base &b, int n) {
+        int result = 0;
+        for (int i = 0; i < n; ++i)
+            result += b.f(i);
+        return result;
+    });
+
+    // Tensor import and export
+    m.def("tensor_import", [](nb::tensor<float> t) { return t.shape(0); });
+    m.def("tensor_export", []() {
+        size_t shape[1] = { 1024 };
+        return nb::tensor<float>(tensor_data, 1, shape);
+    });
+    m.def("tensor_export_numpy", []() {
+        size_t shape[1] = { 1024 };
+        return nb::tensor<nb::numpy, float>(tensor_data, 1, shape);
+    });
+    m.def("tensor_export_pytorch", []() {
+        size_t shape[1] = { 1024 };
+        return nb::tensor<nb::pytorch, float>(tensor_data, 1, shape);
+    });
+}
+
+/* The same bindings are also compiled as a stable ABI extension, which
+   exercises the Py_LIMITED_API code paths of nanobind */
+#if defined(NB_BENCH_ABI3)
+NB_MODULE(nanobind_bench_abi3_ext, m) { bench_init(m); }
+#else
+NB_MODULE(nanobind_bench_ext, m) { bench_init(m); }
+#endif
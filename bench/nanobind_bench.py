@@ -0,0 +1,167 @@
+"""
+Microbenchmarks of nanobind's per-call overheads.
+
+Each benchmark times a short statement using 'timeit' and reports the best
+time per execution (in nanoseconds) over several repetitions. The results
+can be written to a JSON file and compared against an earlier run:
+
+    python nanobind_bench.py --json new.json --compare old.json
+
+When the stable ABI build of the extension (nanobind_bench_abi3_ext) is
+available, the benchmarks are repeated using it (with an 'abi3/' prefix) and
+compared against the regular build.
+"""
+
+import argparse
+import array
+import collections
+import gc
+import json
+import platform
+import sys
+import timeit
+
+import nanobind_bench_ext
+
+
+def optional_import(name):
+    try:
+        return __import__(name)
+    except ImportError:
+        return None
+
+
+np = optional_import('numpy')
+torch = optional_import('torch')
+tf = optional_import('tensorflow')
+abi3 = optional_import('nanobind_bench_abi3_ext')
+
+
+def benchmarks(b):
+    """Yields tuples (name, statement, namespace) for the extension 'b'"""
+    class Derived(b.Base):
+        def f(self, i):
+            return i + 1
+
+    item = b.Item()
+    holder = b.Holder()
+    vec = list(range(16))
+    dct = {str(i): i for i in range(16)}
+    base, derived = b.Base(), Derived()
+
+    yield 'call_0', 'f()', {'f': b.call_0}
+    yield 'call_positional', 'f(1, 2, 3)', {'f': b.call_3}
+    yield 'call_keyword', 'f(1, b=2, c=3)', {'f': b.call_3_kw}
+    yield 'call_keyword_default', 'f(a=1, b=2)', {'f': b.call_3_kw}
+    yield 'overload_first', 'f(1)', {'f': b.overloaded}
+    yield 'overload_last', 'f(x)', {'f': b.overloaded, 'x': item}
+    yield 'implicit_float', 'f(1)', {'f': b.take_float}
+    yield 'implicit_constructor', 'f(1)', {'f': b.take_wrapper}
+    yield 'construct_destruct', 'T()', {'T': b.Item}
+    yield 'field_get', 'x.value', {'x': item}
+    yield 'field_set', 'x.value = 1', {'x': item}
+    yield 'reference_internal', 'x.get()', {'x': holder}
+    yield 'vector_roundtrip_16', 'f(v)', {'f': b.vector_roundtrip, 'v': vec}
+    yield 'map_roundtrip_16', 'f(d)', {'f': b.map_roundtrip, 'd': dct}
+    yield 'sequence_pair', 'f(x)', {'f': b.take_pair, 'x': (1, 2)}
+    yield 'sequence_tuple', 'f(x)', {'f': b.take_tuple, 'x': (1, 2.0, 'a')}
+    strs = [str(i) for i in range(256)]
+    yield 'sequence_list_4', 'f(x)', {'f': b.take_strings, 'x': strs[:4]}
+    yield 'sequence_list_256', 'f(x)', {'f': b.take_strings, 'x': strs}
+    yield 'sequence_tuple_4', 'f(x)', \
+        {'f': b.take_strings, 'x': tuple(strs[:4])}
+    yield 'sequence_generic_4', 'f(x)', \
+        {'f': b.take_strings, 'x': collections.UserList(strs[:4])}
+    yield 'callback_python', 'f(g, 1)', {'f': b.call_callback, 'g': abs}
+    yield 'callback_lambda', 'f(g, 1)', \
+        {'f': b.call_callback, 'g': lambda i: i}
+    yield 'virtual_cpp', 'f(x, 1)', {'f': b.call_virtual, 'x': base}
+    yield 'virtual_python', 'f(x, 1)', {'f': b.call_virtual, 'x': derived}
+
+    buf = array.array('f', bytes(4096))
+    yield 'tensor_import_buffer', 'f(x)', {'f': b.tensor_import, 'x': buf}
+    yield 'tensor_export', 'f()', {'f': b.tensor_export}
+    if np is not None:
+        x = np.zeros(1024, dtype=np.float32)
+        yield 'tensor_import_numpy', 'f(x)', {'f': b.tensor_import, 'x': x}
+        yield 'tensor_export_numpy', 'f()', {'f': b.tensor_export_numpy}
+    if torch is not None:
+        x = torch.zeros(1024, dtype=torch.float32)
+        yield 'tensor_import_pytorch', 'f(x)', {'f': b.tensor_import, 'x': x}
+        yield 'tensor_export_pytorch', 'f()', {'f': b.tensor_export_pytorch}
+    if tf is not None:
+        x = tf.zeros(1024, dtype=tf.float32)
+        yield 'tensor_import_tensorflow', 'f(x)', \
+            {'f': b.tensor_import, 'x': x}
+
+
+def measure(stmt, namespace, repeat, min_time):
+    timer = timeit.Timer(stmt, globals=namespace)
+
+    # Calibrate the number of executions per repetition
+    number = 1
+    while True:
+        if timer.timeit(number) >= min_time:
+            break
+        number *= 2
+
+    gc.collect()
+    times = timer.repeat(repeat=repeat, number=number)
+    return min(times) / number * 1e9, number
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().split('\n')[0])
+    parser.add_argument('--json', metavar='FILE',
+                        help='write the results to a JSON file')
+    parser.add_argument('--compare', metavar='FILE',
+                        help='compare against results of an earlier run')
+    parser.add_argument('--filter', default='',
+                        help='only run benchmarks containing this string')
+    parser.add_argument('--repeat', type=int, default=5,
+                        help='number of repetitions (default: 5)')
+    parser.add_argument('--min-time', type=float, default=0.05,
+                        help='minimum duration of a repetition in seconds '
+                        '(default: 0.05)')
+    args = parser.parse_args()
+
+    baseline = {}
+    if args.compare:
+        with open(args.compare) as f:
+            baseline = {r['name']: r['ns'] for r in json.load(f)['results']}
+
+    modules = [('', nanobind_bench_ext)]
+    if abi3 is not None:
+        modules.append(('abi3/', abi3))
+
+    results, full_api = [], {}
+    for prefix, module in modules:
+        for name, stmt, namespace in benchmarks(module):
+            if args.filter not in name:
+                continue
+            ns, number = measure(stmt, namespace, args.repeat, args.min_time)
+            if not prefix:
+                full_api[name] = ns
+            name = prefix + name
+            results.append({'name': name, 'ns': ns, 'number': number})
+
+            line = '%-33s %10.1f ns' % (name, ns)
+            if name in baseline:
+                line += '   %+6.1f%%' % ((ns / baseline[name] - 1) * 100)
+            if prefix and name[len(prefix):] in full_api:
+                line += '   (%.2fx full API)' % (ns / full_api[name[len(prefix):]])
+            print(line, flush=True)
+
+    if args.json:
+        with open(args.json, 'w') as f:
+            json.dump({
+                'python': sys.version,
+                'implementation': platform.python_implementation(),
+                'platform': platform.platform(),
+                'machine': platform.machine(),
+                'results': results
+            }, f, indent=2)
+
+
+if __name__ == '__main__':
+    main()
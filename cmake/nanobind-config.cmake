@@ -70,6 +70,9 @@ function (nanobuild_build_library TARGET_NAME TARGET_TYPE)
     ${NB_DIR}/include/nanobind/nb_types.h
     ${NB_DIR}/include/nanobind/trampoline.h
     ${NB_DIR}/include/nanobind/tensor.h
+    ${NB_DIR}/include/nanobind/parallel.h
+    ${NB_DIR}/include/nanobind/async_callback.h
+    ${NB_DIR}/include/nanobind/make_iterator.h
     ${NB_DIR}/include/nanobind/operators.h
     ${NB_DIR}/include/nanobind/stl/shared_ptr.h
     ${NB_DIR}/include/nanobind/stl/unique_ptr.h
@@ -78,6 +81,7 @@ function (nanobuild_build_library TARGET_NAME TARGET_TYPE)
     ${NB_DIR}/include/nanobind/stl/tuple.h
     ${NB_DIR}/include/nanobind/stl/pair.h
     ${NB_DIR}/include/nanobind/stl/function.h
+    ${NB_DIR}/include/nanobind/stl/future.h
     ${NB_DIR}/include/nanobind/stl/vector.h
     ${NB_DIR}/include/nanobind/stl/list.h
     ${NB_DIR}/include/nanobind/stl/optional.h
@@ -94,6 +98,9 @@ function (nanobuild_build_library TARGET_NAME TARGET_TYPE)
     ${NB_DIR}/src/tensor.cpp
     ${NB_DIR}/src/trampoline.cpp
     ${NB_DIR}/src/implicit.cpp
+    ${NB_DIR}/src/parallel.cpp
+    ${NB_DIR}/src/future.cpp
+    ${NB_DIR}/src/async_callback.cpp
   )
 
   if (TARGET_TYPE STREQUAL "SHARED")
@@ -128,6 +135,10 @@ function (nanobuild_build_library TARGET_NAME TARGET_TYPE)
     target_link_libraries(${TARGET_NAME} PUBLIC Python::Module)
   endif()
 
+  # Worker threads of nb::parallel_for()
+  find_package(Threads REQUIRED)
+  target_link_libraries(${TARGET_NAME} PRIVATE Threads::Threads)
+
   target_include_directories(${TARGET_NAME} PRIVATE
     ${NB_DIR}/include
     ${NB_DIR}/ext/robin_map/include
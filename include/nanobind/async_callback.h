@@ -0,0 +1,131 @@
+/*
+    nanobind/async_callback.h: Python callables invoked in batches on
+    behalf of C++ worker threads
+
+    Copyright (c) 2022 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <nanobind/nanobind.h>
+#include <memory>
+#include <tuple>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+/// Invocation queued by an async_callback<>, see async_push()
+struct async_call {
+    async_call(void (*func)(async_call *, bool)) : func(func) { }
+
+    async_call *next = nullptr;
+
+    /// Perform the call (if 'run' is set, with the GIL held) and release
+    /// the entry
+    void (*func)(async_call *, bool run);
+};
+
+/// Python callable referenced by an async_callback<> and its queued calls
+struct async_handle {
+    object f;
+    async_queue *queue;
+    explicit async_handle(handle h) : f(borrow(h)), queue(async_queue_get()) { }
+    ~async_handle() { async_release(queue, f.release().ptr()); }
+};
+
+NAMESPACE_END(detail)
+
+template <typename Signature> class async_callback;
+
+/**
+ * \brief Python callable that C++ threads can invoke without the GIL
+ *
+ * Calling the object copies the arguments into an entry of a lock-free queue
+ * shared by all asynchronous callbacks of the interpreter that created it,
+ * and returns immediately. The queue is drained in batches while holding the
+ * GIL, so a single acquisition serves many invocations: on the main thread
+ * when the interpreter next handles pending calls (``Py_AddPendingCall()``),
+ * or explicitly via nb::async_drain() (``nanobind.drain_callbacks()`` in
+ * Python). Since CPython only runs pending calls in the main interpreter,
+ * the thread that schedules a drain of a sub-interpreter's queue performs it
+ * itself. Calls from the same thread run in order. Exceptions raised by the
+ * callable are reported via ``sys.unraisablehook``. Calls that remain queued
+ * when the interpreter shuts down run from an ``atexit`` handler, and later
+ * ones are discarded.
+ */
+template <typename... Args> class async_callback<void(Args...)> {
+public:
+    async_callback() = default;
+    explicit async_callback(handle h)
+        : m_handle(std::make_shared<detail::async_handle>(h)) { }
+
+    explicit operator bool() const { return (bool) m_handle; }
+
+    /// Python callable, or an invalid handle if the callback is empty
+    handle func() const { return m_handle ? m_handle->f : handle(); }
+
+    /// Queue a call with copies of the given arguments (GIL not required)
+    void operator()(Args... args) const {
+        if (!m_handle)
+            detail::raise("nanobind::async_callback: empty callback!");
+        detail::async_push(
+            m_handle->queue,
+            new call(m_handle, (detail::forward_t<Args>) args...));
+    }
+
+private:
+    struct call : detail::async_call {
+        call(const std::shared_ptr<detail::async_handle> &h, Args... args)
+            : detail::async_call(run), h(h),
+              args((detail::forward_t<Args>) args...) { }
+
+        static void run(detail::async_call *c, bool execute) {
+            std::unique_ptr<call> self((call *) c);
+            if (execute)
+                std::apply([&](auto &... a) { self->h->f(a...); }, self->args);
+        }
+
+        std::shared_ptr<detail::async_handle> h;
+        std::tuple<std::decay_t<Args>...> args;
+    };
+
+    std::shared_ptr<detail::async_handle> m_handle;
+};
+
+/// Run the queued calls of the current interpreter's asynchronous callbacks
+/// (GIL must be held)
+inline size_t async_drain() { return detail::async_drain(); }
+
+NAMESPACE_BEGIN(detail)
+
+template <typename... Args>
+struct type_caster<async_callback<void(Args...)>> {
+    NB_TYPE_CASTER(async_callback<void(Args...)>,
+                   const_name("Callable[[") + concat(make_caster<Args>::Name...) +
+                       const_name("], None]"));
+
+    bool from_python(handle src, uint8_t flags, cleanup_list *) noexcept {
+        if (src.is_none())
+            return flags & cast_flags::convert;
+
+        if (!PyCallable_Check(src.ptr()))
+            return false;
+
+        value = Value(src);
+        return true;
+    }
+
+    static handle from_cpp(const Value &value, rv_policy,
+                           cleanup_list *) noexcept {
+        handle f = value.func();
+        if (!f.is_valid())
+            return none().release();
+        return f.inc_ref();
+    }
+};
+
+NAMESPACE_END(detail)
+NAMESPACE_END(NB_NAMESPACE)
@@ -0,0 +1,164 @@
+/*
+    nanobind/make_iterator.h: nb::make_[key_,chunked_]iterator(...)
+
+    Copyright (c) 2022 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <nanobind/nanobind.h>
+#include <nanobind/tensor.h>
+#include <vector>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+/// Iterator state (Kind: 0 = elements, 1 = keys, 2 = chunks of elements)
+template <int Kind, rv_policy Policy, typename Iterator, typename Sentinel,
+          typename... Ts>
+struct iterator_state {
+    Iterator it;
+    Sentinel end;
+    size_t chunk_size;
+};
+
+template <typename Iterator>
+using iterator_value_t = decltype(*std::declval<Iterator &>());
+
+/**
+ * Convert an element referenced by an iterator. The 'reference_internal'
+ * policy is handled here (and not by the binding layer) since chunks convert
+ * many elements within a single call: each bound element keeps the iterator
+ * state and thereby the underlying container alive.
+ */
+template <rv_policy Policy, typename T>
+object iterator_cast(T &&value, handle self) {
+    if constexpr (Policy == rv_policy::reference_internal) {
+        object result = cast((forward_t<T>) value, rv_policy::reference);
+        if constexpr (make_caster<T>::IsClass)
+            keep_alive(result.ptr(), self.ptr());
+        return result;
+    } else {
+        return cast((forward_t<T>) value, Policy);
+    }
+}
+
+template <rv_policy Policy, typename Iterator, typename Sentinel>
+object iterator_next(iterator_state<0, Policy, Iterator, Sentinel> &s,
+                     handle self) {
+    if (s.it == s.end)
+        throw stop_iteration();
+    object result = iterator_cast<Policy>(*s.it, self);
+    ++s.it;
+    return result;
+}
+
+template <rv_policy Policy, typename Iterator, typename Sentinel>
+object iterator_next(iterator_state<1, Policy, Iterator, Sentinel> &s,
+                     handle self) {
+    if (s.it == s.end)
+        throw stop_iteration();
+    object result = iterator_cast<Policy>((*s.it).first, self);
+    ++s.it;
+    return result;
+}
+
+template <rv_policy Policy, typename Iterator, typename Sentinel,
+          typename... Ts>
+object iterator_next(iterator_state<2, Policy, Iterator, Sentinel, Ts...> &s,
+                     handle self) {
+    using Value = std::decay_t<iterator_value_t<Iterator>>;
+
+    if (s.it == s.end)
+        throw stop_iteration();
+
+    if constexpr (std::is_arithmetic_v<Value> && !std::is_same_v<Value, bool>) {
+        // Copy the chunk into a vector that is then owned by the tensor
+        (void) self;
+        std::vector<Value> chunk;
+        chunk.reserve(s.chunk_size);
+        for (; chunk.size() < s.chunk_size && s.it != s.end; ++s.it)
+            chunk.push_back(*s.it);
+        return cast(tensor_from_vector<Ts...>(std::move(chunk)));
+    } else {
+        list chunk;
+        for (size_t i = 0; i < s.chunk_size && s.it != s.end; ++i, ++s.it)
+            chunk.append(iterator_cast<Policy>(*s.it, self));
+        PyObject *result = PyList_AsTuple(chunk.ptr());
+        if (!result)
+            raise_python_error();
+        return steal(result);
+    }
+}
+
+template <typename State>
+iterator iterator_new(handle scope, const char *name, State &&state) {
+    using Self = std::remove_reference_t<State>;
+
+    if (!type<Self>().is_valid()) {
+        class_<Self>(scope, name)
+            .def("__iter__", [](handle self) { return borrow(self); })
+            .def("__next__", [](handle self) -> object {
+                return iterator_next(cast<Self &>(self), self);
+            });
+    }
+
+    return borrow<iterator>(cast((State &&) state, rv_policy::move));
+}
+
+NAMESPACE_END(detail)
+
+/**
+ * \brief Create a Python iterator over the C++ range [first, last)
+ *
+ * The iterator state is exposed as a Python type named ``name`` that is
+ * created within ``scope`` upon first use. Elements are returned with the
+ * ``reference_internal`` policy by default, i.e. they reference the
+ * container; the binding creating the iterator should then specify
+ * ``nb::keep_alive<0, 1>()`` so that the container outlives the iterator.
+ */
+template <rv_policy Policy = rv_policy::reference_internal,
+          typename Iterator, typename Sentinel>
+iterator make_iterator(handle scope, const char *name, Iterator first,
+                       Sentinel last) {
+    using State = detail::iterator_state<0, Policy, Iterator, Sentinel>;
+    return detail::iterator_new(scope, name,
+                                State{ std::move(first), std::move(last), 1 });
+}
+
+/// Like make_iterator(), but yields the ``.first`` field of each element
+template <rv_policy Policy = rv_policy::reference_internal,
+          typename Iterator, typename Sentinel>
+iterator make_key_iterator(handle scope, const char *name, Iterator first,
+                           Sentinel last) {
+    using State = detail::iterator_state<1, Policy, Iterator, Sentinel>;
+    return detail::iterator_new(scope, name,
+                                State{ std::move(first), std::move(last), 1 });
+}
+
+/**
+ * \brief Create a Python iterator that yields the range [first, last) in
+ * chunks of up to ``chunk_size`` elements
+ *
+ * Chunks of arithmetic values are returned as 1D tensors holding a copy of the
+ * elements, where the optional template arguments annotate the tensor type
+ * (e.g., ``nb::make_chunked_iterator<nb::numpy>(...)``). Other elements are
+ * returned as tuples that are converted like in make_iterator().
+ */
+template <typename... Ts, typename Iterator, typename Sentinel>
+iterator make_chunked_iterator(handle scope, const char *name,
+                               Iterator first, Sentinel last,
+                               size_t chunk_size) {
+    using State = detail::iterator_state<2, rv_policy::reference_internal,
+                                         Iterator, Sentinel, Ts...>;
+    if (chunk_size == 0)
+        detail::raise("nanobind::make_chunked_iterator(): 'chunk_size' must "
+                      "be positive!");
+    return detail::iterator_new(
+        scope, name, State{ std::move(first), std::move(last), chunk_size });
+}
+
+NAMESPACE_END(NB_NAMESPACE)
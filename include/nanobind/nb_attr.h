@@ -47,13 +47,35 @@ template <typename... Ts> struct call_guard {
     using type = detail::tuple<Ts...>;
 };
 
+class gil_scoped_release;
+
+/// Release the GIL while the function body runs (after argument conversion)
+struct gil_released {};
+
+/**
+ * Defer the creation of a module-level function until the module attribute
+ * is first accessed (reduces the import time of large extensions)
+ */
+struct lazy {};
+
 struct dynamic_attr {};
 struct is_method {};
 struct is_implicit {};
 struct is_operator {};
 struct is_arithmetic {};
 struct is_final {};
+struct value_type {};
+
+/**
+ * Pickle instances of a trivially copyable type by serializing their raw
+ * bytes (supports out-of-band buffers of pickle protocol 5)
+ */
+struct trivial_pickle {};
 struct is_enum { bool is_signed; };
+struct pooled {
+    pooled(uint32_t capacity = 1024) : capacity(capacity) { }
+    uint32_t capacity;
+};
 
 template <size_t /* Nurse */, size_t /* Patient */> struct keep_alive {};
 template <typename T> struct supplement {};
@@ -106,7 +128,13 @@ enum class func_flags : uint32_t {
     /// Should the func_new() call return a new reference?
     return_ref = (1 << 15),
     /// Does this overload specify a raw docstring that should take precedence?
-    raw_doc = (1 << 16)
+    raw_doc = (1 << 16),
+    /// Is the GIL released while the function body runs?
+    release_gil = (1 << 17),
+    /// Does 'capture' store a pointer to a heap-allocated closure?
+    capture_indirect = (1 << 18),
+    /// Create the function object upon first access? (module functions only)
+    is_lazy = (1 << 19)
 };
 
 struct arg_data {
@@ -138,7 +166,13 @@ template <size_t Size> struct func_data_prelim {
     uint32_t flags;
 
     /// Total number of function call arguments
-    uint32_t nargs;
+    uint16_t nargs;
+
+    /// Estimated number of temporaries created by a call (see caster_cleanup_v)
+    uint16_t ncleanup;
+
+    /// Type of the captured function object (see nb_func_get_capture())
+    const std::type_info *capture_type;
 
     // ------- Extra fields -------
 
@@ -216,7 +250,20 @@ NB_INLINE void func_extra_apply(F &f, const arg_v &a, size_t &index) {
 }
 
 template <typename F, typename... Ts>
-NB_INLINE void func_extra_apply(F &, call_guard<Ts...>, size_t &) {}
+NB_INLINE void func_extra_apply(F &f, call_guard<Ts...>, size_t &) {
+    if constexpr ((std::is_same_v<Ts, gil_scoped_release> || ...))
+        f.flags |= (uint32_t) func_flags::release_gil;
+}
+
+template <typename F>
+NB_INLINE void func_extra_apply(F &f, gil_released, size_t &) {
+    f.flags |= (uint32_t) func_flags::release_gil;
+}
+
+template <typename F>
+NB_INLINE void func_extra_apply(F &f, lazy, size_t &) {
+    f.flags |= (uint32_t) func_flags::is_lazy;
+}
 
 template <typename F, size_t Nurse, size_t Patient>
 NB_INLINE void func_extra_apply(F &, nanobind::keep_alive<Nurse, Patient>,
@@ -235,6 +282,24 @@ struct extract_guard<call_guard<Cs...>, Ts...> {
     using type = call_guard<Cs...>;
 };
 
+template <typename... Ts> struct extract_guard<gil_released, Ts...> {
+    static_assert(std::is_same_v<typename extract_guard<Ts...>::type, void>,
+                  "gil_released cannot be combined with call_guard<>; specify "
+                  "call_guard<..., gil_scoped_release> instead!");
+    using type = call_guard<gil_scoped_release>;
+};
+
+/// Does the call guard 'T' release the GIL?
+template <typename T> constexpr bool guard_releases_gil_v = false;
+template <typename... Cs>
+constexpr bool guard_releases_gil_v<call_guard<Cs...>> =
+    (std::is_same_v<Cs, gil_scoped_release> || ...);
+
+/// Parameters of this type would change reference counts without the GIL
+template <typename T>
+constexpr bool is_object_by_value_v =
+    !std::is_reference_v<T> && std::is_base_of_v<object, std::decay_t<T>>;
+
 template <typename T>
 NB_INLINE void process_keep_alive(PyObject **, PyObject *, T *) {}
 
@@ -135,4 +135,74 @@ object api<Derived>::operator()(Args &&...args_) const {
 #undef NB_DO_VECTORCALL
 
 NAMESPACE_END(detail)
+
+/**
+ * \brief Python callable with a pre-resolved target for repeated calls
+ *
+ * In contrast to ``obj.attr("f")(...)``, which looks up the attribute upon
+ * every call, ``bound_call(obj, "f")`` does so once. Bound methods (of Python
+ * classes and bound C++ types) are split into their function and ``self``,
+ * which is then passed as the first positional argument. Calls convert the
+ * positional arguments directly into a stack array that leaves room for
+ * ``PY_VECTORCALL_ARGUMENTS_OFFSET``, so no tuple or bound method object is
+ * created along the way. Changes to the attribute after construction are
+ * not picked up.
+ */
+class bound_call {
+public:
+    bound_call() = default;
+
+    /// Call the given Python callable
+    explicit bound_call(handle func) : m_func(borrow(func)) { }
+
+    /// Call the method/attribute 'name' of 'self'
+    bound_call(handle self, const char *name) {
+        PyObject *self_out;
+        m_func = steal(detail::bound_call_resolve(self.ptr(), name, &self_out));
+        m_self = steal(self_out);
+    }
+
+    explicit operator bool() const { return m_func.is_valid(); }
+
+    /// The function that is called
+    handle func() const { return m_func; }
+
+    /// Instance passed as the first argument (an invalid handle if there is none)
+    handle self() const { return m_self; }
+
+    template <rv_policy policy = rv_policy::automatic_reference,
+              typename... Args>
+    object operator()(Args &&...args_) const {
+        static_assert(
+            !((std::is_same_v<std::decay_t<Args>, arg_v> ||
+               std::is_same_v<std::decay_t<Args>, detail::args_proxy> ||
+               std::is_same_v<std::decay_t<Args>, detail::kwargs_proxy>) || ...),
+            "nanobind::bound_call only supports positional arguments!");
+
+        if (!m_func.is_valid())
+            detail::raise("nanobind::bound_call: no function specified!");
+
+        // Slot 0 is scratch space for the callee (PY_VECTORCALL_ARGUMENTS_OFFSET)
+        PyObject *args[sizeof...(Args) + 2];
+        size_t nargs = 0;
+
+        if (m_self.is_valid())
+            args[1 + nargs++] = m_self.inc_ref().ptr();
+
+        ((args[1 + nargs++] =
+              detail::make_caster<Args>::from_cpp(
+                  (detail::forward_t<Args>) args_, policy, nullptr)
+                  .ptr()),
+         ...);
+
+        return steal(detail::obj_vectorcall(
+            m_func.inc_ref().ptr(), args + 1,
+            nargs | NB_VECTORCALL_ARGUMENTS_OFFSET, nullptr, false));
+    }
+
+private:
+    object m_func;
+    object m_self;
+};
+
 NAMESPACE_END(NB_NAMESPACE)
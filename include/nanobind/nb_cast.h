@@ -52,6 +52,43 @@ using movable_cast_t =
                        std::conditional_t<std::is_rvalue_reference_v<T>,
                                           intrinsic_t<T> &&, intrinsic_t<T> &>>;
 
+/**
+ * Type casters may optionally provide a 'can_cast<T>()' member, which is
+ * queried after a successful call to 'from_python()'. Returning 'false'
+ * rejects the current overload without having to throw 'next_overload' from
+ * within the cast operator (e.g. when 'None' cannot bind to a reference).
+ */
+template <typename Caster, typename T, typename = void>
+struct has_can_cast : std::false_type { };
+
+template <typename Caster, typename T>
+struct has_can_cast<
+    Caster, T,
+    std::void_t<decltype(std::declval<const Caster &>().template can_cast<T>())>>
+    : std::true_type { };
+
+template <typename T, typename Caster>
+NB_INLINE bool can_cast(const Caster &caster) noexcept {
+    if constexpr (has_can_cast<Caster, T>::value)
+        return caster.template can_cast<T>();
+    else
+        return true;
+}
+
+/**
+ * \brief Estimated number of temporaries that 'Caster::from_python()' appends
+ * to the cleanup list, as declared via a 'Cleanup' member (0 if absent).
+ *
+ * Function dispatch uses this value to size the cleanup list on the stack.
+ * Exceeding it is harmless and merely falls back to a heap allocation.
+ */
+template <typename Caster, typename = int>
+constexpr uint32_t caster_cleanup_v = 0;
+
+template <typename Caster>
+constexpr uint32_t caster_cleanup_v<Caster, enable_if_t<(Caster::Cleanup > 0)>> =
+    Caster::Cleanup;
+
 template <typename T>
 struct type_caster<T, enable_if_t<std::is_arithmetic_v<T> && !is_std_char_v<T>>> {
 public:
@@ -167,13 +204,17 @@ template <> struct type_caster<char> {
 
     static handle from_cpp(const char *value, rv_policy,
                            cleanup_list *) noexcept {
-        return PyUnicode_FromString(value);
+        return str_from_utf8(value, strlen(value));
     }
 
     static handle from_cpp(char value, rv_policy, cleanup_list *) noexcept {
         return PyUnicode_FromStringAndSize(&value, 1);
     }
 
+    template <typename T_> bool can_cast() const noexcept {
+        return is_pointer_v<T_> || (value && value[0] && value[1] == '\0');
+    }
+
     explicit operator const char *() { return value; }
 
     explicit operator char() {
@@ -226,10 +267,26 @@ template <typename T> NB_INLINE rv_policy infer_policy(rv_policy policy) {
     return policy;
 }
 
+/**
+ * Return value policy for the elements of a container that is passed to
+ * from_cpp() as 'T&&'. The elements of an rvalue container are about to be
+ * destroyed, hence they are always moved instead of being copied or referenced.
+ */
+template <typename T, typename Entry>
+NB_INLINE rv_policy element_policy(rv_policy policy) {
+    if constexpr (!std::is_lvalue_reference_v<T> && !is_pointer_v<Entry> &&
+                  !std::is_reference_v<Entry> && !std::is_const_v<Entry>) {
+        if (policy != rv_policy::none)
+            policy = rv_policy::move;
+    }
+    return policy;
+}
+
 template <typename Type_> struct type_caster_base {
     using Type = Type_;
     static constexpr auto Name = const_name<Type>();
     static constexpr bool IsClass = true;
+    static constexpr uint32_t Cleanup = 1; // implicit conversion
 
     template <typename T> using Cast = movable_cast_t<T>;
 
@@ -252,6 +309,10 @@ template <typename Type_> struct type_caster_base {
                            cleanup, nullptr);
     }
 
+    template <typename T> bool can_cast() const noexcept {
+        return is_pointer_v<T> || value != nullptr;
+    }
+
     operator Type*() { return value; }
 
     operator Type&() {
@@ -271,7 +332,10 @@ private:
 };
 
 template <typename Type, typename SFINAE>
-struct type_caster : type_caster_base<Type> { };
+struct type_caster : type_caster_base<Type> {
+    /// Not a custom caster, hence containers may convert elements in bulk
+    static constexpr bool IsPlainClass = true;
+};
 
 NAMESPACE_END(detail)
 
@@ -69,7 +69,16 @@ enum class type_flags : uint32_t {
     has_dynamic_attr         = (1 << 19),
 
     /// The class uses an intrusive reference counting approach
-    intrusive_ptr            = (1 << 20)
+    intrusive_ptr            = (1 << 20),
+
+    /// Instances with internal storage are recycled via a per-type freelist
+    is_pooled                = (1 << 21),
+
+    /// Instances with internal storage are not registered in inst_c2p
+    is_value_type            = (1 << 22),
+
+    /// Instances are pickled as raw bytes, see nb::trivial_pickle
+    has_trivial_pickle       = (1 << 23)
 };
 
 struct type_data {
@@ -88,9 +97,16 @@ struct type_data {
     void (*move)(void *, void *) noexcept;
     const std::type_info **implicit;
     bool (**implicit_py)(PyTypeObject *, PyObject *, cleanup_list *) noexcept;
+    bool (**implicit_cast)(void *, PyObject *, cleanup_list *);
+    bool (**implicit_py_cast)(void *, PyObject *, cleanup_list *);
     void (*type_callback)(PyType_Slot **) noexcept;
     void *supplement;
     void (*set_self_py)(void *, PyObject *);
+    void *pool;
+    uint32_t pool_size;
+    uint32_t pool_capacity;
+    void *trampoline_cache;
+    PyObject *init;
 #if defined(Py_LIMITED_API)
     size_t dictoffset;
 #endif
@@ -128,6 +144,19 @@ NB_INLINE void type_extra_apply(type_data &t, is_final) {
     t.flags |= (uint32_t) type_flags::is_final;
 }
 
+NB_INLINE void type_extra_apply(type_data &t, value_type) {
+    t.flags |= (uint32_t) type_flags::is_value_type;
+}
+
+NB_INLINE void type_extra_apply(type_data &t, trivial_pickle) {
+    t.flags |= (uint32_t) type_flags::has_trivial_pickle;
+}
+
+NB_INLINE void type_extra_apply(type_data &t, pooled p) {
+    t.flags |= (uint32_t) type_flags::is_pooled;
+    t.pool_capacity = p.capacity;
+}
+
 NB_INLINE void type_extra_apply(type_data &t, is_arithmetic) {
     t.flags |= (uint32_t) type_flags::is_arithmetic;
 }
@@ -182,6 +211,16 @@ template <typename Arg> struct init_implicit {
                 new ((Alias *) v) Alias{ (forward_t<Arg>) arg };
             }, is_implicit(), extra...);
 
+        // Direct conversion that bypasses the dispatch of '__init__'
+        auto cast = [](void *v, PyObject *src, cleanup_list *cleanup) -> bool {
+            Caster caster;
+            if (!caster.from_python(src, (uint8_t) cast_flags::convert, cleanup) ||
+                !can_cast<Arg>(caster))
+                return false;
+            new ((Alias *) v) Alias{ ((Caster &&) caster).operator cast_t<Arg>() };
+            return true;
+        };
+
         if constexpr (!Caster::IsClass) {
             implicitly_convertible(
                 [](PyTypeObject *, PyObject *src,
@@ -189,7 +228,10 @@ template <typename Arg> struct init_implicit {
                     return Caster().from_python(src, cast_flags::convert,
                                                 cleanup);
                 },
-                &typeid(Type));
+                &typeid(Type), cast);
+        } else {
+            implicitly_convertible(&typeid(intrinsic_t<Arg>), &typeid(Type),
+                                   cast);
         }
     }
 };
@@ -206,6 +248,63 @@ template <typename T> void wrap_destruct(void *value) noexcept {
     ((T *) value)->~T();
 }
 
+template <typename T> void wrap_assign(void *dst, const void *src) {
+    *(T *) dst = *(const T *) src;
+}
+
+/**
+ * \brief Can the data member ``D C::*`` of a bound type ``T`` be accessed via
+ * a getset descriptor (see field_install()) instead of a property?
+ *
+ * This requires a member at a fixed offset (i.e., not within a virtual base),
+ * of arithmetic or bound type, and annotations that are docstrings.
+ */
+template <typename T, typename C, typename D, bool Writable, typename... Extra>
+constexpr bool is_direct_field_v =
+    (std::is_same_v<C, T> || std::is_standard_layout_v<T>) &&
+    (std::is_convertible_v<const Extra &, const char *> && ...) &&
+    (!Writable || !std::is_const_v<D>) &&
+    ((std::is_arithmetic_v<std::remove_cv_t<D>> &&
+      !is_std_char_v<std::remove_cv_t<D>> && sizeof(D) <= 8) ||
+     (std::is_base_of_v<type_caster_base<std::remove_cv_t<D>>,
+                        make_caster<std::remove_cv_t<D>>> &&
+      (!Writable || std::is_copy_assignable_v<D>)));
+
+NB_INLINE const char *field_doc() { return nullptr; }
+template <typename... Extra>
+NB_INLINE const char *field_doc(const char *doc, const Extra &...) { return doc; }
+
+template <typename T, typename C, typename D, typename... Extra>
+NB_INLINE void field_def(handle scope, const char *name, D C::*pm,
+                         bool readonly, const Extra &...extra) {
+    using Value = std::remove_cv_t<D>;
+
+    alignas(T) unsigned char storage[sizeof(T)];
+    const T *instance = (const T *) storage;
+
+    field_data f { };
+    f.name = name;
+    f.doc = field_doc(extra...);
+    f.offset = (size_t) ((const unsigned char *) &(instance->*pm) - storage);
+    f.size = (uint8_t) sizeof(Value);
+    f.readonly = readonly;
+
+    if constexpr (std::is_same_v<Value, bool>) {
+        f.kind = field_kind::bool_;
+    } else if constexpr (std::is_floating_point_v<Value>) {
+        f.kind = field_kind::float_;
+    } else if constexpr (std::is_integral_v<Value>) {
+        f.kind = std::is_signed_v<Value> ? field_kind::int_ : field_kind::uint_;
+    } else {
+        f.kind = field_kind::bound_type;
+        f.type = &typeid(Value);
+        if constexpr (std::is_copy_assignable_v<D>)
+            f.assign = wrap_assign<Value>;
+    }
+
+    field_install(scope.ptr(), &f);
+}
+
 template <typename, template <typename, typename> typename, typename...>
 struct extract;
 
@@ -250,6 +349,21 @@ public:
 
     template <typename... Extra>
     NB_INLINE class_(handle scope, const char *name, const Extra &... extra) {
+        static_assert(std::is_same_v<Alias, T> ||
+                          !(std::is_same_v<Extra, value_type> || ...),
+                      "nb::value_type cannot be combined with a trampoline "
+                      "class, whose instances must be found via their C++ "
+                      "pointer!");
+        static_assert(std::is_same_v<Alias, T> ||
+                          !(std::is_same_v<Extra, is_final> || ...),
+                      "nb::is_final cannot be combined with a trampoline "
+                      "class, which only serves to support subclassing!");
+        static_assert((std::is_same_v<Alias, T> &&
+                       std::is_trivially_copyable_v<T>) ||
+                          !(std::is_same_v<Extra, trivial_pickle> || ...),
+                      "nb::trivial_pickle requires a trivially copyable type "
+                      "without a trampoline class!");
+
         detail::type_data d;
 
         d.flags = (uint32_t) detail::type_flags::has_scope;
@@ -385,10 +499,14 @@ public:
         static_assert(std::is_base_of_v<C, T>,
                       "def_readwrite() requires a (base) class member!");
 
-        def_property(name,
-            [pm](const T &c) -> const D & { return c.*pm; },
-            [pm](T &c, const D &value) { c.*pm = value; },
-            extra...);
+        if constexpr (detail::is_direct_field_v<T, C, D, true, Extra...>) {
+            detail::field_def<T>(*this, name, pm, false, extra...);
+        } else {
+            def_property(name,
+                [pm](const T &c) -> const D & { return c.*pm; },
+                [pm](T &c, const D &value) { c.*pm = value; },
+                extra...);
+        }
 
         return *this;
     }
@@ -409,8 +527,12 @@ public:
         static_assert(std::is_base_of_v<C, T>,
                       "def_readonly() requires a (base) class member!");
 
-        def_property_readonly(name,
-            [pm](const T &c) -> const D & { return c.*pm; }, extra...);
+        if constexpr (detail::is_direct_field_v<T, C, D, false, Extra...>) {
+            detail::field_def<T>(*this, name, pm, true, extra...);
+        } else {
+            def_property_readonly(name,
+                [pm](const T &c) -> const D & { return c.*pm; }, extra...);
+        }
 
         return *this;
     }
@@ -467,6 +589,7 @@ inline size_t type_align(handle h) { return detail::nb_type_align(h.ptr()); }
 inline const std::type_info& type_info(handle h) { return *detail::nb_type_info(h.ptr()); }
 template <typename T>
 inline T &type_supplement(handle h) { return *(T *) detail::nb_type_supplement(h.ptr()); }
+inline size_t type_pool_trim(handle h, size_t keep = 0) { return detail::nb_type_pool_trim(h.ptr(), keep); }
 
 // Low level access to nanobind instance objects
 inline bool inst_check(handle h) { return type_check(h.type()); }
@@ -479,6 +602,12 @@ inline bool inst_ready(handle h) { return inst_state(h).first; }
 inline void inst_destruct(handle h) { detail::nb_inst_destruct(h.ptr()); }
 inline void inst_copy(handle dst, handle src) { detail::nb_inst_copy(dst.ptr(), src.ptr()); }
 inline void inst_move(handle dst, handle src) { detail::nb_inst_move(dst.ptr(), src.ptr()); }
+inline void inst_make_immortal(handle h) { detail::nb_inst_make_immortal(h.ptr()); }
+inline bool inst_immortal(handle h) { return detail::nb_inst_immortal(h.ptr()); }
 template <typename T> T *inst_ptr(handle h) { return (T *) detail::nb_inst_ptr(h.ptr()); }
 
+// Python reference counting hooks for types with intrusive reference counting
+inline void intrusive_inc_ref_py(PyObject *o) noexcept { detail::intrusive_inc_ref_py(o); }
+inline void intrusive_dec_ref_py(PyObject *o) noexcept { detail::intrusive_dec_ref_py(o); }
+
 NAMESPACE_END(NB_NAMESPACE)
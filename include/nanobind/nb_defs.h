@@ -106,19 +106,27 @@
 #define NB_MODULE(name, variable)                                              \
     extern "C" [[maybe_unused]] NB_EXPORT PyObject *PyInit_##name();           \
     static PyModuleDef NB_CONCAT(nanobind_module_def_, name);                  \
+    static PyModuleDef_Slot NB_CONCAT(nanobind_module_slots_, name)[3];        \
     [[maybe_unused]] static void NB_CONCAT(nanobind_init_,                     \
                                            name)(::nanobind::module_ &);       \
-    extern "C" NB_EXPORT PyObject *PyInit_##name() {                           \
-        nanobind::module_ m =                                                  \
-            nanobind::borrow<nanobind::module_>(nanobind::detail::module_new(  \
-                NB_TOSTRING(name), &NB_CONCAT(nanobind_module_def_, name)));   \
+    static int NB_CONCAT(nanobind_exec_, name)(PyObject *m) {                  \
+        if (nanobind::detail::module_reuse(                                    \
+                m, &NB_CONCAT(nanobind_module_def_, name)))                    \
+            return 0;                                                          \
+        nanobind::module_ mod = nanobind::borrow<nanobind::module_>(m);        \
         try {                                                                  \
-            NB_CONCAT(nanobind_init_, name)(m);                                \
-            return m.ptr();                                                    \
+            NB_CONCAT(nanobind_init_, name)(mod);                              \
+            return 0;                                                          \
         } catch (const std::exception &e) {                                    \
             PyErr_SetString(PyExc_ImportError, e.what());                      \
-            return nullptr;                                                    \
+            return -1;                                                         \
         }                                                                      \
     }                                                                          \
+    extern "C" NB_EXPORT PyObject *PyInit_##name() {                           \
+        return nanobind::detail::module_new(                                   \
+            NB_TOSTRING(name), &NB_CONCAT(nanobind_module_def_, name),         \
+            NB_CONCAT(nanobind_module_slots_, name),                           \
+            NB_CONCAT(nanobind_exec_, name));                                  \
+    }                                                                          \
     void NB_CONCAT(nanobind_init_, name)(::nanobind::module_ & (variable))
 
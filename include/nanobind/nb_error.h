@@ -73,7 +73,22 @@ NB_EXCEPTION(attribute_error)
 
 inline void register_exception_translator(detail::exception_translator t,
                                           void *payload = nullptr) {
-    detail::register_exception_translator(t, payload);
+    detail::register_exception_translator(t, payload, nullptr);
+}
+
+/**
+ * \brief Register a translator for exceptions of type ``T``
+ *
+ * Such translators are found via a type-keyed lookup when the dynamic type of
+ * an exception is exactly ``T``, which avoids trying all other translators in
+ * turn. This shortcut is only taken while no translator without a type has
+ * been registered after it, so that translators are still tried in the
+ * reverse order of their registration as far as the outcome is concerned.
+ */
+template <typename T>
+void register_exception_translator(detail::exception_translator t,
+                                   void *payload = nullptr) {
+    detail::register_exception_translator(t, payload, &typeid(T));
 }
 
 template <typename T>
@@ -90,7 +105,7 @@ class exception : public object {
                 } catch (T &e) {
                     PyErr_SetString((PyObject *) payload, e.what());
                 }
-            }, m_ptr);
+            }, m_ptr, &typeid(T));
     }
 };
 
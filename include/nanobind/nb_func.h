@@ -18,11 +18,20 @@ NB_INLINE PyObject *func_create(Func &&func, Return (*)(Args...),
     using Guard = typename extract_guard<Extra...>::type;
 
     if constexpr (CheckGuard && !std::is_same_v<Guard, void>) {
+        /* The arguments are constructed (and later destroyed) while the GIL
+           is held. Python objects taken by value would instead be created and
+           released by 'func' itself, hence they are not permitted here. */
+        static_assert(!guard_releases_gil_v<Guard> ||
+                          !(is_object_by_value_v<Args> || ...),
+                      "Functions that release the GIL must take Python objects "
+                      "by reference (e.g. 'const nb::object &') or as "
+                      "'nb::handle'!");
+
         return func_create<ReturnRef, false>(
             [func = (forward_t<Func>) func](Args... args) NB_INLINE_LAMBDA {
                 typename Guard::type g;
                 (void) g;
-                return func(args...);
+                return func((forward_t<Args>) args...);
             },
             (Return(*)(Args...)) nullptr, is, extra...);
     }
@@ -90,12 +99,15 @@ NB_INLINE PyObject *func_create(Func &&func, Return (*)(Args...),
         void **cap = (void **) f.capture;
         cap[0] = new capture{ (forward_t<Func>) func };
 
-        f.flags |= (uint32_t) func_flags::has_free;
+        f.flags |= (uint32_t) func_flags::has_free |
+                   (uint32_t) func_flags::capture_indirect;
         f.free = [](void *p) {
             delete (capture *) ((void **) p)[0];
         };
     }
 
+    f.capture_type = &typeid(std::remove_cv_t<std::remove_reference_t<Func>>);
+
     f.impl = [](void *p, PyObject **args, uint8_t *args_flags, rv_policy policy,
                 cleanup_list *cleanup) -> PyObject * {
         (void)p; (void)args; (void)args_flags; (void)policy; (void)cleanup;
@@ -113,6 +125,9 @@ NB_INLINE PyObject *func_create(Func &&func, Return (*)(Args...),
                                                 cleanup) || ...))
             return NB_NEXT_OVERLOAD;
 
+        if ((!can_cast<Args>(in.template get<Is>()) || ...))
+            return NB_NEXT_OVERLOAD;
+
         PyObject *result;
         if constexpr (std::is_void_v<Return>) {
             cap->func(((make_caster<Args>&&) in.template get<Is>()).operator cast_t<Args>()...);
@@ -134,6 +149,11 @@ NB_INLINE PyObject *func_create(Func &&func, Return (*)(Args...),
     f.descr_types = descr_types;
     f.nargs = (uint16_t) nargs;
 
+    // Temporaries due to implicit conversions, *args, and **kwargs
+    constexpr size_t ncleanup = (caster_cleanup_v<make_caster<Args>> + ... + 0) +
+                                (args_pos_1 < nargs) + (kwargs_pos_1 < nargs);
+    f.ncleanup = (uint16_t) (ncleanup < 0xFFFF ? ncleanup : 0xFFFF);
+
     // Fill remaining fields of 'f'
     size_t arg_index = 0;
     (void) arg_index;
@@ -17,6 +17,7 @@ NAMESPACE_BEGIN(detail)
 // Forward declarations for types in dlpack.h (2)
 struct tensor_handle;
 struct tensor_req;
+struct record_field;
 
 /**
  * Helper class to clean temporaries created by function dispatch.
@@ -27,11 +28,15 @@ struct NB_CORE cleanup_list {
 public:
     static constexpr uint32_t Small = 6;
 
-    cleanup_list(PyObject *self) :
+    cleanup_list(PyObject *self) : cleanup_list(self, m_local, Small) { }
+
+    /// Use caller-provided storage for the first 'capacity' entries
+    cleanup_list(PyObject *self, PyObject **storage, uint32_t capacity) :
         m_size{1},
-        m_capacity{Small},
-        m_data{m_local} {
-        m_local[0] = self;
+        m_capacity{capacity},
+        m_data{storage},
+        m_storage{storage} {
+        storage[0] = self;
     }
 
     ~cleanup_list() = default;
@@ -44,9 +49,12 @@ public:
     }
 
     NB_INLINE PyObject *self() const {
-        return m_local[0];
+        return m_data[0];
     }
 
+    /// Were any objects appended? (otherwise, 'release()' can be skipped)
+    NB_INLINE bool used() const { return m_size != 1; }
+
     /// Decrease the reference count of all appended objects
     void release() noexcept;
 
@@ -58,6 +66,7 @@ protected:
     uint32_t m_size;
     uint32_t m_capacity;
     PyObject **m_data;
+    PyObject **m_storage;
     PyObject *m_local[Small];
 };
 
@@ -97,6 +106,28 @@ NB_CORE PyObject *str_from_cstr(const char *c);
 /// Convert an UTF8 C string + size into a Python unicode string
 NB_CORE PyObject *str_from_cstr_and_size(const char *c, size_t n);
 
+/// Like the above, but doesn't raise (and creates ASCII strings more quickly)
+NB_CORE PyObject *str_from_utf8(const char *c, size_t n) noexcept;
+
+/**
+ * \brief Like str_from_cstr_and_size(), but return a shared instance for
+ * recently converted short strings (from a bounded cache). Does not raise.
+ */
+NB_CORE PyObject *str_intern(const char *c, size_t n) noexcept;
+
+/// Return a new index identifying a call site of NB_INTERN()
+NB_CORE size_t str_intern_site() noexcept;
+
+/**
+ * \brief Return the interned Python string of the NB_INTERN() call site 'site'
+ * within the current interpreter (borrowed, with a precomputed hash). Raises
+ * an exception in case of errors.
+ */
+NB_CORE PyObject *str_intern_permanent(size_t site, const char *c);
+
+/// Create an empty dictionary with space for 'size' items
+NB_CORE PyObject *dict_new_presized(size_t size) noexcept;
+
 // ========================================================================
 
 /// Convert a Python object into a Python byte string
@@ -161,6 +192,16 @@ NB_CORE PyObject *obj_vectorcall(PyObject *base, PyObject *const *args,
                                  size_t nargsf, PyObject *kwnames,
                                  bool method_call);
 
+/**
+ * \brief Look up the attribute 'name' of 'self' for repeated calls
+ *
+ * Bound methods are split into their function (the return value) and the
+ * instance, which is stored in 'self_out' (otherwise set to 'nullptr').
+ * Raises an exception in case of errors.
+ */
+NB_CORE PyObject *bound_call_resolve(PyObject *self, const char *name,
+                                     PyObject **self_out);
+
 /// Create an iterator from 'o', raise an exception in case of errors
 NB_CORE PyObject *obj_iter(PyObject *o);
 
@@ -189,13 +230,29 @@ NB_CORE void call_append_kwargs(PyObject *kwargs, PyObject *value);
 // ========================================================================
 
 // If the given sequence has the size 'size', return a pointer to its contents.
-// May produce a temporary.
+// May produce a temporary. Py_LIMITED_API builds copy borrowed references
+// into 'storage', which must provide space for 'size' entries.
 NB_CORE PyObject **seq_get_with_size(PyObject *seq, size_t size,
-                                     PyObject **temp) noexcept;
+                                     PyObject **temp,
+                                     PyObject **storage) noexcept;
 
-// Like the above, but return the size instead of checking it.
-NB_CORE PyObject **seq_get(PyObject *seq, size_t *size,
-                           PyObject **temp) noexcept;
+// Like the above, but return the size instead of checking it. Py_LIMITED_API
+// builds use 'storage' for sequences with up to 'capacity' entries.
+NB_CORE PyObject **seq_get(PyObject *seq, size_t *size, PyObject **temp,
+                           PyObject **storage, size_t capacity) noexcept;
+
+/**
+ * \brief Convert a sequence of numbers into a contiguous array in one pass
+ *
+ * ``code`` and ``size`` specify the element type following the DLPack
+ * conventions (0: signed integer, 1: unsigned integer, 2: floating point)
+ * and its size in bytes. Once the number of elements is known, the function
+ * calls ``resize(payload, count)`` to obtain the output storage. Buffer
+ * protocol and DLPack inputs are copied in bulk.
+ */
+NB_CORE bool seq_load_arith(PyObject *seq, uint8_t flags, uint8_t code,
+                            size_t size, void *(*resize)(void *, size_t),
+                            void *payload) noexcept;
 
 // ========================================================================
 
@@ -208,6 +265,12 @@ NB_CORE PyObject *capsule_new(const void *ptr, const char *name,
 /// Create a Python function object for the given function record
 NB_CORE PyObject *nb_func_new(const void *data) noexcept;
 
+/**
+ * \brief Return the function object captured by a nanobind function with a
+ * single overload, if its type matches 't'. Returns NULL otherwise.
+ */
+NB_CORE void *nb_func_get_capture(PyObject *o, const std::type_info *t) noexcept;
+
 // ========================================================================
 
 /// Create a Python type object for the given type record
@@ -223,6 +286,17 @@ NB_CORE PyObject *nb_type_put(const std::type_info *cpp_type, void *value,
                               rv_policy rvp, cleanup_list *cleanup,
                               bool *is_new) noexcept;
 
+/**
+ * \brief Cast 'count' C++ instances spaced 'stride' bytes apart into a new
+ * Python list
+ *
+ * This batch version of 'nb_type_put' looks up the type once and reserves
+ * space in the instance table for the new elements.
+ */
+NB_CORE PyObject *nb_type_put_n(const std::type_info *cpp_type, void *values,
+                                size_t stride, size_t count, rv_policy rvp,
+                                cleanup_list *cleanup) noexcept;
+
 // Special version of 'nb_type_put' for unique pointers and ownership transfer
 NB_CORE PyObject *nb_type_put_unique(const std::type_info *cpp_type,
                                      void *value, cleanup_list *cleanup,
@@ -234,6 +308,9 @@ NB_CORE void nb_type_relinquish_ownership(PyObject *o, bool cpp_delete);
 /// Get a pointer to a user-defined 'extra' value associated with the nb_type t.
 NB_CORE void *nb_type_supplement(PyObject *t) noexcept;
 
+/// Release pooled instance blocks of the nb_type t, keeping at most 'keep'
+NB_CORE size_t nb_type_pool_trim(PyObject *t, size_t keep) noexcept;
+
 /// Check if the given python object represents a nanobind type
 NB_CORE bool nb_type_check(PyObject *t) noexcept;
 
@@ -285,12 +362,53 @@ NB_CORE void nb_inst_set_state(PyObject *o, bool ready, bool destruct) noexcept;
 /// Query the 'ready' and 'destruct' flags of an instance
 NB_CORE std::pair<bool, bool> nb_inst_state(PyObject *o) noexcept;
 
+/**
+ * Keep an instance alive until the interpreter shuts down. Returning the
+ * associated C++ object then always produces this instance, and the hooks
+ * below skip its reference count.
+ */
+NB_CORE void nb_inst_make_immortal(PyObject *o) noexcept;
+
+/// Was the instance marked via nb_inst_make_immortal()?
+NB_CORE bool nb_inst_immortal(PyObject *o) noexcept;
+
+/**
+ * Reference counting hooks for instances of types with intrusive reference
+ * counting (see ``docs/intrusive.md``). They only acquire the GIL when the
+ * calling thread doesn't already hold it, and do nothing for immortal
+ * instances.
+ */
+NB_CORE void intrusive_inc_ref_py(PyObject *o) noexcept;
+NB_CORE void intrusive_dec_ref_py(PyObject *o) noexcept;
+
 // ========================================================================
 
 // Create and install a Python property object
 NB_CORE void property_install(PyObject *scope, const char *name, bool is_static,
                               PyObject *getter, PyObject *setter) noexcept;
 
+/// Kinds of data members that can be accessed without function dispatch
+enum class field_kind : uint8_t { bool_, int_, uint_, float_, bound_type };
+
+/// Description of a data member, see field_install()
+struct field_data {
+    const char *name;
+    const char *doc;
+    /// Bound type of the member ('kind == bound_type')
+    const std::type_info *type;
+    /// Copy-assignment of a bound type
+    void (*assign)(void *, const void *);
+    /// Byte offset of the member within the instance
+    size_t offset;
+    field_kind kind;
+    /// Size of arithmetic members in bytes
+    uint8_t size;
+    bool readonly;
+};
+
+// Create and install a getset descriptor that directly accesses a data member
+NB_CORE void field_install(PyObject *scope, const field_data *f) noexcept;
+
 // ========================================================================
 
 NB_CORE PyObject *get_override(void *ptr, const std::type_info *type,
@@ -305,17 +423,38 @@ NB_CORE void keep_alive(PyObject *nurse, PyObject *patient) noexcept;
 NB_CORE void keep_alive(PyObject *nurse, void *payload,
                         void (*deleter)(void *) noexcept) noexcept;
 
+/// Return a payload registered via keep_alive() with the given deleter, or NULL
+NB_CORE void *keep_alive_find(PyObject *nurse,
+                              void (*deleter)(void *) noexcept) noexcept;
+
+/// Deleters of 'std::shared_ptr<void>' and 'std::weak_ptr<void>' payloads
+/// (shared by all extensions, so that keep_alive_find() can identify them)
+NB_CORE void shared_ptr_delete(void *p) noexcept;
+NB_CORE void weak_ptr_delete(void *p) noexcept;
+
 // ========================================================================
 
-/// Indicate to nanobind that an implicit constructor can convert 'src' -> 'dst'
+/**
+ * \brief Indicate to nanobind that an implicit constructor can convert 'src'
+ * -> 'dst'
+ *
+ * The optional 'cast' function constructs 'dst' in place from a Python object
+ * (returning 'false' if it cannot be converted), which spares the dispatch of
+ * the Python-level constructor. Repeated registrations of the same 'src' type
+ * only update 'cast'.
+ */
 NB_CORE void implicitly_convertible(const std::type_info *src,
-                                    const std::type_info *dst) noexcept;
+                                    const std::type_info *dst,
+                                    bool (*cast)(void *, PyObject *,
+                                                 cleanup_list *) = nullptr) noexcept;
 
 /// Register a callback to check if implicit conversion to 'dst' is possible
 NB_CORE void implicitly_convertible(bool (*predicate)(PyTypeObject *,
                                                       PyObject *,
                                                       cleanup_list *),
-                                    const std::type_info *dst) noexcept;
+                                    const std::type_info *dst,
+                                    bool (*cast)(void *, PyObject *,
+                                                 cleanup_list *) = nullptr) noexcept;
 
 // ========================================================================
 
@@ -331,8 +470,21 @@ NB_CORE void nb_enum_export(PyObject *type);
 /// Try to import a Python extension module, raises an exception upon failure
 NB_CORE PyObject *module_import(const char *name);
 
-/// Create a new extension module with the given name
-NB_CORE PyObject *module_new(const char *name, PyModuleDef *def) noexcept;
+/**
+ * \brief Prepare the definition of an extension module that is initialized
+ * by 'exec' (multi-phase initialization), which also declares it as safe to
+ * use from sub-interpreters. The 'slots' array must provide 3 entries.
+ */
+NB_CORE PyObject *module_new(const char *name, PyModuleDef *def,
+                             PyModuleDef_Slot *slots,
+                             int (*exec)(PyObject *)) noexcept;
+
+/**
+ * \brief Called before executing the body of a module. Returns 'true' if the
+ * module was already initialized within the current interpreter, in which
+ * case its contents were copied into 'm'.
+ */
+NB_CORE bool module_reuse(PyObject *m, PyModuleDef *def) noexcept;
 
 /// Create a submodule of an existing module
 NB_CORE PyObject *module_new_submodule(PyObject *base, const char *name,
@@ -352,6 +504,12 @@ NB_CORE tensor_handle *tensor_create(void *value, size_t ndim,
                                      dlpack::dtype *dtype, int32_t device,
                                      int32_t device_id);
 
+// Create a contiguous CPU tensor backed by aligned storage that it owns
+// ('order' is 'C' or 'F')
+NB_CORE tensor_handle *tensor_allocate(size_t ndim, const size_t *shape,
+                                       dlpack::dtype *dtype,
+                                       size_t alignment, char order);
+
 /// Increase the reference count of the given tensor object; returns a pointer
 /// to the underlying DLtensor
 NB_CORE dlpack::tensor *tensor_inc_ref(tensor_handle *) noexcept;
@@ -359,8 +517,111 @@ NB_CORE dlpack::tensor *tensor_inc_ref(tensor_handle *) noexcept;
 /// Decrease the reference count of the given tensor object
 NB_CORE void tensor_dec_ref(tensor_handle *) noexcept;
 
-/// Wrap a tensor_handle* into a PyCapsule
-NB_CORE PyObject *tensor_wrap(tensor_handle *, int framework) noexcept;
+/**
+ * Wrap a tensor_handle* into a PyCapsule (or a framework-specific object).
+ * Tensors of records registered via record_register() specify their type.
+ */
+NB_CORE PyObject *tensor_wrap(tensor_handle *, int framework, bool readonly,
+                              const std::type_info *record) noexcept;
+
+/**
+ * Create a read-only 'nb_tensor' of 'size' bytes at 'data' that keeps 'owner'
+ * alive and implements the buffer protocol. Does not raise.
+ */
+NB_CORE PyObject *tensor_bytes_buffer(void *data, size_t size,
+                                      PyObject *owner) noexcept;
+
+/// Register the field layout of a record type exported by tensors
+NB_CORE void record_register(const std::type_info *type, size_t size,
+                             const record_field *fields, size_t nfields);
+
+/**
+ * \brief Broadcast the shapes of ``n`` tensors following NumPy's rules
+ *
+ * Null entries of ``th`` denote scalars. On return, ``shape`` holds the
+ * broadcast shape and ``strides[i * vectorize_max_ndim + j]`` the byte stride
+ * of tensor ``i`` along output dimension ``j`` (zero when broadcast). The
+ * function returns the output dimension and raises an exception when the
+ * shapes are incompatible.
+ */
+NB_CORE size_t tensor_broadcast(size_t n, tensor_handle **th,
+                                const size_t *itemsize, size_t *shape,
+                                int64_t *strides);
+
+// ========================================================================
+
+/// Block until the C++ future 'payload' is ready (called without the GIL)
+using future_wait = void (*)(void *payload) noexcept;
+
+/// Convert the result of a ready future into a Python object (may throw)
+using future_result = PyObject *(*)(void *payload);
+
+/// Release the C++ future 'payload'
+using future_free = void (*)(void *payload) noexcept;
+
+struct future_task;
+
+/**
+ * \brief Create an ``asyncio.Future`` of the running event loop that is
+ * completed via future_resolve(). Returns ``nullptr`` and sets a Python error
+ * on failure.
+ */
+NB_CORE future_task *future_new() noexcept;
+
+/// Return a new reference to the ``asyncio.Future`` of 'task' (GIL held)
+NB_CORE PyObject *future_get(future_task *task) noexcept;
+
+/**
+ * \brief Complete the future of 'task' with the value produced by 'result'
+ * and release 'task'. Can be called from any thread, with or without holding
+ * the GIL. Takes ownership of 'payload', which is discarded once the
+ * interpreter has begun to shut down.
+ */
+NB_CORE void future_resolve(future_task *task, void *payload,
+                            future_result result, future_free free) noexcept;
+
+/**
+ * \brief Return an ``asyncio.Future`` of the running event loop that
+ * completes with the value produced by 'result' once 'wait' returns on a
+ * waiter thread. Takes ownership of 'payload' (also on failure, which
+ * returns ``nullptr`` and sets a Python error).
+ */
+NB_CORE PyObject *future_wrap(void *payload, future_wait wait,
+                              future_result result, future_free free) noexcept;
+
+// ========================================================================
+
+struct async_call;
+struct async_queue;
+
+/// Return the queue of asynchronous calls of the current interpreter (GIL held)
+NB_CORE async_queue *async_queue_get() noexcept;
+
+/// Queue a call of an async_callback<> (GIL not required, the call is
+/// discarded after shutdown)
+NB_CORE void async_push(async_queue *queue, async_call *call) noexcept;
+
+/// Release a reference within the interpreter of 'queue' along with the
+/// queue itself (GIL not required, 'o' is leaked after shutdown)
+NB_CORE void async_release(async_queue *queue, PyObject *o) noexcept;
+
+/// Run all queued calls of the current interpreter in their order of
+/// submission (GIL must be held)
+NB_CORE size_t async_drain() noexcept;
+
+// ========================================================================
+
+/// Return a dictionary describing the contents of nanobind's registries
+NB_CORE PyObject *memory_stats() noexcept;
+
+/// Return a dictionary mapping functions to their call statistics
+NB_CORE PyObject *func_stats() noexcept;
+
+/// Reset the call statistics of all functions
+NB_CORE void func_stats_reset() noexcept;
+
+/// Enable or disable the collection of call statistics
+NB_CORE void func_stats_enable(bool value) noexcept;
 
 // ========================================================================
 
@@ -371,8 +632,15 @@ NB_CORE void print(PyObject *file, PyObject *str, PyObject *end);
 
 typedef void (*exception_translator)(const std::exception_ptr &, void *);
 
+/**
+ * Register an exception translator. When 'type' is specified, the translator
+ * is additionally looked up by the dynamic type of the exception (see
+ * nb_func_convert_cpp_exception()) unless translators without a type were
+ * registered after it, and it must handle all exceptions of exactly this type.
+ */
 NB_CORE void register_exception_translator(exception_translator translator,
-                                           void *payload);
+                                           void *payload,
+                                           const std::type_info *type);
 
 NB_CORE PyObject *exception_new(PyObject *mod, const char *name,
                                 PyObject *base);
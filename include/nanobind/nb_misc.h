@@ -27,6 +27,39 @@ private:
     PyThreadState *state;
 };
 
+/**
+ * \brief Return a dictionary describing the contents of nanobind's registries
+ *
+ * See ``nanobind.memory_stats()`` in Python for the format.
+ */
+inline dict memory_stats() {
+    PyObject *result = detail::memory_stats();
+    if (!result)
+        detail::raise_python_error();
+    return steal<dict>(result);
+}
+
+/**
+ * \brief Return a dictionary mapping the functions of this interpreter that
+ * were called while statistics collection was enabled to their statistics
+ *
+ * See ``nanobind.stats()`` in Python for the format.
+ */
+inline dict func_stats() {
+    PyObject *result = detail::func_stats();
+    if (!result)
+        detail::raise_python_error();
+    return steal<dict>(result);
+}
+
+/// Reset the call statistics of all functions, see nb::func_stats()
+inline void reset_func_stats() { detail::func_stats_reset(); }
+
+/// Enable or disable the collection of call statistics, see nb::func_stats()
+inline void enable_func_stats(bool value = true) {
+    detail::func_stats_enable(value);
+}
+
 // Deleter for std::unique_ptr<T> (handles ownership by both C++ and Python)
 template <typename T> struct deleter {
     /// Instance should be cleared using a delete expression
@@ -295,6 +295,38 @@ class str : public object {
     const char *c_str() { return PyUnicode_AsUTF8AndSize(m_ptr, nullptr); }
 };
 
+/**
+ * \brief Convert a UTF8 string into a Python string that is shared with
+ * recent conversions of the same (short) string.
+ *
+ * This is useful when returning identifier-like strings (e.g., column or tag
+ * names) at high rates. The cache is bounded, so that arbitrary strings may be
+ * passed.
+ */
+inline str interned_str(const char *c, size_t n) {
+    PyObject *o = detail::str_intern(c, n);
+    if (!o)
+        detail::raise_python_error();
+    return steal<str>(o);
+}
+
+inline str interned_str(const char *c) { return interned_str(c, strlen(c)); }
+
+/**
+ * \brief Interned Python string for the string literal 's'
+ *
+ * The string is created (with its hash) the first time that the expression is
+ * evaluated within an interpreter and then reused by it. This avoids
+ * allocating and hashing a temporary string upon every attribute or item
+ * access in performance-sensitive code, e.g. ``o.attr(NB_INTERN("shape"))``,
+ * ``o[NB_INTERN("key")]``, or ``nb::getattr(o, NB_INTERN("dtype"), def)``.
+ */
+#define NB_INTERN(s)                                                           \
+    ([]() -> ::nanobind::handle {                                              \
+        static const size_t site = ::nanobind::detail::str_intern_site();      \
+        return ::nanobind::detail::str_intern_permanent(site, "" s);           \
+    }())
+
 class bytes : public object {
     NB_OBJECT_DEFAULT(bytes, object, "bytes", PyBytes_Check)
 
@@ -0,0 +1,81 @@
+/*
+    nanobind/parallel.h: nb::parallel_for() on a shared thread pool
+
+    Copyright (c) 2022 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <nanobind/nanobind.h>
+#include <nanobind/tensor.h>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+using parallel_func = void (*)(void *payload, size_t begin, size_t end);
+
+/// Run 'func' over chunks of [0, size) on the thread pool (GIL must be held)
+NB_CORE void parallel_run(size_t size, size_t grain, parallel_func func,
+                          void *payload);
+
+/// Return the number of threads (including the caller) used by parallel_run()
+NB_CORE size_t parallel_threads();
+
+NAMESPACE_END(detail)
+
+/**
+ * \brief Call ``func(begin, end)`` for disjoint subranges covering [begin, end)
+ *
+ * The GIL is released while the subranges (each containing at least
+ * ``grain`` elements) are processed by the calling thread and a thread pool
+ * that is shared by all nanobind extensions. The function must therefore not
+ * touch Python objects without acquiring the GIL. The first exception raised
+ * by ``func`` cancels the remaining work and is re-thrown once all threads are
+ * done. Nested calls run sequentially on the current thread. The pool size
+ * defaults to the number of hardware threads and can be overridden via the
+ * ``NB_NUM_THREADS`` environment variable prior to the first call.
+ */
+template <typename Func>
+void parallel_for(size_t begin, size_t end, Func &&func, size_t grain = 1) {
+    struct payload {
+        std::remove_reference_t<Func> &func;
+        size_t offset;
+    } p { func, begin };
+
+    if (end <= begin)
+        return;
+
+    detail::parallel_run(
+        end - begin, grain,
+        [](void *ptr, size_t b, size_t e) {
+            payload *p = (payload *) ptr;
+            p->func(p->offset + b, p->offset + e);
+        },
+        &p);
+}
+
+/**
+ * \brief Split a CPU tensor along its outermost dimension and process the
+ * slices ``[begin, end)`` in parallel (see the range version above)
+ *
+ * Unless specified, the minimum number of slices per call is chosen so that
+ * each chunk spans roughly 16 KiB of data.
+ */
+template <typename... Args, typename Func>
+void parallel_for(const tensor<Args...> &t, Func &&func, size_t grain = 0) {
+    size_t outer = t.ndim() ? t.shape(0) : 1;
+
+    if (grain == 0) {
+        size_t slice = ((size_t) t.dtype().bits * t.dtype().lanes + 7) / 8;
+        for (size_t i = 1; i < t.ndim(); ++i)
+            slice *= t.shape(i);
+        grain = slice ? (16384 + slice - 1) / slice : outer;
+    }
+
+    parallel_for(0, outer, (Func &&) func, grain);
+}
+
+NAMESPACE_END(NB_NAMESPACE)
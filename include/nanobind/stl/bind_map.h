@@ -0,0 +1,123 @@
+/*
+    nanobind/stl/bind_map.h: Automatic creation of bindings for map-style
+    containers
+
+    Copyright (c) 2022 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <nanobind/nanobind.h>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+/// State of an iterator over a bound map (Kind: 0 = keys, 1 = values, 2 = items)
+template <typename Map, int Kind> struct map_iterator_state {
+    typename Map::iterator it, end;
+};
+
+template <typename Map, int Kind>
+void bind_map_iterator(handle scope, const char *name) {
+    using State = map_iterator_state<Map, Kind>;
+    using Mapped = typename Map::mapped_type;
+
+    class_<State>(scope, name)
+        .def("__iter__", [](handle self) { return borrow(self); })
+        .def("__next__", [](handle self) -> object {
+            State &s = cast<State &>(self);
+            if (s.it == s.end)
+                throw stop_iteration();
+            auto &entry = *s.it++;
+
+            if constexpr (Kind == 0) {
+                return cast(entry.first, rv_policy::copy);
+            } else {
+                object value = cast(entry.second, rv_policy::reference);
+                if constexpr (make_caster<Mapped>::IsClass)
+                    keep_alive(value.ptr(), self.ptr());
+                if constexpr (Kind == 1)
+                    return value;
+                else
+                    return make_tuple(cast(entry.first, rv_policy::copy), value);
+            }
+        });
+}
+
+NAMESPACE_END(detail)
+
+/**
+ * \brief Bind a map-style container as an opaque Python type
+ *
+ * Like ``bind_vector``, the resulting type exposes the container with
+ * reference semantics: lookups return views into the live container that keep
+ * it alive. Keys are returned by value. Iterating over the map yields its
+ * keys, and ``values()``/``items()`` return iterators that don't materialize
+ * the container.
+ */
+template <typename Map, typename... Args>
+class_<Map> bind_map(handle scope, const char *name, Args &&...args) {
+    using Key = typename Map::key_type;
+    using Mapped = typename Map::mapped_type;
+    using KeyIterator = detail::map_iterator_state<Map, 0>;
+    using ValueIterator = detail::map_iterator_state<Map, 1>;
+    using ItemIterator = detail::map_iterator_state<Map, 2>;
+
+    class_<Map> cl(scope, name, (detail::forward_t<Args>) args...);
+
+    detail::bind_map_iterator<Map, 0>(cl, "KeyIterator");
+    detail::bind_map_iterator<Map, 1>(cl, "ValueIterator");
+    detail::bind_map_iterator<Map, 2>(cl, "ItemIterator");
+
+    cl.def(init<>(), "Default constructor")
+      .def(init<const Map &>(), "Copy constructor")
+      .def("__len__", [](const Map &m) { return m.size(); })
+      .def("__bool__", [](const Map &m) { return !m.empty(); },
+           "Check whether the map is nonempty")
+      .def("__contains__",
+           [](const Map &m, const Key &k) { return m.find(k) != m.end(); })
+      .def("__contains__", [](const Map &, handle) { return false; })
+      .def("__getitem__",
+           [](Map &m, const Key &k) -> Mapped & {
+               auto it = m.find(k);
+               if (it == m.end())
+                   throw key_error();
+               return it->second;
+           }, rv_policy::reference_internal)
+      .def("__setitem__",
+           [](Map &m, const Key &k, const Mapped &v) {
+               auto it = m.find(k);
+               if (it != m.end())
+                   it->second = v;
+               else
+                   m.emplace(k, v);
+           })
+      .def("__delitem__",
+           [](Map &m, const Key &k) {
+               auto it = m.find(k);
+               if (it == m.end())
+                   throw key_error();
+               m.erase(it);
+           })
+      .def("clear", [](Map &m) { m.clear(); },
+           "Remove all items from the map")
+      .def("__iter__",
+           [](Map &m) { return KeyIterator{ m.begin(), m.end() }; },
+           keep_alive<0, 1>())
+      .def("keys",
+           [](Map &m) { return KeyIterator{ m.begin(), m.end() }; },
+           keep_alive<0, 1>(), "Return an iterator over the keys")
+      .def("values",
+           [](Map &m) { return ValueIterator{ m.begin(), m.end() }; },
+           keep_alive<0, 1>(), "Return an iterator over the values")
+      .def("items",
+           [](Map &m) { return ItemIterator{ m.begin(), m.end() }; },
+           keep_alive<0, 1>(), "Return an iterator over (key, value) pairs");
+
+    return cl;
+}
+
+NAMESPACE_END(NB_NAMESPACE)
@@ -0,0 +1,117 @@
+/*
+    nanobind/stl/bind_vector.h: Automatic creation of bindings for vector-style
+    containers
+
+    Copyright (c) 2022 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <nanobind/nanobind.h>
+#include <vector>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+/// Normalize a (potentially negative) Python index, raise IndexError if invalid
+inline size_t wrap_index(Py_ssize_t i, size_t n) {
+    if (i < 0)
+        i += (Py_ssize_t) n;
+    if (i < 0 || (size_t) i >= n)
+        throw index_error();
+    return (size_t) i;
+}
+
+NAMESPACE_END(detail)
+
+/**
+ * \brief Bind a vector-style container as an opaque Python type
+ *
+ * The resulting type exposes the container with reference semantics: element
+ * accesses return views into the live container that keep it alive, and no
+ * conversion into a Python ``list`` takes place. Iteration uses the sequence
+ * protocol (``__len__`` and ``__getitem__``). Note that views may dangle when
+ * the container is subsequently resized from C++ or Python.
+ *
+ * Containers whose elements can't be referenced (``std::vector<bool>``)
+ * return copies of their elements instead.
+ */
+template <typename Vector, typename... Args>
+class_<Vector> bind_vector(handle scope, const char *name, Args &&...args) {
+    using Value = typename Vector::value_type;
+
+    static_assert(
+        std::is_base_of_v<detail::type_caster_base<Vector>,
+                          detail::make_caster<Vector>>,
+        "nanobind::bind_vector(): the type caster of this container is "
+        "overridden, e.g. by nanobind/stl/vector.h. Mark it with "
+        "NB_MAKE_OPAQUE() to bind it.");
+
+    class_<Vector> cl(scope, name, (detail::forward_t<Args>) args...);
+
+    cl.def(init<>(), "Default constructor")
+      .def(init<const Vector &>(), "Copy constructor")
+      .def("__init__", [](Vector *v, handle h) {
+               new (v) Vector();
+               try {
+                   for (handle item : h)
+                       v->push_back(cast<Value>(item));
+               } catch (...) {
+                   v->~Vector();
+                   throw;
+               }
+           }, "Construct from an iterable object")
+      .def("__len__", [](const Vector &v) { return v.size(); })
+      .def("__bool__", [](const Vector &v) { return !v.empty(); },
+           "Check whether the vector is nonempty")
+      .def("__setitem__",
+           [](Vector &v, Py_ssize_t i, const Value &value) {
+               v[detail::wrap_index(i, v.size())] = value;
+           })
+      .def("__delitem__",
+           [](Vector &v, Py_ssize_t i) {
+               v.erase(v.begin() + (ptrdiff_t) detail::wrap_index(i, v.size()));
+           })
+      .def("clear", [](Vector &v) { v.clear(); },
+           "Remove all items from the vector")
+      .def("append", [](Vector &v, const Value &value) { v.push_back(value); },
+           "Append an item to the end of the vector")
+      .def("extend",
+           [](Vector &v, handle h) {
+               for (handle item : h)
+                   v.push_back(cast<Value>(item));
+           }, "Append the elements of an iterable object")
+      .def("insert",
+           [](Vector &v, Py_ssize_t i, const Value &value) {
+               if (i < 0)
+                   i += (Py_ssize_t) v.size();
+               if (i < 0 || (size_t) i > v.size())
+                   throw index_error();
+               v.insert(v.begin() + i, value);
+           }, "Insert an item at a given position")
+      .def("pop",
+           [](Vector &v, Py_ssize_t i) {
+               size_t index = detail::wrap_index(i, v.size());
+               Value result = std::move(v[index]);
+               v.erase(v.begin() + (ptrdiff_t) index);
+               return result;
+           }, arg("index") = -1, "Remove and return the item at a given position");
+
+    if constexpr (std::is_same_v<typename Vector::reference, Value &>) {
+        cl.def("__getitem__",
+               [](Vector &v, Py_ssize_t i) -> Value & {
+                   return v[detail::wrap_index(i, v.size())];
+               }, rv_policy::reference_internal);
+    } else {
+        cl.def("__getitem__", [](Vector &v, Py_ssize_t i) -> Value {
+            return v[detail::wrap_index(i, v.size())];
+        });
+    }
+
+    return cl;
+}
+
+NAMESPACE_END(NB_NAMESPACE)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <nanobind/nanobind.h>
+#include <string>
 
 NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
@@ -13,6 +14,10 @@ template <typename Value_, typename Key, typename Element> struct dict_caster {
     using KeyCaster = make_caster<Key>;
     using ElementCaster = make_caster<Element>;
 
+    // Assume a single converted item; larger dicts fall back to the heap
+    static constexpr uint32_t Cleanup =
+        caster_cleanup_v<KeyCaster> + caster_cleanup_v<ElementCaster>;
+
     bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
         value.clear();
 
@@ -50,21 +55,31 @@ template <typename Value_, typename Key, typename Element> struct dict_caster {
 
     template <typename T>
     static handle from_cpp(T &&src, rv_policy policy, cleanup_list *cleanup) {
-        dict ret;
+        rv_policy key_policy = element_policy<T, Key>(policy),
+                  element_policy_ = element_policy<T, Element>(policy);
+        object ret = steal(dict_new_presized(src.size()));
         if (ret) {
             for (auto &item : src) {
-                object k = steal(KeyCaster::from_cpp(
-                    forward_like<typename T::key_type>(item.first), policy, cleanup));
-                object e = steal(ElementCaster::from_cpp(
-                    forward_like<typename T::mapped_type>(item.second), policy, cleanup));
+                object k, e;
+
+                /* String keys usually come from a small set of names; share
+                   Python string objects between conversions */
+                if constexpr (std::is_same_v<intrinsic_t<Key>, std::string>)
+                    k = steal(str_intern(item.first.data(), item.first.size()));
+                else
+                    k = steal(KeyCaster::from_cpp(forward_like<T>(item.first),
+                                                  key_policy, cleanup));
+
+                e = steal(ElementCaster::from_cpp(
+                    forward_like<T>(item.second), element_policy_, cleanup));
+
+                if (!k.is_valid() || !e.is_valid())
+                    return handle();
 
                 if (PyDict_SetItem(ret.ptr(), k.ptr(), e.ptr()) != 0) {
                     PyErr_Clear();
                     return handle();
                 }
-
-                if (!k.is_valid() || !e.is_valid())
-                    return handle();
             }
         }
         return ret.release();
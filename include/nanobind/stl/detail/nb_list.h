@@ -11,54 +11,102 @@ template <typename Value_, typename Entry> struct list_caster {
 
     using Caster = make_caster<Entry>;
 
-    template <typename T> using has_reserve = decltype(std::declval<T>().reserve(0));
+    // Assume a single converted entry; longer sequences fall back to the heap
+    static constexpr uint32_t Cleanup = caster_cleanup_v<Caster>;
 
-    bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
-        size_t size;
-        PyObject *temp;
+    template <typename T> using has_reserve = decltype(std::declval<T>().reserve(0));
+    template <typename T> using has_data = decltype(std::declval<T>().data());
 
-        /* Will initialize 'size' and 'temp'. All return values and
-           return parameters are zero/NULL in the case of a failure. */
-        PyObject **o = seq_get(src.ptr(), &size, &temp);
+    template <typename T> using is_plain_class = decltype(T::IsPlainClass);
 
-        value.clear();
+    /// Contiguous containers of bound types are converted in one batch
+    static constexpr bool IsContiguousClass =
+        is_detected_v<is_plain_class, Caster> &&
+        std::is_same_v<Entry, intrinsic_t<Entry>> &&
+        is_detected_v<has_data, Value_>;
 
-        if constexpr (is_detected_v<has_reserve, Value_>)
-            value.reserve(size);
+    template <typename T> using has_resize = decltype(std::declval<T>().resize(0));
 
-        Caster caster;
-        bool success = o != nullptr;
+    /// Contiguous containers of numbers are converted by libnanobind in bulk
+    static constexpr bool IsContiguousArith =
+        std::is_arithmetic_v<Entry> && !std::is_same_v<Entry, bool> &&
+        !is_std_char_v<Entry> && sizeof(Entry) <= 8 &&
+        std::is_same_v<Caster, type_caster<Entry>> &&
+        std::is_same_v<typename Value_::value_type, Entry> &&
+        is_detected_v<has_data, Value_> && is_detected_v<has_resize, Value_>;
 
-        for (size_t i = 0; i < size; ++i) {
-            if (!caster.from_python(o[i], flags, cleanup)) {
-                success = false;
-                break;
+    bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        if constexpr (IsContiguousArith) {
+            (void) cleanup;
+            constexpr uint8_t code = std::is_floating_point_v<Entry> ? 2 :
+                                     (std::is_signed_v<Entry> ? 0 : 1);
+            bool success = seq_load_arith(
+                src.ptr(), flags, code, sizeof(Entry),
+                [](void *p, size_t n) -> void * {
+                    Value_ &v = *(Value_ *) p;
+                    v.resize(n);
+                    return v.data();
+                }, &value);
+            if (!success)
+                value.clear();
+            return success;
+        } else {
+            size_t size;
+            PyObject *temp, *storage[16];
+
+            /* Will initialize 'size' and 'temp'. All return values and
+               return parameters are zero/NULL in the case of a failure. */
+            PyObject **o = seq_get(src.ptr(), &size, &temp, storage, 16);
+
+            value.clear();
+
+            if constexpr (is_detected_v<has_reserve, Value_>)
+                value.reserve(size);
+
+            Caster caster;
+            bool success = o != nullptr;
+
+            for (size_t i = 0; i < size; ++i) {
+                if (!caster.from_python(o[i], flags, cleanup)) {
+                    success = false;
+                    break;
+                }
+                value.push_back(
+                    ((Caster &&) caster).operator cast_t<Entry &&>());
             }
-            value.push_back(((Caster &&) caster).operator cast_t<Entry &&>());
-        }
 
-        Py_XDECREF(temp);
+            Py_XDECREF(temp);
 
-        return success;
+            return success;
+        }
     }
 
     template <typename T>
     static handle from_cpp(T &&src, rv_policy policy, cleanup_list *cleanup) {
-        object list = steal(PyList_New(src.size()));
-        if (list) {
-            Py_ssize_t index = 0;
-
-            for (auto &value : src) {
-                handle h =
-                    Caster::from_cpp(forward_like<T>(value), policy, cleanup);
-
-                NB_LIST_SET_ITEM(list.ptr(), index++, h.ptr());
-                if (!h.is_valid())
-                    return handle();
+        policy = element_policy<T, Entry>(policy);
+
+        if constexpr (IsContiguousClass) {
+            using Elem = decltype(forward_like<T>(*src.data()));
+            return nb_type_put_n(&typeid(Entry), (void *) src.data(),
+                                 sizeof(Entry), src.size(),
+                                 infer_policy<Elem>(policy), cleanup);
+        } else {
+            object list = steal(PyList_New(src.size()));
+            if (list) {
+                Py_ssize_t index = 0;
+
+                for (auto &value : src) {
+                    handle h = Caster::from_cpp(forward_like<T>(value),
+                                                policy, cleanup);
+
+                    NB_LIST_SET_ITEM(list.ptr(), index++, h.ptr());
+                    if (!h.is_valid())
+                        return handle();
+                }
             }
-        }
 
-        return list.release();
+            return list.release();
+        }
     }
 };
 
@@ -37,6 +37,17 @@ struct type_caster<std::function<Return(Args...)>> {
         if (!PyCallable_Check(src.ptr()))
             return false;
 
+        /* Unwrap nanobind functions that were created from a compatible C++
+           callable, which can then be invoked without involving Python */
+        using Func = Return (*)(Args...);
+        if (void *p = nb_func_get_capture(src.ptr(), &typeid(Value))) {
+            value = *(const Value *) p;
+            return true;
+        } else if (void *p2 = nb_func_get_capture(src.ptr(), &typeid(Func))) {
+            value = *(const Func *) p2;
+            return true;
+        }
+
         value = [f = function_handle(src)](Args... args) -> Return {
             gil_scoped_acquire acq;
             return cast<Return>(f.f((forward_t<Args>) args...));
@@ -0,0 +1,165 @@
+/*
+    nanobind/stl/future.h: type caster returning std::future<T> as an awaitable
+
+    Copyright (c) 2022 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <nanobind/nanobind.h>
+#include <future>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+/**
+ * \brief Convert a returned ``std::future<T>`` into an ``asyncio.Future`` of
+ * the running event loop (see future_wrap())
+ *
+ * The future is waited upon by a thread that does not hold the GIL. Once it
+ * is ready, the value (or exception) is converted using the type caster of
+ * ``T`` and passed to the event loop via ``loop.call_soon_threadsafe()``.
+ * Cancelling the ``asyncio.Future`` discards the result, but the C++ work
+ * continues.
+ */
+template <typename T> struct type_caster<std::future<T>> {
+    using Value = std::future<T>;
+    using Caster =
+        make_caster<std::conditional_t<std::is_void_v<T>, void_type, T>>;
+    static constexpr auto Name = const_name("Awaitable[") + Caster::Name +
+                                 const_name("]");
+    static constexpr bool IsClass = false;
+    template <typename T_> using Cast = movable_cast_t<T_>;
+
+    struct payload {
+        Value future;
+        rv_policy policy;
+    };
+
+    bool from_python(handle, uint8_t, cleanup_list *) noexcept {
+        return false;
+    }
+
+    static handle from_cpp(Value &&value, rv_policy policy,
+                           cleanup_list *) noexcept {
+        if (!value.valid())
+            return none().release();
+
+        /* Values obtained from the future are temporaries, while pointers and
+           references are handled according to the specified policy */
+        if constexpr (!std::is_pointer_v<T> && !std::is_reference_v<T>)
+            policy = rv_policy::move;
+
+        payload *p = new payload{ std::move(value), policy };
+
+        return future_wrap(
+            p,
+            [](void *p_) noexcept { ((payload *) p_)->future.wait(); },
+            [](void *p_) -> PyObject * {
+                payload *p2 = (payload *) p_;
+                if constexpr (std::is_void_v<T>) {
+                    p2->future.get();
+                    return none().release().ptr();
+                } else {
+                    return Caster::from_cpp(p2->future.get(), p2->policy,
+                                            nullptr).ptr();
+                }
+            },
+            [](void *p_) noexcept { delete (payload *) p_; });
+    }
+};
+
+NAMESPACE_END(detail)
+
+/**
+ * \brief Producer side of an ``asyncio.Future`` that C++ code completes from
+ * any thread, with or without holding the GIL
+ *
+ * Unlike a returned ``std::future<T>``, this does not occupy a waiter thread.
+ * The promise must be created while an event loop is running and the GIL is
+ * held. Return the object produced by get_future() to Python, and later call
+ * set_value() or set_exception() (e.g., from the completion handler of an
+ * asynchronous C++ API). Destroying an unsatisfied promise completes the
+ * future with a ``std::future_error`` (broken promise). Results arriving
+ * after the interpreter began to shut down are discarded.
+ */
+template <typename T> class async_promise {
+    using Caster =
+        detail::make_caster<std::conditional_t<std::is_void_v<T>, detail::void_type, T>>;
+
+public:
+    async_promise() : m_task(detail::future_new()) {
+        if (!m_task)
+            detail::raise_python_error();
+    }
+
+    async_promise(async_promise &&p) noexcept
+        : m_task(std::exchange(p.m_task, nullptr)) { }
+
+    async_promise &operator=(async_promise &&p) noexcept {
+        std::swap(m_task, p.m_task);
+        return *this;
+    }
+
+    async_promise(const async_promise &) = delete;
+    async_promise &operator=(const async_promise &) = delete;
+
+    ~async_promise() {
+        if (m_task)
+            set_exception(std::make_exception_ptr(
+                std::future_error(std::future_errc::broken_promise)));
+    }
+
+    /// Return the ``asyncio.Future`` (GIL must be held)
+    object get_future() const {
+        if (!m_task)
+            detail::raise("nanobind::async_promise::get_future(): the "
+                          "promise was already satisfied!");
+        return steal(detail::future_get(m_task));
+    }
+
+    /// Complete the future with a value (converted while holding the GIL)
+    template <typename... Ts> void set_value(Ts &&...value) {
+        using Value = std::conditional_t<std::is_void_v<T>, detail::void_type,
+                                         std::decay_t<T>>;
+        resolve(
+            new Value((Ts &&) value...),
+            [](void *p) -> PyObject * {
+                if constexpr (std::is_void_v<T>)
+                    return none().release().ptr();
+                else
+                    return Caster::from_cpp(std::move(*(Value *) p),
+                                            rv_policy::move, nullptr).ptr();
+            },
+            [](void *p) noexcept { delete (Value *) p; });
+    }
+
+    /// Complete the future with an exception (translated into Python)
+    void set_exception(std::exception_ptr e) {
+        resolve(
+            new std::exception_ptr(std::move(e)),
+            [](void *p) -> PyObject * {
+                std::rethrow_exception(*(std::exception_ptr *) p);
+            },
+            [](void *p) noexcept { delete (std::exception_ptr *) p; });
+    }
+
+private:
+    void resolve(void *payload, detail::future_result result,
+                 detail::future_free free) {
+        if (!m_task) {
+            free(payload);
+            detail::raise("nanobind::async_promise: the promise was already "
+                          "satisfied!");
+        }
+        detail::future_resolve(std::exchange(m_task, nullptr), payload,
+                               result, free);
+    }
+
+    detail::future_task *m_task;
+};
+
+NAMESPACE_END(NB_NAMESPACE)
@@ -16,6 +16,7 @@ struct type_caster<std::optional<T>> {
 
     static constexpr auto Name = const_name("Optional[") + concat(Caster::Name) + const_name("]");;
     static constexpr bool IsClass = false;
+    static constexpr uint32_t Cleanup = caster_cleanup_v<Caster>;
 
     template <typename T_>
     using Cast = movable_cast_t<T_>;
@@ -54,7 +55,8 @@ struct type_caster<std::optional<T>> {
     static handle from_cpp(T_ &&value, rv_policy policy, cleanup_list *cleanup) noexcept {
         if (!value)
             return none().release();
-        return Caster::from_cpp(forward_like<T_>(*value), policy, cleanup);
+        return Caster::from_cpp(forward_like<T_>(*value),
+                                element_policy<T_, T>(policy), cleanup);
     }
 
     explicit operator Value *() { return &value; }
@@ -31,6 +31,9 @@ template <typename T1, typename T2> struct type_caster<std::pair<T1, T2>> {
      */
     template <typename T> using Cast = Value;
 
+    static constexpr uint32_t Cleanup =
+        caster_cleanup_v<Caster1> + caster_cleanup_v<Caster2>;
+
     // Value name for docstring generation
     static constexpr auto Name =
         const_name("tuple[") + concat(Caster1::Name, Caster2::Name) + const_name("]");
@@ -38,8 +41,9 @@ template <typename T1, typename T2> struct type_caster<std::pair<T1, T2>> {
     /// Python -> C++ caster, populates `caster1` and `caster2` upon success
     bool from_python(handle src, uint8_t flags,
                      cleanup_list *cleanup) noexcept {
-        PyObject *temp; // always initialized by the following line
-        PyObject **o = seq_get_with_size(src.ptr(), 2, &temp);
+        PyObject *temp, // always initialized by the following line
+                 *storage[2];
+        PyObject **o = seq_get_with_size(src.ptr(), 2, &temp, storage);
 
         bool success = o &&
                        caster1.from_python(o[0], flags, cleanup) &&
@@ -61,12 +65,14 @@ template <typename T1, typename T2> struct type_caster<std::pair<T1, T2>> {
     static handle from_cpp(T &&value, rv_policy policy,
                            cleanup_list *cleanup) noexcept {
         object o1 = steal(
-            Caster1::from_cpp(forward_like<T>(value.first), policy, cleanup));
+            Caster1::from_cpp(forward_like<T>(value.first),
+                              element_policy<T, T1>(policy), cleanup));
         if (!o1.is_valid())
             return {};
 
         object o2 = steal(
-            Caster2::from_cpp(forward_like<T>(value.second), policy, cleanup));
+            Caster2::from_cpp(forward_like<T>(value.second),
+                              element_policy<T, T2>(policy), cleanup));
         if (!o2.is_valid())
             return {};
 
@@ -20,6 +20,14 @@ NAMESPACE_BEGIN(detail)
  * std::enable_shared_from_this weak pointer. The specified deleter reduces the
  * reference count of the Python object.
  *
+ * Control blocks are reused across conversions of the same instance, which
+ * caches a weak pointer to the control block that was created by the
+ * previous conversion. The control block always holds a reference to the
+ * Python instance, which preserves its identity (and any instance
+ * dictionary) while C++ code holds on to the shared pointer. The result
+ * aliases 'ptr', which can differ from the cached pointer when converting
+ * to a base class.
+ *
  * The next two functions are simultaneously marked as 'inline' (to avoid
  * linker errors) and 'NB_NOINLINE' (to avoid them being inlined into every
  * single shared_ptr type_caster, which would enlarge the binding size)
@@ -35,16 +43,32 @@ shared_from_python(void *ptr, handle h) noexcept {
         PyObject *o;
     };
 
-    if (ptr)
-        return std::shared_ptr<void>(ptr, py_deleter{ h.inc_ref().ptr() });
-    else
+    if (!ptr)
         return std::shared_ptr<void>((PyObject *) nullptr);
+
+    std::weak_ptr<void> *cache =
+        (std::weak_ptr<void> *) keep_alive_find(h.ptr(), weak_ptr_delete);
+
+    if (cache) {
+        std::shared_ptr<void> result = cache->lock();
+        if (result)
+            return std::shared_ptr<void>(result, ptr);
+    }
+
+    std::shared_ptr<void> result(ptr, py_deleter{ h.inc_ref().ptr() });
+
+    if (cache)
+        *cache = result;
+    else
+        keep_alive(h.ptr(), new std::weak_ptr<void>(result), weak_ptr_delete);
+
+    return result;
 }
 
 inline NB_NOINLINE void shared_from_cpp(std::shared_ptr<void> &&ptr,
                                         PyObject *o) noexcept {
     keep_alive(o, new std::shared_ptr<void>(std::move(ptr)),
-               [](void *p) noexcept { delete (std::shared_ptr<void> *) p; });
+               shared_ptr_delete);
 }
 
 template <class T, class = void>
@@ -69,6 +93,7 @@ template <typename T> struct type_caster<std::shared_ptr<T>> {
 
     static constexpr auto Name = Caster::Name;
     static constexpr bool IsClass = true;
+    static constexpr uint32_t Cleanup = caster_cleanup_v<Caster>;
 
     template <typename T_> using Cast = movable_cast_t<T_>;
 
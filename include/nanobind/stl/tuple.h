@@ -14,6 +14,8 @@ template <typename... Ts> struct type_caster<std::tuple<Ts...>> {
     using Indices = std::make_index_sequence<N>;
 
     static constexpr bool IsClass = false;
+    static constexpr uint32_t Cleanup =
+        (caster_cleanup_v<make_caster<Ts>> + ... + 0);
     static constexpr auto Name = const_name("tuple[") +
                                  concat(make_caster<Ts>::Name...) +
                                  const_name("]");
@@ -31,8 +33,9 @@ template <typename... Ts> struct type_caster<std::tuple<Ts...>> {
                                     std::index_sequence<Is...>) noexcept {
         (void) src; (void) flags; (void) cleanup;
 
-        PyObject *temp; // always initialized by the following line
-        PyObject **o = seq_get_with_size(src.ptr(), N, &temp);
+        PyObject *temp, // always initialized by the following line
+                 *storage[N + 1];
+        PyObject **o = seq_get_with_size(src.ptr(), N, &temp, storage);
 
         bool success =
             (o && ... &&
@@ -66,7 +69,8 @@ template <typename... Ts> struct type_caster<std::tuple<Ts...>> {
         bool success =
             (... &&
              ((o[Is] = steal(make_caster<Ts>::from_cpp(
-                   forward_like<T>(std::get<Is>(value)), policy, cleanup))),
+                   forward_like<T>(std::get<Is>(value)),
+                   element_policy<T, Ts>(policy), cleanup))),
               o[Is].is_valid()));
 
         if (!success)
@@ -36,6 +36,7 @@ struct type_caster<std::unique_ptr<T, Deleter>> {
 
     static constexpr auto Name = Caster::Name;
     static constexpr bool IsClass = true;
+    static constexpr uint32_t Cleanup = caster_cleanup_v<Caster>;
     template <typename T_> using Cast = Value;
 
     Caster caster;
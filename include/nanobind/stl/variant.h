@@ -2,6 +2,8 @@
 
 #include <nanobind/nanobind.h>
 #include <variant>
+#include <string>
+#include <string_view>
 
 NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
@@ -54,11 +56,49 @@ class type_caster<std::variant<Ts...>> {
         return true;
     }
 
+    /// Return the Python type that exactly identifies alternative 'T' (or NULL)
+    template <typename T> static PyTypeObject *exact_type() noexcept {
+        using Ti = intrinsic_t<T>;
+
+        if constexpr (std::is_same_v<Ti, std::monostate>)
+            return Py_TYPE(Py_None);
+        else if constexpr (std::is_same_v<Ti, bool>)
+            return &PyBool_Type;
+        else if constexpr (std::is_integral_v<Ti> && !is_std_char_v<Ti>)
+            return &PyLong_Type;
+        else if constexpr (std::is_floating_point_v<Ti>)
+            return &PyFloat_Type;
+        else if constexpr (std::is_same_v<Ti, std::string> ||
+                           std::is_same_v<Ti, std::string_view>)
+            return &PyUnicode_Type;
+        else if constexpr (Caster<T>::IsClass) {
+            if constexpr (std::is_base_of_v<type_caster_base<Ti>, Caster<T>>)
+                return (PyTypeObject *) nb_type_lookup(&typeid(Ti));
+            else
+                return nullptr;
+        } else {
+            return nullptr;
+        }
+    }
+
+    /**
+     * Try the alternatives whose Python type is an exact match of 'tp'. The
+     * types of builtin alternatives are constants, while bound types are
+     * looked up on each call: they may not be registered yet, and every
+     * interpreter has its own type objects.
+     */
+    bool dispatch(PyTypeObject *tp, const handle &src, uint8_t flags,
+                  cleanup_list *cleanup) {
+        return ((exact_type<Ts>() == tp &&
+                 variadic_caster<Ts>(src, flags, cleanup)) || ...);
+    }
+
 public:
     using Value = std::variant<Ts...>;
 
     static constexpr auto Name = const_name("Union[") + concat(Caster<Ts>::Name...) + const_name("]");
     static constexpr bool IsClass = false;
+    static constexpr uint32_t Cleanup = (caster_cleanup_v<Caster<Ts>> + ... + 0);
 
     template <typename T>
     using Cast = movable_cast_t<T>;
@@ -66,6 +106,8 @@ public:
     Value value;
 
     bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        if (dispatch(Py_TYPE(src.ptr()), src, flags, cleanup))
+            return true;
         return (variadic_caster<Ts>(src, flags, cleanup) || ...);
     }
 
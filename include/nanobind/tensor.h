@@ -12,6 +12,19 @@
 #pragma once
 
 #include <nanobind/nanobind.h>
+#include <vector>
+#include <initializer_list>
+#include <memory>
+
+/// Declare a trivially copyable structure as a tensor record type
+#define NB_MAKE_RECORD(...)                                                    \
+    namespace nanobind::detail {                                               \
+    template <> struct is_record<__VA_ARGS__> : std::true_type {               \
+        static_assert(std::is_trivially_copyable_v<__VA_ARGS__> &&             \
+                          !std::is_empty_v<__VA_ARGS__>,                       \
+                      "NB_MAKE_RECORD(): the type must be trivially copyable " \
+                      "and nonempty!");                                        \
+    }; }
 
 NAMESPACE_BEGIN(NB_NAMESPACE)
 
@@ -32,7 +45,9 @@ NAMESPACE_END(device)
 NAMESPACE_BEGIN(dlpack)
 
 enum class dtype_code : uint8_t {
-    Int = 0, UInt = 1, Float = 2, Bfloat = 4, Complex = 5
+    Int = 0, UInt = 1, Float = 2, Bfloat = 4, Complex = 5, Bool = 6,
+    /// nanobind extension: 'lanes' bytes of a type registered via nb::record_dtype()
+    Record = 0x80
 };
 
 struct device {
@@ -71,28 +86,60 @@ template <size_t... Is> struct shape {
 
 struct c_contig { };
 struct f_contig { };
+
+/**
+ * Stream that the DLPack producer should synchronize with before handing out
+ * a CUDA/ROCm tensor (1: legacy default stream, 2: per-thread default stream,
+ * -1: no synchronization, other values: a 'cudaStream_t' pointer value)
+ */
+template <intptr_t Value> struct dlpack_stream {
+    static_assert(Value != 0, "nb::dlpack_stream<0> is ambiguous and not "
+                              "permitted by the DLPack protocol!");
+};
 struct numpy { };
 struct tensorflow { };
 struct pytorch { };
 struct jax { };
 
+NAMESPACE_BEGIN(detail)
+
+/// Record types are declared via NB_MAKE_RECORD(), see nb::record_dtype()
+template <typename T> struct is_record : std::false_type { };
+
+template <typename T>
+constexpr bool is_record_v = is_record<std::remove_cv_t<T>>::value;
+
+NAMESPACE_END(detail)
+
 template <typename T> constexpr dlpack::dtype dtype() {
     static_assert(
-        std::is_floating_point_v<T> || std::is_integral_v<T>,
-        "nanobind::dtype<T>: T must be a floating point or integer variable!"
+        std::is_floating_point_v<T> || std::is_integral_v<T> ||
+            detail::is_record_v<T>,
+        "nanobind::dtype<T>: T must be a floating point, integer, or record "
+        "variable!"
     );
 
     dlpack::dtype result;
 
-    if constexpr (std::is_floating_point_v<T>)
-        result.code = (uint8_t) dlpack::dtype_code::Float;
-    else if constexpr (std::is_signed_v<T>)
-        result.code = (uint8_t) dlpack::dtype_code::Int;
-    else
-        result.code = (uint8_t) dlpack::dtype_code::UInt;
-
-    result.bits = sizeof(T) * 8;
-    result.lanes = 1;
+    if constexpr (detail::is_record_v<T>) {
+        static_assert(sizeof(T) <= 0xFFFF,
+                      "nanobind::dtype<T>: the record type is too large!");
+        result.code = (uint8_t) dlpack::dtype_code::Record;
+        result.bits = 8;
+        result.lanes = (uint16_t) sizeof(T);
+    } else {
+        if constexpr (std::is_same_v<std::remove_cv_t<T>, bool>)
+            result.code = (uint8_t) dlpack::dtype_code::Bool;
+        else if constexpr (std::is_floating_point_v<T>)
+            result.code = (uint8_t) dlpack::dtype_code::Float;
+        else if constexpr (std::is_signed_v<T>)
+            result.code = (uint8_t) dlpack::dtype_code::Int;
+        else
+            result.code = (uint8_t) dlpack::dtype_code::UInt;
+
+        result.bits = sizeof(T) * 8;
+        result.lanes = 1;
+    }
 
     return result;
 }
@@ -110,6 +157,10 @@ struct tensor_req {
     bool req_dtype = false;
     char req_order = '\0';
     uint8_t req_device = 0;
+    bool req_stream = false;
+    intptr_t stream = 0;
+    /// Accept read-only memory (the scalar type is const-qualified)
+    bool accept_readonly = false;
 };
 
 template <typename T, typename = int> struct tensor_arg {
@@ -127,10 +178,13 @@ template <typename T> struct tensor_arg<T, enable_if_t<std::is_floating_point_v<
     static void apply(tensor_req &tr) {
         tr.dtype = dtype<T>();
         tr.req_dtype = true;
+        tr.accept_readonly = std::is_const_v<T>;
     }
 };
 
-template <typename T> struct tensor_arg<T, enable_if_t<std::is_integral_v<T>>> {
+template <typename T>
+struct tensor_arg<T, enable_if_t<std::is_integral_v<T> &&
+                                 !std::is_same_v<std::remove_cv_t<T>, bool>>> {
     static constexpr size_t size = 0;
 
     static constexpr auto name =
@@ -140,6 +194,30 @@ template <typename T> struct tensor_arg<T, enable_if_t<std::is_integral_v<T>>> {
     static void apply(tensor_req &tr) {
         tr.dtype = dtype<T>();
         tr.req_dtype = true;
+        tr.accept_readonly = std::is_const_v<T>;
+    }
+};
+
+template <typename T> struct tensor_arg<T, enable_if_t<is_record_v<T>>> {
+    static constexpr size_t size = 0;
+    static constexpr auto name = const_name("dtype=record");
+
+    static void apply(tensor_req &tr) {
+        tr.dtype = dtype<T>();
+        tr.req_dtype = true;
+        tr.accept_readonly = std::is_const_v<T>;
+    }
+};
+
+template <typename T>
+struct tensor_arg<T, enable_if_t<std::is_same_v<std::remove_cv_t<T>, bool>>> {
+    static constexpr size_t size = 0;
+    static constexpr auto name = const_name("dtype=bool");
+
+    static void apply(tensor_req &tr) {
+        tr.dtype = dtype<T>();
+        tr.req_dtype = true;
+        tr.accept_readonly = std::is_const_v<T>;
     }
 };
 
@@ -170,22 +248,38 @@ template <> struct tensor_arg<f_contig> {
     static void apply(tensor_req &tr) { tr.req_order = 'F'; }
 };
 
+template <intptr_t Value> struct tensor_arg<dlpack_stream<Value>> {
+    static constexpr size_t size = 0;
+    static constexpr auto name = descr<0>{ };
+    static void apply(tensor_req &tr) {
+        tr.req_stream = true;
+        tr.stream = Value;
+    }
+};
+
 template <typename T> struct tensor_arg<T, enable_if_t<T::is_device>> {
     static constexpr size_t size = 0;
     static constexpr auto name = const_name("device='") + T::name + const_name('\'');
     static void apply(tensor_req &tr) { tr.req_device = (uint8_t) T::value; }
 };
 
+/// Device type of a tensor annotation (or device::none::value)
+template <typename T, typename = int>
+constexpr int32_t tensor_device_v = 0;
+template <typename T>
+constexpr int32_t tensor_device_v<T, enable_if_t<T::is_device>> = T::value;
+
 template <typename... Ts> struct tensor_info {
     using scalar_type = void;
     using shape_type = void;
     constexpr static auto name = const_name("tensor");
     constexpr static tensor_framework framework = tensor_framework::none;
+    constexpr static char order = '\0';
 };
 
 template <typename T, typename... Ts> struct tensor_info<T, Ts...>  : tensor_info<Ts...> {
     using scalar_type =
-        std::conditional_t<std::is_scalar_v<T>, T,
+        std::conditional_t<std::is_scalar_v<T> || is_record_v<T>, T,
                            typename tensor_info<Ts...>::scalar_type>;
 };
 
@@ -193,6 +287,14 @@ template <size_t... Is, typename... Ts> struct tensor_info<shape<Is...>, Ts...>
     using shape_type = shape<Is...>;
 };
 
+template <typename... Ts> struct tensor_info<c_contig, Ts...> : tensor_info<Ts...> {
+    constexpr static char order = 'C';
+};
+
+template <typename... Ts> struct tensor_info<f_contig, Ts...> : tensor_info<Ts...> {
+    constexpr static char order = 'F';
+};
+
 template <typename... Ts> struct tensor_info<numpy, Ts...> : tensor_info<Ts...> {
     constexpr static auto name = const_name("numpy.ndarray");
     constexpr static tensor_framework framework = tensor_framework::numpy;
@@ -213,6 +315,116 @@ template <typename... Ts> struct tensor_info<jax, Ts...> : tensor_info<Ts...> {
     constexpr static tensor_framework framework = tensor_framework::jax;
 };
 
+template <typename Scalar, typename Shape, char Order> class tensor_view;
+
+/**
+ * \brief Typed accessor of a tensor returned by ``nb::tensor<...>::view()``
+ *
+ * Shape entries and strides that follow from the ``nb::shape<>`` and order
+ * annotations are compile-time constants, e.g. the innermost stride of a
+ * ``nb::c_contig`` tensor is always 1. The remaining values are copied into
+ * the view so that the compiler can keep them in registers.
+ */
+template <typename Scalar, size_t... Is, char Order>
+class tensor_view<Scalar, shape<Is...>, Order> {
+public:
+    static constexpr size_t Dims = sizeof...(Is);
+
+    /// Stride of dimension 'i' implied by the annotations, or 0 if unknown
+    static constexpr int64_t static_stride(size_t i) {
+        constexpr size_t fixed[] = { Is..., 0 };
+        if (Order != 'C' && Order != 'F')
+            return 0;
+        int64_t result = 1;
+        for (size_t j = 0; j < Dims; ++j) {
+            if (Order == 'C' ? (j <= i) : (j >= i))
+                continue;
+            if (fixed[j] == any)
+                return 0;
+            result *= (int64_t) fixed[j];
+        }
+        return result;
+    }
+
+    /// Extent of dimension 'i' implied by the annotations, or 'any'
+    static constexpr size_t static_shape(size_t i) {
+        constexpr size_t fixed[] = { Is..., 0 };
+        return fixed[i];
+    }
+
+    tensor_view() = default;
+
+    tensor_view(Scalar *data, const int64_t *shape, const int64_t *strides)
+        : m_data(data) {
+        for (size_t i = 0; i < Dims; ++i) {
+            m_shape[i] = (size_t) shape[i];
+            m_strides[i] = strides[i];
+        }
+    }
+
+    template <typename... Ts>
+    NB_INLINE Scalar &operator()(Ts... indices) const {
+        static_assert(sizeof...(Ts) == Dims,
+                      "nb::tensor_view::operator(): invalid number of arguments");
+        return m_data[offset(std::make_index_sequence<Dims>(), indices...)];
+    }
+
+    template <size_t I> NB_INLINE size_t shape() const {
+        if constexpr (static_shape(I) != any)
+            return static_shape(I);
+        else
+            return m_shape[I];
+    }
+
+    template <size_t I> NB_INLINE int64_t stride() const {
+        if constexpr (static_stride(I) != 0)
+            return static_stride(I);
+        else
+            return m_strides[I];
+    }
+
+    NB_INLINE size_t shape(size_t i) const {
+        return static_shape(i) != any ? static_shape(i) : m_shape[i];
+    }
+
+    NB_INLINE int64_t stride(size_t i) const {
+        return static_stride(i) != 0 ? static_stride(i) : m_strides[i];
+    }
+
+    NB_INLINE size_t ndim() const { return Dims; }
+
+    NB_INLINE size_t size() const {
+        return size_impl(std::make_index_sequence<Dims>());
+    }
+
+    NB_INLINE Scalar *data() const { return m_data; }
+
+    /// Iteration over the elements in memory order (contiguous tensors only)
+    NB_INLINE Scalar *begin() const {
+        static_assert(Order == 'C' || Order == 'F',
+                      "nb::tensor_view::begin(): requires a nb::c_contig or "
+                      "nb::f_contig annotation");
+        return m_data;
+    }
+
+    NB_INLINE Scalar *end() const { return begin() + size(); }
+
+private:
+    template <size_t... Js, typename... Ts>
+    NB_INLINE int64_t offset(std::index_sequence<Js...>, Ts... indices) const {
+        return (int64_t(0) + ... + (int64_t(indices) * stride<Js>()));
+    }
+
+    template <size_t... Js>
+    NB_INLINE size_t size_impl(std::index_sequence<Js...>) const {
+        return (size_t(1) * ... * shape<Js>());
+    }
+
+    Scalar *m_data = nullptr;
+    size_t m_shape[Dims ? Dims : 1] { };
+    int64_t m_strides[Dims ? Dims : 1] { };
+};
+
 NAMESPACE_END(detail)
 
 template <typename... Args> class tensor {
@@ -235,6 +447,20 @@ public:
            dlpack::dtype dtype = nanobind::dtype<Scalar>(),
            int32_t device_type = device::cpu::value,
            int32_t device_id = 0) {
+        // Tensors annotated with nb::f_contig default to Fortran-style strides
+        std::vector<int64_t> f_strides;
+        if constexpr (Info::order == 'F') {
+            if (!strides) {
+                f_strides.resize(ndim);
+                int64_t accum = 1;
+                for (size_t i = 0; i < ndim; ++i) {
+                    f_strides[i] = accum;
+                    accum *= (int64_t) shape[i];
+                }
+                strides = f_strides.data();
+            }
+        }
+
         m_handle =
             detail::tensor_create(value, ndim, shape, owner.ptr(), strides,
                                   &dtype, device_type, device_id);
@@ -245,6 +471,32 @@ public:
         detail::tensor_dec_ref(m_handle);
     }
 
+    /**
+     * \brief Create a contiguous CPU tensor of the given shape that owns
+     * uninitialized storage aligned to ``alignment`` (<= 256) bytes. Storage
+     * of up to 1 MiB is recycled across calls. The layout follows the
+     * ``nb::f_contig`` annotation if present and is C-contiguous otherwise.
+     */
+    static tensor allocate(std::initializer_list<size_t> shape,
+                           size_t alignment = 64) {
+        return allocate(shape.size(), shape.begin(), alignment);
+    }
+
+    static tensor allocate(size_t ndim, const size_t *shape,
+                           size_t alignment = 64) {
+        static_assert(
+            !std::is_same_v<Scalar, void>,
+            "nb::tensor::allocate() requires a scalar type annotation (e.g. "
+            "'float') in the tensor template parameters.");
+        static_assert(
+            ((detail::tensor_device_v<Args> == device::none::value ||
+              detail::tensor_device_v<Args> == device::cpu::value) && ...),
+            "nb::tensor::allocate() only creates CPU tensors.");
+        dlpack::dtype dt = nanobind::dtype<Scalar>();
+        return tensor(detail::tensor_allocate(ndim, shape, &dt, alignment,
+                                              Info::order == 'F' ? 'F' : 'C'));
+    }
+
     tensor(const tensor &t) : m_handle(t.m_handle), m_tensor(t.m_tensor) {
         detail::tensor_inc_ref(m_handle);
     }
@@ -300,9 +552,43 @@ public:
 
         int64_t counter = 0, index = 0;
         ((index += int64_t(indices) * m_tensor.strides[counter++]), ...);
-        return (typename Info::scalar_type &) *(
-            (uint8_t *) m_tensor.data + m_tensor.byte_offset +
-            index * sizeof(typename Info::scalar_type));
+        return *(Scalar *) ((uint8_t *) m_tensor.data + m_tensor.byte_offset +
+                            index * sizeof(Scalar));
+    }
+
+    /**
+     * \brief Return a typed accessor of the tensor data
+     *
+     * Shape entries and strides implied by the ``nb::shape<>`` and
+     * ``nb::c_contig``/``nb::f_contig`` annotations become compile-time
+     * constants, which lets the compiler vectorize loops over the view.
+     * Raises an exception if the dimension or strides of the tensor
+     * disagree with the annotations.
+     */
+    NB_INLINE auto view() const {
+        static_assert(
+            !std::is_same_v<typename Info::scalar_type, void>,
+            "To use nb::tensor::view(), you must add a scalar type "
+            "annotation (e.g. 'float') to the tensor template parameters.");
+        static_assert(
+            !std::is_same_v<typename Info::shape_type, void>,
+            "To use nb::tensor::view(), you must add a nb::shape<> "
+            "annotation to the tensor template parameters.");
+
+        using View = detail::tensor_view<Scalar, typename Info::shape_type,
+                                         Info::order>;
+
+        // Dimensions of size 1 can have arbitrary strides
+        bool valid = (size_t) m_tensor.ndim == View::Dims;
+        for (size_t i = 0; valid && i < View::Dims; ++i) {
+            int64_t s = View::static_stride(i);
+            valid = s == 0 || m_tensor.shape[i] <= 1 || m_tensor.strides[i] == s;
+        }
+        if (!valid)
+            detail::raise("nanobind::tensor::view(): the layout of the tensor "
+                          "does not match its annotations!");
+
+        return View((Scalar *) data(), m_tensor.shape, m_tensor.strides);
     }
 
 private:
@@ -330,9 +616,278 @@ template <typename... Args> struct type_caster<tensor<Args...>> {
 
     static handle from_cpp(const tensor<Args...> &tensor, rv_policy,
                            cleanup_list *) noexcept {
-        return tensor_wrap(tensor.handle(), int(Value::Info::framework));
+        using Scalar = typename Value::Scalar;
+        const std::type_info *record = nullptr;
+        if constexpr (is_record_v<Scalar>)
+            record = &typeid(std::remove_cv_t<Scalar>);
+        return tensor_wrap(tensor.handle(), int(Value::Info::framework),
+                           std::is_const_v<Scalar>, record);
+    }
+};
+
+/// Maximum number of dimensions supported by nb::vectorize()
+constexpr size_t vectorize_max_ndim = 32;
+
+/// Argument of a vectorized function: a scalar or a CPU tensor of scalars
+template <typename T> struct vectorize_arg {
+    tensor<T, device::cpu> array;
+    T scalar{};
+};
+
+template <typename T> struct type_caster<vectorize_arg<T>> {
+    using ScalarCaster = make_caster<T>;
+    using ArrayCaster = make_caster<tensor<T, device::cpu>>;
+
+    NB_TYPE_CASTER(vectorize_arg<T>, const_name("Union[") + ScalarCaster::Name +
+                                         const_name(", ") + ArrayCaster::Name +
+                                         const_name("]"));
+
+    bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        // Exact scalars first, then tensors, then implicitly converted scalars
+        ScalarCaster sc;
+        if (sc.from_python(src, flags & ~(uint8_t) cast_flags::convert, cleanup)) {
+            value.scalar = sc.value;
+            return true;
+        }
+
+        ArrayCaster ac;
+        if (ac.from_python(src, flags, cleanup)) {
+            value.array = std::move(ac.value);
+            return true;
+        }
+
+        if ((flags & (uint8_t) cast_flags::convert) &&
+            sc.from_python(src, flags, cleanup)) {
+            value.scalar = sc.value;
+            return true;
+        }
+
+        return false;
     }
 };
 
+template <typename Return, typename Func, typename... Args, size_t... Is>
+void vectorize_loop(const Func &func, Return *out, size_t ndim,
+                    const size_t *shape, const int64_t *strides,
+                    const uint8_t *const *base, std::index_sequence<Is...>) {
+    constexpr size_t N = sizeof...(Args);
+
+    size_t inner = ndim ? shape[ndim - 1] : 1, outer = 1;
+    for (size_t j = 0; j + 1 < ndim; ++j)
+        outer *= shape[j];
+    if (inner == 0)
+        return;
+
+    int64_t inner_stride[N];
+    for (size_t i = 0; i < N; ++i)
+        inner_stride[i] = ndim ? strides[i * vectorize_max_ndim + ndim - 1] : 0;
+
+    size_t index[vectorize_max_ndim] { };
+
+    for (size_t o = 0; o < outer; ++o) {
+        const uint8_t *ptr[N];
+        for (size_t i = 0; i < N; ++i) {
+            ptr[i] = base[i];
+            for (size_t j = 0; j + 1 < ndim; ++j)
+                ptr[i] += (int64_t) index[j] * strides[i * vectorize_max_ndim + j];
+        }
+
+        for (size_t k = 0; k < inner; ++k) {
+            *out++ = (Return) func(*(const Args *) ptr[Is]...);
+            ((ptr[Is] += inner_stride[Is]), ...);
+        }
+
+        // Advance the multi-index over all but the innermost dimension
+        for (size_t j = ndim ? ndim - 1 : 0; j-- > 0; ) {
+            if (++index[j] < shape[j])
+                break;
+            index[j] = 0;
+        }
+    }
+}
+
+template <typename... Ts, typename Func, typename Return, typename... Args,
+          size_t... Is>
+auto vectorize_impl(Func &&func, Return (*)(Args...),
+                    std::index_sequence<Is...>) {
+    static_assert(sizeof...(Args) > 0,
+                  "nb::vectorize(): the function must take at least one argument!");
+    static_assert((std::is_arithmetic_v<intrinsic_t<Args>> && ...) &&
+                      std::is_arithmetic_v<Return>,
+                  "nb::vectorize(): arguments and return value must be "
+                  "arithmetic types!");
+
+    return [func = (forward_t<Func>) func](vectorize_arg<intrinsic_t<Args>>... args) -> tensor<Ts..., Return> {
+        constexpr size_t N = sizeof...(Args);
+
+        tensor_handle *th[N] = { args.array.handle()... };
+        const size_t itemsize[N] = { sizeof(intrinsic_t<Args>)... };
+        size_t shape[vectorize_max_ndim];
+        int64_t strides[N * vectorize_max_ndim];
+        size_t ndim = tensor_broadcast(N, th, itemsize, shape, strides);
+
+        const uint8_t *base[N] = {
+            args.array.is_valid() ? (const uint8_t *) args.array.data()
+                                  : (const uint8_t *) &args.scalar...
+        };
+
+        size_t size = 1;
+        for (size_t j = 0; j < ndim; ++j)
+            size *= shape[j];
+
+        Return *out = new Return[size ? size : 1];
+        capsule owner(out, [](void *p) noexcept { delete[] (Return *) p; });
+
+        vectorize_loop<Return, std::remove_reference_t<Func>,
+                       intrinsic_t<Args>...>(func, out, ndim, shape, strides,
+                                             base,
+                                             std::index_sequence<Is...>());
+
+        return tensor<Ts..., Return>(out, ndim, shape, owner);
+    };
+}
+
 NAMESPACE_END(detail)
+
+/**
+ * \brief Wrap a scalar function so that it maps over tensors
+ *
+ * Each argument of the returned function accepts either a scalar or a CPU
+ * tensor (DLPack or buffer protocol). Tensor arguments are broadcast against
+ * each other following NumPy's rules, and the scalar function runs in a
+ * native loop over the result. Optional template arguments annotate the
+ * returned tensor, e.g. ``nb::vectorize<nb::numpy>(f)``.
+ */
+template <typename... Ts, typename Return, typename... Args>
+auto vectorize(Return (*f)(Args...)) {
+    return detail::vectorize_impl<Ts...>(
+        f, f, std::make_index_sequence<sizeof...(Args)>());
+}
+
+template <
+    typename... Ts, typename Func,
+    detail::enable_if_t<detail::is_lambda_v<std::remove_reference_t<Func>>> = 0>
+auto vectorize(Func &&f) {
+    using am = detail::analyze_method<decltype(&std::remove_reference_t<Func>::operator())>;
+    return detail::vectorize_impl<Ts...>(
+        (detail::forward_t<Func>) f, (typename am::func *) nullptr,
+        std::make_index_sequence<am::argc>());
+}
+
+/**
+ * \brief Move a ``std::vector`` into a one-dimensional tensor
+ *
+ * The vector is relocated to the heap and owned by a capsule that is released
+ * along with the tensor, so no element is copied or converted. Optional
+ * template arguments annotate the tensor, e.g.
+ * ``nb::tensor_from_vector<nb::numpy>(std::move(v))``. Besides arithmetic
+ * types, the elements can be records registered via nb::record_dtype().
+ */
+template <typename... Ts, typename T, typename Alloc>
+tensor<Ts..., T, shape<any>> tensor_from_vector(std::vector<T, Alloc> &&vec) {
+    static_assert((std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) ||
+                      detail::is_record_v<T>,
+                  "nanobind::tensor_from_vector(): T must be an arithmetic or "
+                  "record type!");
+
+    using Vector = std::vector<T, Alloc>;
+    std::unique_ptr<Vector> ptr(new Vector(std::move(vec)));
+    capsule owner(ptr.get(), [](void *p) noexcept { delete (Vector *) p; });
+    Vector *v = ptr.release();
+    size_t shape[1] = { v->size() };
+
+    return tensor<Ts..., T, nanobind::shape<any>>(v->data(), 1, shape, owner);
+}
+
+/**
+ * \brief Move a byte container into a read-only Python buffer object
+ *
+ * Accepts ``std::string``, ``std::vector<uint8_t>``, and other containers of
+ * single-byte elements with contiguous ``data()`` storage. As with
+ * nb::tensor_from_vector(), the container is relocated to the heap and owned
+ * by the returned object instead of being copied into a new ``bytes``
+ * instance. The object implements the buffer protocol, so that
+ * ``memoryview``, ``socket.send()``, ``numpy.frombuffer()``, etc. can access
+ * the payload without copying it.
+ */
+template <typename Container,
+          detail::enable_if_t<!std::is_lvalue_reference_v<Container>> = 0>
+object bytes_buffer(Container &&c) {
+    using Value = typename Container::value_type;
+    static_assert(sizeof(Value) == 1 && std::is_trivially_copyable_v<Value>,
+                  "nanobind::bytes_buffer(): the container must store bytes!");
+
+    std::unique_ptr<Container> ptr(new Container(std::move(c)));
+    capsule owner(ptr.get(), [](void *p) noexcept { delete (Container *) p; });
+    Container *p = ptr.release();
+
+    PyObject *o = detail::tensor_bytes_buffer(
+        (void *) p->data(), p->size(), owner.ptr());
+    if (!o)
+        detail::raise_python_error();
+    return steal(o);
+}
+
+NAMESPACE_BEGIN(detail)
+
+/// Field of a record type, see nb::record_dtype()
+struct record_field {
+    const char *name;
+    dlpack::dtype dtype;
+    size_t offset;
+    /// Shape of C array fields (0 = scalar field)
+    uint32_t ndim;
+    uint32_t shape[3];
+};
+
+NAMESPACE_END(detail)
+
+/// Describe a (potentially C array-valued) arithmetic field of a record type
+template <typename T, typename M>
+detail::record_field record_field(const char *name, M T::*member) {
+    using Base = std::remove_all_extents_t<M>;
+    static_assert(std::is_arithmetic_v<Base> && std::rank_v<M> <= 3,
+                  "nanobind::record_field(): the field must be an arithmetic "
+                  "value or a C array of such values with up to 3 dimensions!");
+
+    alignas(T) unsigned char storage[sizeof(T)];
+    const T *instance = (const T *) storage;
+
+    detail::record_field result { name, dtype<Base>(), 0, (uint32_t) std::rank_v<M>, { } };
+    result.offset = (size_t) ((const unsigned char *) &(instance->*member) - storage);
+
+    if constexpr (std::rank_v<M> >= 1)
+        result.shape[0] = (uint32_t) std::extent_v<M, 0>;
+    if constexpr (std::rank_v<M> >= 2)
+        result.shape[1] = (uint32_t) std::extent_v<M, 1>;
+    if constexpr (std::rank_v<M> >= 3)
+        result.shape[2] = (uint32_t) std::extent_v<M, 2>;
+
+    return result;
+}
+
+/**
+ * \brief Register the fields of a trivially copyable type ``T``
+ *
+ * Tensors of ``T`` (e.g. ``nb::tensor<nb::numpy, T, nb::shape<nb::any>>``)
+ * are then exported as structured arrays via the buffer protocol, whose
+ * fields reference the C++ memory. Fields that aren't registered are exposed
+ * as padding.
+ *
+ * \code
+ * NB_MAKE_RECORD(Particle) // at namespace scope
+ * ...
+ * nb::record_dtype<Particle>(nb::record_field("x", &Particle::x),
+ *                            nb::record_field("pos", &Particle::pos));
+ * \endcode
+ */
+template <typename T, typename... Fields>
+void record_dtype(const Fields &...fields) {
+    static_assert(detail::is_record_v<T>,
+                  "nanobind::record_dtype(): T must be declared as a record "
+                  "via NB_MAKE_RECORD()!");
+    const detail::record_field list[] = { fields..., { } };
+    detail::record_register(&typeid(T), sizeof(T), list, sizeof...(Fields));
+}
+
 NAMESPACE_END(NB_NAMESPACE)
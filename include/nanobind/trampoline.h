@@ -15,34 +15,39 @@
 NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
 
-NB_CORE void trampoline_new(void **data, size_t size, void *ptr,
-                            const std::type_info *cpp_type) noexcept;
-NB_CORE void trampoline_release(void **data, size_t size) noexcept;
+NB_CORE PyObject *trampoline_new(void *ptr,
+                                 const std::type_info *cpp_type) noexcept;
 
-NB_CORE PyObject *trampoline_lookup(void **data, size_t size, const char *name,
-                                    bool pure);
+NB_CORE PyObject *trampoline_lookup(PyObject *self, size_t size, size_t slot,
+                                    const char *name, bool pure);
 
 template <size_t Size> struct trampoline {
-    mutable void *data[2 * Size + 1];
+    PyObject *self;
 
-    NB_INLINE trampoline(void *ptr, const std::type_info *cpp_type) {
-        trampoline_new(data, Size, ptr, cpp_type);
-    }
-
-    NB_INLINE ~trampoline() { trampoline_release(data, Size); }
+    NB_INLINE trampoline(void *ptr, const std::type_info *cpp_type)
+        : self(trampoline_new(ptr, cpp_type)) { }
 
-    NB_INLINE handle lookup(const char *name, bool pure) const {
-        return trampoline_lookup(data, Size, name, pure);
+    NB_INLINE handle lookup(size_t slot, const char *name, bool pure) const {
+        return trampoline_lookup(self, Size, slot, name, pure);
     }
 
-    NB_INLINE handle base() const { return (PyObject *) data[0]; }
+    NB_INLINE handle base() const { return self; }
 };
 
+/* Each NB_OVERRIDE_*() site receives a compile-time slot index relative to
+   the NB_TRAMPOLINE() declaration, which indexes the per-type cache directly.
+   The index is only a hint: a site that falls outside of the range (e.g., one
+   defined out of line) is resolved by name. */
 #define NB_TRAMPOLINE(base, size)                                              \
+    enum { nb_trampoline_slot_base = __COUNTER__ + 1 };                        \
     nanobind::detail::trampoline<size> trampoline{ this, &typeid(base) };
 
+#define NB_TRAMPOLINE_SLOT                                                     \
+    ((size_t) (__COUNTER__ - (int) nb_trampoline_slot_base))
+
 #define NB_OVERRIDE_NAME(ret_type, base_type, name, func, ...)                 \
-    nanobind::handle key = trampoline.lookup(name, false);                     \
+    nanobind::handle key =                                                     \
+        trampoline.lookup(NB_TRAMPOLINE_SLOT, name, false);                    \
     if (key.is_valid()) {                                                      \
         nanobind::gil_scoped_acquire guard;                                    \
         return nanobind::cast<ret_type>(                                       \
@@ -52,7 +57,8 @@ template <size_t Size> struct trampoline {
     }
 
 #define NB_OVERRIDE_PURE_NAME(ret_type, base_type, name, func, ...)            \
-    nanobind::handle key = trampoline.lookup(name, true);                      \
+    nanobind::handle key =                                                     \
+        trampoline.lookup(NB_TRAMPOLINE_SLOT, name, true);                     \
     nanobind::gil_scoped_acquire guard;                                        \
     return nanobind::cast<ret_type>(trampoline.base().attr(key)(__VA_ARGS__));
 
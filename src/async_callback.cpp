@@ -0,0 +1,308 @@
+/*
+    src/async_callback.cpp: queue of calls issued via nb::async_callback<>
+
+    Copyright (c) 2022 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#include <nanobind/async_callback.h>
+#include "nb_internals.h"
+#include <condition_variable>
+#include <mutex>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+/**
+ * Calls queued by nb::async_callback<>. Each interpreter has its own queue,
+ * which is referenced by the interpreter's internals, by every async_handle,
+ * and by scheduled pending calls. The queue therefore outlives the
+ * interpreter when worker threads still hold callbacks at shutdown: from
+ * then on ('alive' is cleared), further calls are discarded and callables
+ * are leaked without touching Python.
+ */
+struct async_queue {
+    /// Lock-free stack of queued calls (most recent call first)
+    std::atomic<async_call *> head { nullptr };
+
+    /// Has a drain been requested since the last one?
+    std::atomic<bool> scheduled { false };
+
+    /// Interpreter that owns the queue
+    PyInterpreterState *interp;
+    bool is_main;
+
+    /// Protects the fields below
+    std::mutex mutex;
+    std::condition_variable done;
+    size_t refs = 1;
+    size_t active = 0; ///< Threads that currently use the interpreter
+    bool alive = true;
+};
+
+/// Drop a reference to 'q'
+static void async_queue_release(async_queue *q) noexcept {
+    bool last;
+    {
+        std::lock_guard<std::mutex> guard(q->mutex);
+        last = --q->refs == 0;
+    }
+    if (last)
+        delete q;
+}
+
+/// Mark the calling thread as a user of the queue's interpreter (if it's alive)
+static bool async_enter(async_queue *q) noexcept {
+    std::lock_guard<std::mutex> guard(q->mutex);
+    if (!q->alive)
+        return false;
+    q->active++;
+    return true;
+}
+
+static void async_leave(async_queue *q) noexcept {
+    std::lock_guard<std::mutex> guard(q->mutex);
+    if (--q->active == 0 && !q->alive)
+        q->done.notify_all();
+}
+
+/**
+ * Queued calls form a lock-free stack (most recent call first): producers push
+ * entries using a CAS loop, and async_drain_queue() detaches the entire list
+ * with a single exchange before reversing it.
+ *
+ * The consumer clears 'scheduled' before detaching the list, and producers
+ * set it after pushing. Sequentially consistent ordering of these four
+ * operations ensures that a call pushed after the detach observes the
+ * cleared flag and schedules another drain.
+ */
+static size_t async_drain_queue(async_queue &q) noexcept {
+    // Calls queued from now on schedule another drain
+    q.scheduled.store(false, std::memory_order_seq_cst);
+
+    async_call *list = q.head.exchange(nullptr, std::memory_order_seq_cst),
+               *prev = nullptr;
+
+    while (list) {
+        async_call *next = list->next;
+        list->next = prev;
+        prev = list;
+        list = next;
+    }
+
+    size_t count = 0;
+    for (async_call *call = prev; call; ++count) {
+        async_call *next = call->next;
+
+        try {
+            call->func(call, true);
+        } catch (python_error &e) {
+            e.restore();
+            PyErr_WriteUnraisable(nullptr);
+        } catch (...) {
+            nb_func_convert_cpp_exception();
+            PyErr_WriteUnraisable(nullptr);
+        }
+
+        call = next;
+    }
+
+    return count;
+}
+
+/// Run 'func' from a thread that may not hold the GIL of the queue's
+/// interpreter (async_enter() must have succeeded)
+template <typename Func>
+static void async_attach(async_queue &q, Func func) noexcept {
+#if !defined(Py_LIMITED_API)
+    PyThreadState *current = tstate_attached();
+    if (current && PyThreadState_GetInterpreter(current) == q.interp) {
+        func();
+        return;
+    }
+
+    // Temporarily detach from the other interpreter
+    if (current)
+        PyEval_SaveThread();
+
+    PyThreadState *ts = PyThreadState_New(q.interp);
+    PyEval_RestoreThread(ts);
+    func();
+    PyThreadState_Clear(ts);
+    PyEval_SaveThread();
+    PyThreadState_Delete(ts);
+
+    if (current)
+        PyEval_RestoreThread(current);
+#else
+    /* The stable ABI can't tell if the calling thread holds the GIL and only
+       supports the main interpreter here */
+    (void) q;
+    PyGILState_STATE state = PyGILState_Ensure();
+    func();
+    PyGILState_Release(state);
+#endif
+}
+
+static int async_pending(void *arg) {
+    async_queue *q = (async_queue *) arg;
+
+    if (async_enter(q)) {
+#if !defined(Py_LIMITED_API)
+        // Before Python 3.12, pending calls may run in another interpreter
+        if (interp_get() != q->interp)
+            async_attach(*q, [q] { async_drain_queue(*q); });
+        else
+#endif
+            async_drain_queue(*q);
+        async_leave(q);
+    }
+
+    // Drop the reference held by the pending call
+    async_queue_release(q);
+    return 0;
+}
+
+/// atexit() handler: run the remaining calls and disable further ones
+static PyObject *async_shutdown(PyObject *, PyObject *) {
+    nb_internals &internals = internals_get();
+    async_queue *q = internals.async_calls;
+    if (!q)
+        Py_RETURN_NONE;
+    internals.async_calls = nullptr;
+
+    Py_BEGIN_ALLOW_THREADS
+    std::unique_lock<std::mutex> lock(q->mutex);
+    q->alive = false;
+    q->done.wait(lock, [q] { return q->active == 0; });
+    Py_END_ALLOW_THREADS
+
+    // No further calls can be queued at this point
+    async_drain_queue(*q);
+    async_queue_release(q);
+
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef async_shutdown_def = {
+    "async_shutdown", (PyCFunction) async_shutdown, METH_NOARGS, nullptr
+};
+
+void async_queue_shutdown(nb_internals &internals) noexcept {
+    async_queue *q = internals.async_calls;
+    if (!q)
+        return;
+    internals.async_calls = nullptr;
+
+    // The atexit() handler didn't run, discard calls from now on
+    {
+        std::lock_guard<std::mutex> guard(q->mutex);
+        q->alive = false;
+    }
+    async_queue_release(q);
+}
+
+async_queue *async_queue_get() noexcept {
+    nb_internals &internals = internals_get();
+    async_queue *q = internals.async_calls;
+
+    if (!q) {
+        PyObject *atexit = PyImport_ImportModule("atexit"),
+                 *func = PyCFunction_New(&async_shutdown_def, nullptr),
+                 *rv = nullptr;
+        if (atexit && func)
+            rv = PyObject_CallMethod(atexit, "register", "O", func);
+        Py_XDECREF(atexit);
+        Py_XDECREF(func);
+
+        // Without the handler, async_queue_shutdown() disables the queue
+        if (rv)
+            Py_DECREF(rv);
+        else
+            PyErr_Clear();
+
+        q = new async_queue();
+        q->interp = interp_get();
+#if defined(Py_LIMITED_API)
+        q->is_main = true;
+#else
+        q->is_main = q->interp == PyInterpreterState_Main();
+#endif
+        internals.async_calls = q;
+    }
+
+    std::lock_guard<std::mutex> guard(q->mutex);
+    q->refs++;
+    return q;
+}
+
+/// Request a drain of 'q', which must be entered via async_enter()
+static void async_schedule(async_queue *q) noexcept {
+    /* CPython only runs pending calls in the main interpreter, hence the
+       queues of sub-interpreters are drained by this thread. The same
+       happens when CPython's queue of pending calls is full. */
+    if (q->is_main) {
+        {
+            std::lock_guard<std::mutex> guard(q->mutex);
+            q->refs++;
+        }
+
+        if (Py_AddPendingCall(async_pending, q) == 0)
+            return;
+
+        async_queue_release(q);
+    }
+
+    async_attach(*q, [q] { async_drain_queue(*q); });
+}
+
+void async_push(async_queue *q, async_call *call) noexcept {
+    if (!async_enter(q)) {
+        // The interpreter is shutting down, discard the call
+        call->func(call, false);
+        return;
+    }
+
+    async_call *head = q->head.load(std::memory_order_relaxed);
+    do {
+        call->next = head;
+    } while (!q->head.compare_exchange_weak(head, call,
+                                            std::memory_order_seq_cst,
+                                            std::memory_order_relaxed));
+
+    // Schedule a drain of the queue unless this is already pending
+    if (!q->scheduled.exchange(true, std::memory_order_seq_cst))
+        async_schedule(q);
+
+    async_leave(q);
+}
+
+void async_release(async_queue *q, PyObject *o) noexcept {
+    // After shutdown, the reference is leaked
+    if (async_enter(q)) {
+        async_attach(*q, [o] { Py_DECREF(o); });
+        async_leave(q);
+    }
+
+    async_queue_release(q);
+}
+
+size_t async_drain() noexcept {
+    async_queue *q = internals_get().async_calls;
+    return q ? async_drain_queue(*q) : 0;
+}
+
+static PyObject *async_drain_py(PyObject *, PyObject *) {
+    return PyLong_FromSize_t(async_drain());
+}
+
+PyMethodDef async_methods[] = {
+    { "drain_callbacks", async_drain_py, METH_NOARGS,
+      "Run the queued calls of asynchronous callbacks and return their number" },
+    { nullptr, nullptr, 0, nullptr }
+};
+
+NAMESPACE_END(detail)
+NAMESPACE_END(NB_NAMESPACE)
@@ -93,7 +93,7 @@ void cleanup_list::release() noexcept {
        element, it stores the 'self' element. */
     for (size_t i = 1; i < m_size; ++i)
         Py_DECREF(m_data[i]);
-    if (m_capacity != Small)
+    if (m_data != m_storage)
         free(m_data);
     m_data = nullptr;
 }
@@ -104,7 +104,7 @@ void cleanup_list::expand() noexcept {
     if (!new_data)
         fail("nanobind::detail::cleanup_list::expand(): out of memory!");
     memcpy(new_data, m_data, m_size * sizeof(PyObject *));
-    if (m_capacity != Small)
+    if (m_data != m_storage)
         free(m_data);
     m_data = new_data;
     m_capacity = new_capacity;
@@ -112,14 +112,58 @@ void cleanup_list::expand() noexcept {
 
 // ========================================================================
 
-PyObject *module_new(const char *name, PyModuleDef *def) noexcept {
+/// Forget the module instance registered by module_reuse()
+static void module_free(void *p) {
+    PyObject *m = (PyObject *) p;
+    nb_internals *internals = internals_peek();
+    if (!internals)
+        return;
+
+    auto it = internals->modules.find(PyModule_GetDef(m));
+    if (it != internals->modules.end() && it->second == m)
+        internals->modules.erase(it);
+}
+
+PyObject *module_new(const char *name, PyModuleDef *def,
+                     PyModuleDef_Slot *slots,
+                     int (*exec)(PyObject *)) noexcept {
     memset(def, 0, sizeof(PyModuleDef));
+    memset(slots, 0, sizeof(PyModuleDef_Slot) * 3);
+
+    slots[0].slot = Py_mod_exec;
+    slots[0].value = (void *) exec;
+#if PY_VERSION_HEX >= 0x030C0000 &&                                            \
+    (!defined(Py_LIMITED_API) || Py_LIMITED_API >= 0x030C0000)
+    // State is kept per interpreter, see internals_get()
+    slots[1].slot = Py_mod_multiple_interpreters;
+    slots[1].value = Py_MOD_PER_INTERPRETER_GIL_SUPPORTED;
+#endif
+
+    def->m_base = PyModuleDef_HEAD_INIT;
     def->m_name = name;
-    def->m_size = -1;
-    PyObject *m = PyModule_Create(def);
-    if (!m)
-        fail("nanobind::detail::module_new(): allocation failed!");
-    return m;
+    def->m_size = 0;
+    def->m_slots = slots;
+    def->m_free = module_free;
+
+    return PyModuleDef_Init(def);
+}
+
+bool module_reuse(PyObject *m, PyModuleDef *def) noexcept {
+    nb_internals &internals = internals_get();
+
+    /* Importing the module again (e.g., after removing it from 'sys.modules')
+       must not register its bindings a second time. Share them instead, like
+       CPython does for extensions using single-phase initialization. */
+    auto [it, success] = internals.modules.try_emplace(def, m);
+    if (success)
+        return false;
+
+    if (PyDict_Merge(PyModule_GetDict(m), PyModule_GetDict(it->second), 0))
+        fail("nanobind::detail::module_reuse(): could not copy the contents "
+             "of module \"%s\"!", def->m_name);
+    it.value() = m;
+
+    return true;
 }
 
 PyObject *module_import(const char *name) {
@@ -295,6 +339,31 @@ end:
     return res;
 }
 
+PyObject *bound_call_resolve(PyObject *self, const char *name,
+                             PyObject **self_out) {
+    PyObject *attr = getattr(self, name), *func = nullptr;
+    *self_out = nullptr;
+
+    if (Py_TYPE(attr) == internals_get().nb_bound_method) {
+        nb_bound_method *mb = (nb_bound_method *) attr;
+        func = (PyObject *) mb->func;
+        *self_out = mb->self;
+    }
+#if !defined(Py_LIMITED_API)
+    else if (PyMethod_Check(attr)) {
+        func = PyMethod_GET_FUNCTION(attr);
+        *self_out = PyMethod_GET_SELF(attr);
+    }
+#endif
+
+    if (!func)
+        return attr;
+
+    Py_INCREF(func);
+    Py_INCREF(*self_out);
+    Py_DECREF(attr);
+    return func;
+}
 
 PyObject *obj_iter(PyObject *o) {
     PyObject *result = PyObject_GetIter(o);
@@ -455,20 +524,144 @@ PyObject *str_from_obj(PyObject *o) {
     return result;
 }
 
+PyObject *str_from_utf8(const char *str, size_t size) noexcept {
+#if !defined(Py_LIMITED_API)
+    /* Check for pure ASCII input (8 bytes at a time), which permits creating
+       a compact string object straight from the bytes */
+    uint64_t bits = 0;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t chunk;
+        memcpy(&chunk, str + i, 8);
+        bits |= chunk;
+    }
+    for (; i < size; ++i)
+        bits |= (uint8_t) str[i];
+
+    if ((bits & 0x8080808080808080ull) == 0) {
+        PyObject *result = PyUnicode_New((Py_ssize_t) size, 127);
+        if (result)
+            memcpy(PyUnicode_1BYTE_DATA(result), str, size);
+        return result;
+    }
+#endif
+
+    return PyUnicode_FromStringAndSize(str, (Py_ssize_t) size);
+}
+
 PyObject *str_from_cstr(const char *str) {
-    PyObject *result = PyUnicode_FromString(str);
+    PyObject *result = str_from_utf8(str, strlen(str));
     if (!result)
         raise("nanobind::detail::str_from_cstr(): conversion error!");
     return result;
 }
 
 PyObject *str_from_cstr_and_size(const char *str, size_t size) {
-    PyObject *result = PyUnicode_FromStringAndSize(str, (Py_ssize_t) size);
+    PyObject *result = str_from_utf8(str, size);
     if (!result)
         raise("nanobind::detail::str_from_cstr_and_size(): conversion error!");
     return result;
 }
 
+PyObject *str_intern(const char *str, size_t size) noexcept {
+    if (size > NB_STR_CACHE_MAX_LEN)
+        return str_from_utf8(str, size);
+
+    // FNV-1a hash of the string contents
+    size_t hash = (size_t) 14695981039346656037ull;
+    for (size_t i = 0; i < size; ++i)
+        hash = (hash ^ (uint8_t) str[i]) * (size_t) 1099511628211ull;
+
+    nb_internals &internals = internals_get();
+    str_cache_entry &e = internals.str_cache[hash & (NB_STR_CACHE_SIZE - 1)];
+
+    /* In free-threaded builds, the slot is guarded by a shard mutex, which
+       is only held while reading or replacing the slot's contents */
+    nb_shard &shard = internals.shard(&e);
+    PyObject *cached = nullptr;
+
+    {
+        nb_lock_guard guard(shard.mutex);
+        if (e.str && e.hash == hash) {
+            cached = e.str;
+            Py_INCREF(cached);
+        }
+    }
+
+    if (cached) {
+        Py_ssize_t size_2;
+        const char *str_2 = PyUnicode_AsUTF8AndSize(cached, &size_2);
+        if (str_2 && (size_t) size_2 == size && memcmp(str, str_2, size) == 0)
+            return cached;
+        PyErr_Clear();
+        Py_DECREF(cached);
+    }
+
+    PyObject *result = str_from_utf8(str, size);
+    if (!result)
+        return nullptr;
+
+    // Evict the previous occupant of the slot
+    PyObject *prev;
+    Py_INCREF(result);
+    {
+        nb_lock_guard guard(shard.mutex);
+        prev = e.str;
+        e.str = result;
+        e.hash = hash;
+    }
+    Py_XDECREF(prev);
+
+    return result;
+}
+
+size_t str_intern_site() noexcept {
+    static std::atomic<size_t> sites { 0 };
+    return sites.fetch_add(1, std::memory_order_relaxed);
+}
+
+PyObject *str_intern_permanent(size_t site, const char *str) {
+    // Each interpreter has its own strings (sub-interpreters may not share them)
+    nb_internals &internals = internals_get();
+    std::vector<PyObject *> &strings = internals.interned.get();
+    if (site < strings.size() && strings[site])
+        return strings[site];
+
+    PyObject *result = PyUnicode_InternFromString(str);
+    if (!result)
+        raise_python_error();
+
+    // Cache the hash within the string object
+    if (PyObject_Hash(result) == -1) {
+        Py_DECREF(result);
+        raise_python_error();
+    }
+
+    PyObject *stored = result;
+    internals.interned.update([&](std::vector<PyObject *> &v) {
+        if (v.size() <= site)
+            v.resize(site + 1, nullptr);
+        if (v[site])
+            stored = v[site]; // another thread was faster
+        else
+            v[site] = result;
+    });
+
+    if (stored != result)
+        Py_DECREF(result);
+
+    return stored;
+}
+
+PyObject *dict_new_presized(size_t size) noexcept {
+#if !defined(Py_LIMITED_API) && PY_VERSION_HEX < 0x030D0000
+    return _PyDict_NewPresized((Py_ssize_t) size);
+#else
+    (void) size;
+    return PyDict_New();
+#endif
+}
+
 // ========================================================================
 
 PyObject *bytes_from_obj(PyObject *o) {
@@ -494,7 +687,107 @@ PyObject *bytes_from_cstr_and_size(const char *str, size_t size) {
 
 // ========================================================================
 
-PyObject **seq_get(PyObject *seq, size_t *size_out, PyObject **temp_out) noexcept {
+#if defined(Py_LIMITED_API)
+/* There isn't a way to get a PyObject** in Py_LIMITED_API. The functions
+   below instead copy borrowed references from an exact tuple or list, or
+   from a tuple created from other sequences, into caller-provided storage
+   (short sequences) or a heap-allocated array owned by a capsule. */
+
+static PyObject *seq_array_new(PyObject *owner, size_t size,
+                               PyObject ***out) noexcept {
+    PyObject **ptr =
+        (PyObject **) PyObject_Malloc(sizeof(PyObject *) * (size + 1));
+    if (!ptr)
+        return nullptr;
+
+    PyObject *capsule = PyCapsule_New(ptr, nullptr, [](PyObject *o) {
+        PyObject **ptr = (PyObject **) PyCapsule_GetPointer(o, nullptr);
+        Py_XDECREF(ptr[0]);
+        PyObject_Free(ptr);
+    });
+
+    if (!capsule) {
+        PyErr_Clear();
+        PyObject_Free(ptr);
+        return nullptr;
+    }
+
+    // Keep the tuple created by seq_fetch() alive along with the array
+    ptr[0] = owner;
+    Py_XINCREF(owner);
+    *out = ptr + 1;
+    return capsule;
+}
+
+static PyObject **seq_fetch(PyObject *seq, size_t size_req, size_t *size_out,
+                            PyObject **temp_out, PyObject **storage,
+                            size_t capacity) noexcept {
+    PyObject *owner = nullptr, *temp = nullptr, **result = nullptr;
+    bool is_tuple = PyTuple_CheckExact(seq);
+    Py_ssize_t size = -1;
+
+    if (!is_tuple && !PyList_CheckExact(seq)) {
+        if (!PySequence_Check(seq))
+            goto done;
+
+        // Check the length first to avoid copying sequences of the wrong size
+        if (size_req != (size_t) -1 &&
+            PySequence_Length(seq) != (Py_ssize_t) size_req) {
+            PyErr_Clear();
+            goto done;
+        }
+
+        owner = PySequence_Tuple(seq);
+        if (!owner) {
+            PyErr_Clear();
+            goto done;
+        }
+        seq = owner;
+        is_tuple = true;
+    }
+
+    size = is_tuple ? PyTuple_Size(seq) : PyList_Size(seq);
+    if (size < 0 || (size_req != (size_t) -1 && (size_t) size != size_req)) {
+        PyErr_Clear();
+        goto done;
+    }
+
+    if ((size_t) size <= capacity) {
+        result = storage;
+        temp = owner;
+        owner = nullptr;
+    } else {
+        temp = seq_array_new(owner, (size_t) size, &result);
+        if (!temp)
+            goto done;
+    }
+
+    for (Py_ssize_t i = 0; i < size; ++i) {
+        PyObject *o =
+            is_tuple ? PyTuple_GetItem(seq, i) : PyList_GetItem(seq, i);
+        if (!o) {
+            PyErr_Clear();
+            Py_CLEAR(temp);
+            result = nullptr;
+            goto done;
+        }
+        result[i] = o;
+    }
+
+    // See the comment about zero-sized sequences below
+    if (size == 0)
+        result = (PyObject **) 1;
+
+done:
+    Py_XDECREF(owner);
+    *temp_out = temp;
+    *size_out = result ? (size_t) size : 0;
+    return result;
+}
+#endif
+
+PyObject **seq_get(PyObject *seq, size_t *size_out, PyObject **temp_out,
+                   PyObject **storage, size_t capacity) noexcept {
     PyObject *temp = nullptr;
     size_t size = 0;
     PyObject **result = nullptr;
@@ -504,6 +797,8 @@ PyObject **seq_get(PyObject *seq, size_t *size_out, PyObject **temp_out) noexcep
        overloads will then be tried. */
 
 #if !defined(Py_LIMITED_API)
+    (void) storage; (void) capacity;
+
     if (PyTuple_CheckExact(seq)) {
         size = (size_t) PyTuple_GET_SIZE(seq);
         result = ((PyTupleObject *) seq)->ob_item;
@@ -522,62 +817,12 @@ PyObject **seq_get(PyObject *seq, size_t *size_out, PyObject **temp_out) noexcep
         temp = PySequence_Fast(seq, "");
 
         if (temp)
-            result = seq_get(temp, &size, temp_out);
+            result = seq_get(temp, &size, temp_out, nullptr, 0);
         else
             PyErr_Clear();
     }
 #else
-    /* There isn't a nice way to get a PyObject** in Py_LIMITED_API. This
-       is going to be slow, but hopefully also very future-proof.. */
-    if (PySequence_Check(seq)) {
-        Py_ssize_t size_seq = PySequence_Length(seq);
-
-        if (size_seq >= 0) {
-            result = (PyObject **) PyObject_Malloc(sizeof(PyObject *) *
-                                                   (size_seq + 1));
-
-            if (result) {
-                result[size_seq] = nullptr;
-
-                for (Py_ssize_t i = 0; i < size_seq; ++i) {
-                    PyObject *o = PySequence_GetItem(seq, i);
-
-                    if (o) {
-                        result[i] = o;
-                    } else {
-                        for (Py_ssize_t j = 0; j < i; ++j)
-                            Py_DECREF(result[j]);
-
-                        PyObject_Free(result);
-                        result = nullptr;
-                        break;
-                    }
-                }
-            }
-
-            if (result) {
-                temp = PyCapsule_New(result, nullptr, [](PyObject *o) {
-                    PyObject **ptr = (PyObject **) PyCapsule_GetPointer(o, nullptr);
-                    for (size_t i = 0; ptr[i] != nullptr; ++i)
-                        Py_DECREF(ptr[i]);
-                    PyObject_Free(ptr);
-                });
-
-                if (temp) {
-                    size = (size_t) size_seq;
-                } else if (!temp) {
-                    PyErr_Clear();
-                    for (Py_ssize_t i = 0; i < size_seq; ++i)
-                        Py_DECREF(result[i]);
-
-                    PyObject_Free(result);
-                    result = nullptr;
-                }
-            }
-        } else if (size_seq < 0) {
-            PyErr_Clear();
-        }
-    }
+    result = seq_fetch(seq, (size_t) -1, &size, &temp, storage, capacity);
 #endif
 
     *temp_out = temp;
@@ -586,8 +831,8 @@ PyObject **seq_get(PyObject *seq, size_t *size_out, PyObject **temp_out) noexcep
 }
 
 
-PyObject **seq_get_with_size(PyObject *seq, size_t size,
-                             PyObject **temp_out) noexcept {
+PyObject **seq_get_with_size(PyObject *seq, size_t size, PyObject **temp_out,
+                             PyObject **storage) noexcept {
 
     /* This function is used during overload resolution; if anything
        goes wrong, it fails gracefully without reporting errors. Other
@@ -597,6 +842,8 @@ PyObject **seq_get_with_size(PyObject *seq, size_t size,
              **result = nullptr;
 
 #if !defined(Py_LIMITED_API)
+    (void) storage;
+
     if (PyTuple_CheckExact(seq)) {
         if (size == (size_t) PyTuple_GET_SIZE(seq)) {
             result = ((PyTupleObject *) seq)->ob_item;
@@ -617,60 +864,13 @@ PyObject **seq_get_with_size(PyObject *seq, size_t size,
         temp = PySequence_Fast(seq, "");
 
         if (temp)
-            result = seq_get_with_size(temp, size, temp_out);
+            result = seq_get_with_size(temp, size, temp_out, nullptr);
         else
             PyErr_Clear();
     }
 #else
-    /* There isn't a nice way to get a PyObject** in Py_LIMITED_API. This
-       is going to be slow, but hopefully also very future-proof.. */
-    if (PySequence_Check(seq)) {
-        Py_ssize_t size_seq = PySequence_Length(seq);
-
-        if (size == (size_t) size_seq) {
-            result =
-                (PyObject **) PyObject_Malloc(sizeof(PyObject *) * (size + 1));
-
-            if (result) {
-                result[size] = nullptr;
-
-                for (Py_ssize_t i = 0; i < size_seq; ++i) {
-                    PyObject *o = PySequence_GetItem(seq, i);
-
-                    if (o) {
-                        result[i] = o;
-                    } else {
-                        for (Py_ssize_t j = 0; j < i; ++j)
-                            Py_DECREF(result[j]);
-
-                        PyObject_Free(result);
-                        result = nullptr;
-                        break;
-                    }
-                }
-            }
-
-            if (result) {
-                temp = PyCapsule_New(result, nullptr, [](PyObject *o) {
-                    PyObject **ptr = (PyObject **) PyCapsule_GetPointer(o, nullptr);
-                    for (size_t i = 0; ptr[i] != nullptr; ++i)
-                        Py_DECREF(ptr[i]);
-                    PyObject_Free(ptr);
-                });
-
-                if (!temp) {
-                    PyErr_Clear();
-                    for (Py_ssize_t i = 0; i < size_seq; ++i)
-                        Py_DECREF(result[i]);
-
-                    PyObject_Free(result);
-                    result = nullptr;
-                }
-            }
-        } else if (size_seq < 0) {
-            PyErr_Clear();
-        }
-    }
+    size_t size_out;
+    result = seq_fetch(seq, size, &size_out, &temp, storage, size);
 #endif
 
     *temp_out = temp;
@@ -703,6 +903,188 @@ void property_install(PyObject *scope, const char *name, bool is_static,
     );
 }
 
+/// Report an access to an uninitialized instance like nb_type_get() + dispatch
+static NB_NOINLINE void nb_field_uninitialized(PyObject *self,
+                                               const field_data *f) noexcept {
+    const char *name = nb_type_data(Py_TYPE(self))->name;
+    if (PyErr_WarnFormat(PyExc_RuntimeWarning, 1,
+                         "nanobind: attempted to access an uninitialized "
+                         "instance of type '%s'!\n", name) == 0)
+        PyErr_Format(PyExc_TypeError,
+                     "%s(): incompatible function arguments (the instance of "
+                     "type '%s' is uninitialized)!", f->name, name);
+}
+
+static PyObject *nb_field_get(PyObject *self, void *closure) {
+    const field_data *f = (const field_data *) closure;
+    nb_inst *inst = (nb_inst *) self;
+
+    if (!inst->ready)
+        return nb_field_uninitialized(self, f), nullptr;
+
+    void *p = (uint8_t *) inst_ptr(inst) + f->offset;
+
+    switch (f->kind) {
+        case field_kind::bool_: {
+            PyObject *result = *(bool *) p ? Py_True : Py_False;
+            Py_INCREF(result);
+            return result;
+        }
+
+        case field_kind::int_:
+            switch (f->size) {
+                case 1: return PyLong_FromLong(*(int8_t *) p);
+                case 2: return PyLong_FromLong(*(int16_t *) p);
+                case 4: return PyLong_FromLong(*(int32_t *) p);
+                default: return PyLong_FromLongLong(*(int64_t *) p);
+            }
+
+        case field_kind::uint_:
+            switch (f->size) {
+                case 1: return PyLong_FromUnsignedLong(*(uint8_t *) p);
+                case 2: return PyLong_FromUnsignedLong(*(uint16_t *) p);
+                case 4: return PyLong_FromUnsignedLong(*(uint32_t *) p);
+                default: return PyLong_FromUnsignedLongLong(*(uint64_t *) p);
+            }
+
+        case field_kind::float_:
+            return PyFloat_FromDouble(f->size == 4 ? (double) *(float *) p
+                                                   : *(double *) p);
+
+        default: {
+            cleanup_list cleanup(self);
+            PyObject *result = nb_type_put(
+                f->type, p, rv_policy::reference_internal, &cleanup, nullptr);
+            if (!result && !PyErr_Occurred()) {
+                char *name = type_name(f->type);
+                PyErr_Format(PyExc_TypeError,
+                             "%s: unable to convert the C++ type '%s'!",
+                             f->name, name);
+                free(name);
+            }
+            return result;
+        }
+    }
+}
+
+static int nb_field_set(PyObject *self, PyObject *value, void *closure) {
+    const field_data *f = (const field_data *) closure;
+    nb_inst *inst = (nb_inst *) self;
+
+    if (!value) {
+        PyErr_Format(PyExc_AttributeError, "%s: cannot delete attribute!",
+                     f->name);
+        return -1;
+    }
+
+    if (!inst->ready)
+        return nb_field_uninitialized(self, f), -1;
+
+    void *p = (uint8_t *) inst_ptr(inst) + f->offset;
+    uint8_t flags = (uint8_t) cast_flags::convert;
+    bool success;
+
+    switch (f->kind) {
+        case field_kind::bool_:
+            success = value == Py_True || value == Py_False;
+            if (success)
+                *(bool *) p = value == Py_True;
+            break;
+
+#define NB_FIELD_STORE(T, load)                        \
+        {                                              \
+            std::pair<T, bool> r = load(value, flags); \
+            success = r.second;                        \
+            if (success)                               \
+                *(T *) p = r.first;                    \
+        }
+
+        case field_kind::int_:
+            switch (f->size) {
+                case 1: NB_FIELD_STORE(int8_t, load_i8) break;
+                case 2: NB_FIELD_STORE(int16_t, load_i16) break;
+                case 4: NB_FIELD_STORE(int32_t, load_i32) break;
+                default: NB_FIELD_STORE(int64_t, load_i64) break;
+            }
+            break;
+
+        case field_kind::uint_:
+            switch (f->size) {
+                case 1: NB_FIELD_STORE(uint8_t, load_u8) break;
+                case 2: NB_FIELD_STORE(uint16_t, load_u16) break;
+                case 4: NB_FIELD_STORE(uint32_t, load_u32) break;
+                default: NB_FIELD_STORE(uint64_t, load_u64) break;
+            }
+            break;
+
+        case field_kind::float_:
+            if (f->size == 4)
+                NB_FIELD_STORE(float, load_f32)
+            else
+                NB_FIELD_STORE(double, load_f64)
+            break;
+
+#undef NB_FIELD_STORE
+
+        default: {
+            cleanup_list cleanup(self);
+            void *src;
+            success = nb_type_get(f->type, value, flags, &cleanup, &src);
+            if (success) {
+                try {
+                    f->assign(p, src);
+                } catch (...) {
+                    cleanup.release();
+                    nb_func_convert_cpp_exception();
+                    return -1;
+                }
+            }
+            cleanup.release();
+        }
+    }
+
+    if (!success) {
+#if !defined(Py_LIMITED_API)
+        PyErr_Format(PyExc_TypeError,
+                     "%s: incompatible value of type '%s'!", f->name,
+                     Py_TYPE(value)->tp_name);
+#else
+        PyObject *name = PyType_GetName(Py_TYPE(value));
+        if (name) {
+            PyErr_Format(PyExc_TypeError,
+                         "%s: incompatible value of type '%U'!", f->name,
+                         name);
+            Py_DECREF(name);
+        }
+#endif
+        return -1;
+    }
+
+    return 0;
+}
+
+void field_install(PyObject *scope, const field_data *f) noexcept {
+    nb_internals &internals = internals_get();
+
+    nb_field *field = new nb_field();
+    field->data = *f;
+    field->data.name = NB_STRDUP(f->name);
+    field->data.doc = f->doc ? NB_STRDUP(f->doc) : nullptr;
+
+    field->def.name = field->data.name;
+    field->def.get = nb_field_get;
+    field->def.set = f->readonly ? nullptr : nb_field_set;
+    field->def.doc = field->data.doc;
+    field->def.closure = &field->data;
+    internals.fields.push_back(field);
+
+    PyObject *descr = PyDescr_NewGetSet((PyTypeObject *) scope, &field->def);
+    if (!descr || PyObject_SetAttrString(scope, f->name, descr))
+        fail("nanobind::detail::field_install(\"%s\"): could not install "
+             "the descriptor!", f->name);
+    Py_DECREF(descr);
+}
+
 // ========================================================================
 
 void tuple_check(PyObject *tuple, size_t nargs) {
@@ -842,5 +1224,93 @@ std::pair<int64_t, bool> load_i64(PyObject *o, uint8_t flags) noexcept {
     return load_int<int64_t>(o, flags);
 }
 
+template <typename T>
+NB_INLINE bool seq_load_arith_item(PyObject *o, uint8_t flags, T *out) noexcept {
+    std::pair<T, bool> result;
+
+    if constexpr (std::is_floating_point_v<T>) {
+        if (PyFloat_CheckExact(o)) {
+            #if !defined(Py_LIMITED_API)
+                *out = (T) PyFloat_AS_DOUBLE(o);
+            #else
+                *out = (T) PyFloat_AsDouble(o);
+            #endif
+            return true;
+        }
+        if constexpr (sizeof(T) == 8)
+            result = load_f64(o, flags);
+        else
+            result = load_f32(o, flags);
+    } else {
+        result = load_int<T>(o, flags);
+    }
+
+    *out = result.first;
+    return result.second;
+}
+
+template <typename T>
+static bool seq_load_arith_impl(PyObject *seq, uint8_t flags,
+                                void *(*resize)(void *, size_t),
+                                void *payload) noexcept {
+    size_t size;
+    PyObject *temp, *storage[16];
+    PyObject **o = seq_get(seq, &size, &temp, storage, 16);
+    T *out = o ? (T *) resize(payload, size) : nullptr;
+
+    bool success = out || (o && size == 0);
+    for (size_t i = 0; success && i < size; ++i)
+        success = seq_load_arith_item<T>(o[i], flags, out + i);
+
+    Py_XDECREF(temp);
+    return success;
+}
+
+bool seq_load_arith(PyObject *seq, uint8_t flags, uint8_t code, size_t size,
+                    void *(*resize)(void *, size_t), void *payload) noexcept {
+    /* Buffer protocol and DLPack inputs (e.g., NumPy arrays) are copied in
+       bulk. The element-wise path below remains as a fallback, which also
+       handles conversions that the bulk path rejects. */
+    if (!PyList_CheckExact(seq) && !PyTuple_CheckExact(seq)) {
+    #if !defined(Py_LIMITED_API) || Py_LIMITED_API >= 0x030B0000
+        bool has_buffer = PyObject_CheckBuffer(seq);
+    #else
+        bool has_buffer = false;
+    #endif
+        if ((has_buffer || PyObject_HasAttrString(seq, "__dlpack__")) &&
+            tensor_load_arith(seq, flags, code, size, resize, payload))
+            return true;
+    }
+
+    switch (code) {
+        case 0: // signed integer
+            switch (size) {
+                case 1: return seq_load_arith_impl<int8_t>(seq, flags, resize, payload);
+                case 2: return seq_load_arith_impl<int16_t>(seq, flags, resize, payload);
+                case 4: return seq_load_arith_impl<int32_t>(seq, flags, resize, payload);
+                case 8: return seq_load_arith_impl<int64_t>(seq, flags, resize, payload);
+            }
+            break;
+
+        case 1: // unsigned integer
+            switch (size) {
+                case 1: return seq_load_arith_impl<uint8_t>(seq, flags, resize, payload);
+                case 2: return seq_load_arith_impl<uint16_t>(seq, flags, resize, payload);
+                case 4: return seq_load_arith_impl<uint32_t>(seq, flags, resize, payload);
+                case 8: return seq_load_arith_impl<uint64_t>(seq, flags, resize, payload);
+            }
+            break;
+
+        case 2: // floating point
+            switch (size) {
+                case 4: return seq_load_arith_impl<float>(seq, flags, resize, payload);
+                case 8: return seq_load_arith_impl<double>(seq, flags, resize, payload);
+            }
+            break;
+    }
+
+    return false;
+}
+
 NAMESPACE_END(detail)
 NAMESPACE_END(NB_NAMESPACE)
@@ -14,7 +14,9 @@
 NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
 
-Buffer buf(128);
+/// Scratch buffer for error messages and signatures (one per thread, so that
+/// interpreters with their own GIL don't share it)
+thread_local Buffer buf(128);
 
 NAMESPACE_END(detail)
 
@@ -127,9 +129,22 @@ NB_EXCEPTION(attribute_error, PyExc_AttributeError)
 
 NAMESPACE_BEGIN(detail)
 
-void register_exception_translator(exception_translator t, void *payload) {
-    auto &et = internals_get().exception_translators;
+void register_exception_translator(exception_translator t, void *payload,
+                                   const std::type_info *type) {
+    nb_internals &internals = internals_get();
+    auto &et = internals.exception_translators;
     et.insert(et.begin(), { t, payload });
+
+    if (type) {
+        exception_translator_typed entry {
+            t, payload, internals.exception_translators_untyped
+        };
+        internals.exception_translators_typed.update([&](auto &map) {
+            map.insert_or_assign(std::type_index(*type), entry);
+        });
+    } else {
+        internals.exception_translators_untyped++;
+    }
 }
 
 NB_CORE PyObject *exception_new(PyObject *scope, const char *name,
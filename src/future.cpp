@@ -0,0 +1,356 @@
+/*
+    src/future.cpp: asyncio futures completed from C++, see future_new() and
+    future_wrap()
+
+    Copyright (c) 2022 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#include "nb_internals.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+/**
+ * Interpreter that owns pending asyncio futures. Completions attach a new
+ * thread state to it, until the interpreter starts to shut down: from then
+ * on, results are discarded without touching Python. The record is released
+ * once the interpreter and all of its tasks have dropped their reference.
+ */
+struct future_interp {
+    PyInterpreterState *interp;
+    size_t refs;
+    size_t active; ///< Threads that are currently completing a future
+    bool alive;
+};
+
+/// An asyncio future along with the event loop that it belongs to
+struct future_task {
+    future_interp *fi;
+    PyObject *loop;
+    PyObject *future;
+};
+
+/// A C++ future waited upon by the pool below
+struct future_waiter {
+    future_task *task;
+    void *payload;
+    future_wait wait;
+    future_result result;
+    future_free free;
+};
+
+/**
+ * Threads waiting for C++ futures. Each pending future occupies a thread for
+ * the duration of its wait() call: the pool starts additional threads when no
+ * idle ones are available, and threads that remain idle for a while exit.
+ *
+ * The pool is shared by all interpreters and never released, since its
+ * (detached) threads may still be blocked on C++ futures at shutdown. Its
+ * mutex also protects the 'future_interp' records.
+ */
+struct future_pool {
+    std::mutex mutex;
+    std::condition_variable cv, done;
+    std::deque<future_waiter *> tasks;
+    size_t idle = 0;
+};
+
+static future_pool *pool = new future_pool();
+
+/// Drop a reference to 'fi' (pool->mutex must be held)
+static void future_interp_release(future_interp *fi) noexcept {
+    if (--fi->refs == 0)
+        delete fi;
+}
+
+/// atexit() handler: wait for running completions and disable further ones
+static PyObject *future_shutdown(PyObject *, PyObject *) {
+    nb_internals &internals = internals_get();
+    future_interp *fi = internals.futures;
+    if (!fi)
+        Py_RETURN_NONE;
+    internals.futures = nullptr;
+
+    Py_BEGIN_ALLOW_THREADS
+    std::unique_lock<std::mutex> lock(pool->mutex);
+    fi->alive = false;
+    pool->done.wait(lock, [fi] { return fi->active == 0; });
+    future_interp_release(fi);
+    Py_END_ALLOW_THREADS
+
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef future_shutdown_def = {
+    "future_shutdown", (PyCFunction) future_shutdown, METH_NOARGS, nullptr
+};
+
+/// Return the record of the current interpreter (registers the atexit handler)
+static future_interp *future_interp_get() noexcept {
+    nb_internals &internals = internals_get();
+    if (internals.futures)
+        return internals.futures;
+
+    PyObject *atexit = PyImport_ImportModule("atexit"),
+             *func = PyCFunction_New(&future_shutdown_def, nullptr),
+             *rv = nullptr;
+    if (atexit && func)
+        rv = PyObject_CallMethod(atexit, "register", "O", func);
+    Py_XDECREF(atexit);
+    Py_XDECREF(func);
+    if (!rv)
+        return nullptr;
+    Py_DECREF(rv);
+
+    internals.futures = new future_interp{ interp_get(), 1, 0, true };
+    return internals.futures;
+}
+
+/// Called on the event loop thread: pass the result to the asyncio future
+static PyObject *future_deliver(PyObject *, PyObject *args) {
+    PyObject *future, *value;
+    int is_error;
+    if (!PyArg_ParseTuple(args, "OOp", &future, &value, &is_error))
+        return nullptr;
+
+    PyObject *cancelled = PyObject_CallMethod(future, "cancelled", nullptr);
+    if (!cancelled)
+        return nullptr;
+    int skip = PyObject_IsTrue(cancelled);
+    Py_DECREF(cancelled);
+    if (skip < 0)
+        return nullptr;
+    else if (skip)
+        Py_RETURN_NONE;
+
+    return PyObject_CallMethod(future, is_error ? "set_exception" : "set_result",
+                               "O", value);
+}
+
+static PyMethodDef future_deliver_def = {
+    "future_deliver", (PyCFunction) future_deliver, METH_VARARGS, nullptr
+};
+
+/// Convert a result and schedule its delivery to the future of 'task' (GIL held)
+static void future_complete(future_task *task, void *payload,
+                            future_result result, future_free free) noexcept {
+    PyObject *value = nullptr;
+    bool is_error = false;
+
+    try {
+        value = result(payload);
+    } catch (...) {
+        nb_func_convert_cpp_exception();
+    }
+    free(payload);
+
+    if (!value) {
+        if (!PyErr_Occurred())
+            PyErr_SetString(PyExc_TypeError,
+                            "nanobind::detail::future_complete(): unable to "
+                            "convert the result of a C++ future!");
+
+        PyObject *type, *trace;
+        PyErr_Fetch(&type, &value, &trace);
+        PyErr_NormalizeException(&type, &value, &trace);
+        if (trace)
+            PyException_SetTraceback(value, trace);
+        Py_XDECREF(type);
+        Py_XDECREF(trace);
+        is_error = true;
+    }
+
+    PyObject *deliver = PyCFunction_New(&future_deliver_def, nullptr),
+             *rv = nullptr;
+    if (deliver)
+        rv = PyObject_CallMethod(task->loop, "call_soon_threadsafe", "OOOO",
+                                 deliver, task->future, value,
+                                 is_error ? Py_True : Py_False);
+
+    // A closed event loop can no longer receive the result
+    if (!rv)
+        PyErr_Clear();
+
+    Py_XDECREF(rv);
+    Py_XDECREF(deliver);
+    Py_DECREF(value);
+    Py_DECREF(task->future);
+    Py_DECREF(task->loop);
+}
+
+future_task *future_new() noexcept {
+    future_interp *fi = future_interp_get();
+    if (!fi)
+        return nullptr;
+
+    PyObject *asyncio = PyImport_ImportModule("asyncio"),
+             *loop = nullptr, *future = nullptr;
+
+    if (asyncio)
+        loop = PyObject_CallMethod(asyncio, "get_running_loop", nullptr);
+    if (loop)
+        future = PyObject_CallMethod(loop, "create_future", nullptr);
+    Py_XDECREF(asyncio);
+
+    if (!future) {
+        Py_XDECREF(loop);
+        return nullptr;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(pool->mutex);
+        fi->refs++;
+    }
+
+    return new future_task{ fi, loop, future };
+}
+
+PyObject *future_get(future_task *task) noexcept {
+    Py_INCREF(task->future);
+    return task->future;
+}
+
+void future_resolve(future_task *task, void *payload, future_result result,
+                    future_free free) noexcept {
+    future_interp *fi = task->fi;
+
+#if defined(Py_LIMITED_API)
+    bool attached = false; // see below
+#else
+    PyThreadState *current = tstate_attached();
+    bool attached =
+        current && PyThreadState_GetInterpreter(current) == fi->interp;
+#endif
+
+    if (attached) {
+        future_complete(task, payload, result, free);
+        std::lock_guard<std::mutex> guard(pool->mutex);
+        future_interp_release(fi);
+    } else {
+        {
+            std::lock_guard<std::mutex> guard(pool->mutex);
+            if (fi->alive) {
+                fi->active++;
+            } else {
+                // The interpreter is shutting down, leak the Python objects
+                future_interp_release(fi);
+                fi = nullptr;
+            }
+        }
+
+        if (!fi) {
+            free(payload);
+            delete task;
+            return;
+        }
+
+#if !defined(Py_LIMITED_API)
+        if (fi->interp) {
+            PyThreadState *ts = PyThreadState_New(fi->interp);
+            PyEval_RestoreThread(ts);
+            future_complete(task, payload, result, free);
+            PyThreadState_Clear(ts);
+            PyEval_SaveThread();
+            PyThreadState_Delete(ts);
+        } else
+#endif
+        {
+            /* The stable ABI can't tell if the calling thread holds the GIL
+               and only supports the main interpreter here */
+            PyGILState_STATE state = PyGILState_Ensure();
+            future_complete(task, payload, result, free);
+            PyGILState_Release(state);
+        }
+
+        std::lock_guard<std::mutex> guard(pool->mutex);
+        if (--fi->active == 0 && !fi->alive)
+            pool->done.notify_all();
+        future_interp_release(fi);
+    }
+
+    delete task;
+}
+
+static void future_worker() noexcept {
+    std::unique_lock<std::mutex> lock(pool->mutex);
+
+    while (true) {
+        if (pool->tasks.empty()) {
+            pool->idle++;
+            bool ready = pool->cv.wait_for(lock, std::chrono::seconds(10),
+                                           [] { return !pool->tasks.empty(); });
+            pool->idle--;
+            if (!ready)
+                break;
+        }
+
+        future_waiter *w = pool->tasks.front();
+        pool->tasks.pop_front();
+
+        lock.unlock();
+        w->wait(w->payload);
+        future_resolve(w->task, w->payload, w->result, w->free);
+        delete w;
+        lock.lock();
+    }
+}
+
+PyObject *future_wrap(void *payload, future_wait wait, future_result result,
+                      future_free free) noexcept {
+    future_task *task = future_new();
+    if (!task) {
+        free(payload);
+        return nullptr;
+    }
+
+    PyObject *future = future_get(task);
+    future_waiter *w = new future_waiter{ task, payload, wait, result, free };
+
+    bool success = true;
+    {
+        std::lock_guard<std::mutex> guard(pool->mutex);
+        pool->tasks.push_back(w);
+
+        // Reserve an idle thread for every queued task, or start a new one
+        if (pool->idle >= pool->tasks.size()) {
+            pool->cv.notify_one();
+        } else {
+            try {
+                std::thread(future_worker).detach();
+            } catch (...) {
+                pool->tasks.pop_back();
+                success = false;
+            }
+        }
+    }
+
+    if (!success) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "nanobind::detail::future_wrap(): could not start a "
+                        "waiter thread!");
+        free(payload);
+        Py_DECREF(future);
+        Py_DECREF(task->future);
+        Py_DECREF(task->loop);
+        {
+            std::lock_guard<std::mutex> guard(pool->mutex);
+            future_interp_release(task->fi);
+        }
+        delete task;
+        delete w;
+        return nullptr;
+    }
+
+    return future;
+}
+
+NAMESPACE_END(detail)
+NAMESPACE_END(NB_NAMESPACE)
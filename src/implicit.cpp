@@ -13,64 +13,83 @@
 NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
 
+/// Append 'value' to a null-terminated array of pointers
+template <typename T, typename V>
+static void implicit_append(T *&array, size_t size, V value) {
+    T *data = (T *) malloc(sizeof(T) * (size + 2));
+    if (!data)
+        fail("nanobind::detail::implicitly_convertible(): out of memory!");
+    if (size)
+        memcpy(data, array, size * sizeof(T));
+    data[size] = (T) value;
+    data[size + 1] = nullptr;
+    free(array);
+    array = data;
+}
+
+static void implicit_prepare(type_data *t) {
+    if (!(t->flags & (uint32_t) type_flags::has_implicit_conversions)) {
+        t->implicit = nullptr;
+        t->implicit_py = nullptr;
+        t->implicit_cast = nullptr;
+        t->implicit_py_cast = nullptr;
+        t->flags |= (uint32_t) type_flags::has_implicit_conversions;
+    }
+}
+
 void implicitly_convertible(const std::type_info *src,
-                            const std::type_info *dst) noexcept {
+                            const std::type_info *dst,
+                            bool (*cast)(void *, PyObject *,
+                                         cleanup_list *)) noexcept {
     nb_internals &internals = internals_get();
 
-    auto it = internals.type_c2p.find(std::type_index(*dst));
-    if (it == internals.type_c2p.end())
+    type_data *t = nb_type_c2p(internals, dst);
+    if (!t)
         fail("nanobind::detail::implicitly_convertible(src=%s, dst=%s): "
              "destination type unknown!", type_name(src), type_name(dst));
 
-    type_data *t = it->second;
-    size_t size = 0;
+    implicit_prepare(t);
 
-    if (t->flags & (uint32_t) type_flags::has_implicit_conversions) {
-        while (t->implicit && t->implicit[size])
-            size++;
-    } else {
-        t->implicit = nullptr;
-        t->implicit_py = nullptr;
-        t->flags |= (uint32_t) type_flags::has_implicit_conversions;
+    size_t size = 0;
+    while (t->implicit && t->implicit[size]) {
+        const std::type_info *v = t->implicit[size];
+        if (v == src || *v == *src) {
+            if (cast)
+                t->implicit_cast[size] = cast;
+            implicit_cache_clear(internals);
+            return;
+        }
+        size++;
     }
 
-    void **data = (void **) malloc(sizeof(void *) * (size + 2));
+    implicit_append(t->implicit, size, src);
+    implicit_append(t->implicit_cast, size, cast);
 
-    memcpy(data, t->implicit, size * sizeof(void *));
-    data[size] = (void *) src;
-    data[size + 1] = nullptr;
-    free(t->implicit);
-    t->implicit = (decltype(t->implicit)) data;
+    implicit_cache_clear(internals);
 }
 
 void implicitly_convertible(bool (*predicate)(PyTypeObject *, PyObject *,
                                               cleanup_list *),
-                            const std::type_info *dst) noexcept {
+                            const std::type_info *dst,
+                            bool (*cast)(void *, PyObject *,
+                                         cleanup_list *)) noexcept {
     nb_internals &internals = internals_get();
 
-    auto it = internals.type_c2p.find(std::type_index(*dst));
-    if (it == internals.type_c2p.end())
+    type_data *t = nb_type_c2p(internals, dst);
+    if (!t)
         fail("nanobind::detail::implicitly_convertible(src=<predicate>, dst=%s): "
              "destination type unknown!", type_name(dst));
 
-    type_data *t = it->second;
+    implicit_prepare(t);
+
     size_t size = 0;
+    while (t->implicit_py && t->implicit_py[size])
+        size++;
 
-    if (t->flags & (uint32_t) type_flags::has_implicit_conversions) {
-        while (t->implicit_py && t->implicit_py[size])
-            size++;
-    } else {
-        t->implicit = nullptr;
-        t->implicit_py = nullptr;
-        t->flags |= (uint32_t) type_flags::has_implicit_conversions;
-    }
+    implicit_append(t->implicit_py, size, predicate);
+    implicit_append(t->implicit_py_cast, size, cast);
 
-    void **data = (void **) malloc(sizeof(void *) * (size + 2));
-    memcpy(data, t->implicit_py, size * sizeof(void *));
-    data[size] = (void *) predicate;
-    data[size + 1] = nullptr;
-    free(t->implicit_py);
-    t->implicit_py = (decltype(t->implicit_py)) data;
+    implicit_cache_clear(internals);
 }
 
 NAMESPACE_END(detail)
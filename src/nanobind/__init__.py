@@ -12,10 +12,40 @@ def cmake_dir() -> str:
     "Return the path to the nanobind CMake module directory."
     return os.path.join(os.path.abspath(os.path.dirname(__file__)), "cmake")
 
+def _stats_modules():
+    # Every loaded nanobind ABI variant registers its statistics API here
+    import builtins
+    return [v for k, v in vars(builtins).items() if k.startswith("__nb_stats_v")]
+
+def enable_stats(value: bool = True) -> None:
+    "Enable or disable the collection of per-function call statistics"
+    for m in _stats_modules():
+        m.enable_stats(value)
+
+def reset_stats() -> None:
+    "Reset the call statistics of all nanobind functions"
+    for m in _stats_modules():
+        m.reset_stats()
+
+def stats() -> dict:
+    """
+    Return a dictionary mapping nanobind functions that were called while
+    statistics collection was enabled to a dictionary with the entries
+    'calls', 'attempts', 'convert_fallbacks', 'implicit_conversions',
+    'exceptions', and 'time' (cumulative wall time in seconds)
+    """
+    result = {}
+    for m in _stats_modules():
+        result.update(m.stats())
+    return result
+
 __version__ = "0.0.6"
 
 __all__ = (
     "__version__",
     "include_dir",
     "cmake_dir",
+    "enable_stats",
+    "reset_stats",
+    "stats",
 )
@@ -15,22 +15,107 @@ NAMESPACE_BEGIN(detail)
 
 static PyObject *nb_enum_int(PyObject *o);
 
+/// Fetch the 64 bit key of the enumeration value stored at 'p'
+static bool nb_enum_key(const type_data *t, const void *p, uint64_t *key) {
+    if (t->flags & (uint32_t) type_flags::is_unsigned_enum) {
+        switch (t->size) {
+            case 1: *key = (uint64_t) *(const uint8_t *)  p; return true;
+            case 2: *key = (uint64_t) *(const uint16_t *) p; return true;
+            case 4: *key = (uint64_t) *(const uint32_t *) p; return true;
+            case 8: *key = (uint64_t) *(const uint64_t *) p; return true;
+            default: return false;
+        }
+    } else {
+        switch (t->size) {
+            case 1: *key = (uint64_t) (int64_t) *(const int8_t *)  p; return true;
+            case 2: *key = (uint64_t) (int64_t) *(const int16_t *) p; return true;
+            case 4: *key = (uint64_t) (int64_t) *(const int32_t *) p; return true;
+            case 8: *key = (uint64_t) *(const int64_t *) p; return true;
+            default: return false;
+        }
+    }
+}
+
+/// Rebuild the direct lookup table if the entries are (mostly) contiguous
+static void nb_enum_rebuild(nb_enum_supplement *s) {
+    s->dirty = false;
+    PyMem_Free(s->dense);
+    s->dense = nullptr;
+    s->dense_size = 0;
+
+    if (s->entries.empty())
+        return;
+
+    // Compare keys as signed values so that e.g. [-1, 1] is contiguous
+    int64_t lo = INT64_MAX, hi = INT64_MIN;
+    for (auto &kv : s->entries) {
+        int64_t k = (int64_t) kv.first;
+        lo = k < lo ? k : lo;
+        hi = k > hi ? k : hi;
+    }
+
+    uint64_t range = (uint64_t) hi - (uint64_t) lo + 1;
+    if (range == 0 || range > 2 * s->entries.size() + 8)
+        return; // sparse, use the hash table
+
+    s->dense = (PyObject **) PyMem_Calloc((size_t) range, sizeof(PyObject *));
+    if (!s->dense)
+        return;
+
+    s->dense_min = (uint64_t) lo;
+    s->dense_size = (size_t) range;
+    for (auto &kv : s->entries)
+        s->dense[kv.first - s->dense_min] = kv.second;
+}
+
+/// Return a borrowed reference to the '(name, doc, instance)' record of 'key'
+static PyObject *nb_enum_record(type_data *t, uint64_t key) {
+    nb_enum_supplement *s = (nb_enum_supplement *) t->supplement;
+    if (!s)
+        return nullptr;
+
+    if (s->dirty)
+        nb_enum_rebuild(s);
+
+    if (s->dense) {
+        uint64_t index = key - s->dense_min;
+        return index < s->dense_size ? s->dense[index] : nullptr;
+    }
+
+    auto it = s->entries.find(key);
+    return it != s->entries.end() ? it->second : nullptr;
+}
+
+PyObject *nb_enum_find(type_data *t, const void *value) noexcept {
+    uint64_t key;
+    if (!nb_enum_key(t, value, &key))
+        return nullptr;
+
+    PyObject *rec = nb_enum_record(t, key);
+    return rec ? NB_TUPLE_GET_ITEM(rec, 2) : nullptr;
+}
+
+void nb_enum_free(type_data *t) noexcept {
+    nb_enum_supplement *s = (nb_enum_supplement *) t->supplement;
+    if (!s)
+        return;
+    PyMem_Free(s->dense);
+    delete s;
+    t->supplement = nullptr;
+}
+
 /// Map to unique representative enum instance, returns a borrowed reference
 static PyObject *nb_enum_lookup(PyObject *self) {
-    PyObject *int_val = nb_enum_int(self),
-             *dict    = PyObject_GetAttrString((PyObject *) Py_TYPE(self), "__entries");
+    type_data *t = nb_type_data(Py_TYPE(self));
 
+    uint64_t key;
     PyObject *rec = nullptr;
-    if (int_val && dict)
-        rec = (PyObject *) PyDict_GetItem(dict, int_val);
-
-    Py_XDECREF(int_val);
-    Py_XDECREF(dict);
+    if (nb_enum_key(t, inst_ptr((nb_inst *) self), &key))
+        rec = nb_enum_record(t, key);
 
-    if (rec && PyTuple_CheckExact(rec) && NB_TUPLE_GET_SIZE(rec) == 3) {
+    if (rec) {
         return rec;
     } else {
-        PyErr_Clear();
         PyErr_SetString(PyExc_RuntimeError, "nb_enum: could not find entry!");
         return nullptr;
     }
@@ -109,15 +194,17 @@ static PyObject *nb_enum_init(PyTypeObject *subtype, PyObject *args, PyObject *k
 
     arg = NB_TUPLE_GET_ITEM(args, 0);
     if (PyLong_Check(arg)) {
-        PyObject *entries =
-            PyObject_GetAttrString((PyObject *) subtype, "__entries");
-        if (!entries)
+        type_data *t = nb_type_data(subtype);
+        uint64_t key;
+        if (t->flags & (uint32_t) type_flags::is_unsigned_enum)
+            key = (uint64_t) PyLong_AsUnsignedLongLong(arg);
+        else
+            key = (uint64_t) PyLong_AsLongLong(arg);
+        if (PyErr_Occurred())
             goto error;
 
-        PyObject *item = PyDict_GetItem(entries, arg);
-        Py_DECREF(entries);
-
-        if (item && PyTuple_CheckExact(item) && NB_TUPLE_GET_SIZE(item) == 3) {
+        PyObject *item = nb_enum_record(t, key);
+        if (item) {
             item = NB_TUPLE_GET_ITEM(item, 2);
             Py_INCREF(item);
             return item;
@@ -274,6 +361,17 @@ void nb_enum_put(PyObject *type, const char *name, const void *value,
     if (PyDict_SetItem(dict, int_val, rec))
         goto error;
 
+    {
+        type_data *t = nb_type_data((PyTypeObject *) type);
+        nb_enum_supplement *s = (nb_enum_supplement *) t->supplement;
+        uint64_t key;
+        if (!s || !nb_enum_key(t, value, &key))
+            goto error;
+
+        s->entries[key] = rec;
+        s->dirty = true;
+    }
+
     Py_DECREF(int_val);
     Py_DECREF(dict);
     Py_DECREF(rec);
@@ -9,9 +9,13 @@
 
 #include "nb_internals.h"
 #include "buffer.h"
+#include <chrono>
+#include <string_view>
 
 #if defined(__GNUG__)
 #  include <cxxabi.h>
+/// Dynamic type of the exception being handled (Itanium C++ ABI)
+#  define NB_EXCEPTION_TYPE() abi::__cxa_current_exception_type()
 #endif
 
 #if defined(_MSC_VER)
@@ -22,13 +26,15 @@ NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
 
 // Forward/external declarations
-extern Buffer buf;
+extern thread_local Buffer buf;
 
 static PyObject *nb_func_vectorcall_simple(PyObject *, PyObject *const *,
                                            size_t, PyObject *) noexcept;
 static PyObject *nb_func_vectorcall_complex(PyObject *, PyObject *const *,
                                             size_t, PyObject *) noexcept;
-static void nb_func_render_signature(const func_data *f) noexcept;
+static PyObject *nb_func_vectorcall_simple_1(PyObject *, PyObject *const *,
+                                             size_t, PyObject *) noexcept;
+static bool nb_func_render_signature(const func_data *f) noexcept;
 
 int nb_func_traverse(PyObject *self, visitproc visit, void *arg) {
     size_t size = (size_t) Py_SIZE(self);
@@ -106,6 +112,9 @@ void nb_func_dealloc(PyObject *self) {
         }
     }
 
+    Py_XDECREF(((nb_func *) self)->doc);
+    Py_XDECREF(((nb_func *) self)->text_signature);
+
     PyObject_GC_Del(self);
 }
 
@@ -135,9 +144,261 @@ void nb_bound_method_dealloc(PyObject *self) {
  *
  * This is an implementation detail of nanobind::cpp_function.
  */
+/**
+ * A function annotated with nb::lazy() that was not yet materialized by
+ * nb_func_new(). The record is followed by its 'arg_data' entries, the
+ * null-terminated 'descr_types' array and the 'descr' string.
+ */
+struct nb_lazy_func {
+    nb_lazy_func *next; ///< Further overloads of the same name
+    func_data_prelim<0> f;
+};
+
+/**
+ * Pending lazy functions of a module. It is owned by a capsule that serves
+ * as 'self' of the module's '__getattr__' and '__dir__' functions (PEP 562).
+ * These reference the module via '__module__', which keeps the borrowed
+ * 'module' pointer valid without creating a cycle that the GC can't see.
+ */
+struct nb_lazy_table {
+    PyObject *module;
+    py_map<std::string_view, nb_lazy_func *> funcs;
+};
+
+static constexpr size_t nb_lazy_args_offset =
+    offsetof(nb_lazy_func, f) + offsetof(func_data_prelim<0>, args);
+
+/// Release a lazy function record ('materialized': ownership of the capture
+/// was transferred to an nb_func)
+static void nb_lazy_func_free(nb_lazy_func *l, bool materialized) noexcept {
+    func_data_prelim<0> &f = l->f;
+    if (f.flags & (uint32_t) func_flags::has_args) {
+        arg_data *args = (arg_data *) ((uint8_t *) l + nb_lazy_args_offset);
+        for (size_t i = 0; i < f.nargs; ++i)
+            Py_XDECREF(args[i].value);
+    }
+    if (!materialized && (f.flags & (uint32_t) func_flags::has_free))
+        f.free(f.capture);
+    free(l);
+}
+
+static void nb_lazy_table_free(PyObject *capsule) {
+    nb_lazy_table *t =
+        (nb_lazy_table *) PyCapsule_GetPointer(capsule, "nb_lazy_table");
+    for (auto &kv : t->funcs) {
+        for (nb_lazy_func *l = kv.second, *next; l; l = next) {
+            next = l->next;
+            nb_lazy_func_free(l, false);
+        }
+    }
+    delete t;
+}
+
+/**
+ * List the attributes of the module including pending functions. With
+ * 'public_only' set, names starting with an underscore are skipped, which
+ * matches the names imported by 'from module import *'.
+ */
+static PyObject *nb_lazy_names(nb_lazy_table *t, bool public_only) {
+    PyObject *result = PyList_New(0);
+    if (!result)
+        return nullptr;
+
+    PyObject *key, *value;
+    Py_ssize_t pos = 0;
+    PyObject *dict = PyModule_GetDict(t->module);
+    while (PyDict_Next(dict, &pos, &key, &value)) {
+        if (public_only && (!PyUnicode_Check(key) ||
+                            PyUnicode_ReadChar(key, 0) == (Py_UCS4) '_')) {
+            PyErr_Clear();
+            continue;
+        }
+        if (PyList_Append(result, key)) {
+            Py_DECREF(result);
+            return nullptr;
+        }
+    }
+
+    for (const auto &kv : t->funcs) {
+        if (public_only && kv.first[0] == '_')
+            continue;
+        PyObject *name = PyUnicode_FromStringAndSize(kv.first.data(),
+                                                     (Py_ssize_t) kv.first.size());
+        if (!name || PyList_Append(result, name)) {
+            Py_XDECREF(name);
+            Py_DECREF(result);
+            return nullptr;
+        }
+        Py_DECREF(name);
+    }
+
+    return result;
+}
+
+/// Module-level '__getattr__': create the functions named 'name'
+static PyObject *nb_lazy_getattr(PyObject *capsule, PyObject *name) {
+    nb_lazy_table *t =
+        (nb_lazy_table *) PyCapsule_GetPointer(capsule, "nb_lazy_table");
+
+    Py_ssize_t size;
+    const char *s = PyUnicode_AsUTF8AndSize(name, &size);
+    if (!s)
+        return nullptr;
+
+    /* 'from module import *' imports the names listed by '__all__' if the
+       attribute exists, which thereby also covers pending functions */
+    if (std::string_view(s, (size_t) size) == "__all__")
+        return nb_lazy_names(t, true);
+
+    auto it = t->funcs.find(std::string_view(s, (size_t) size));
+    if (it != t->funcs.end()) {
+        nb_lazy_func *l = it->second;
+        t->funcs.erase(it);
+
+        // Overloads are created in the order of their definition
+        for (nb_lazy_func *next; l; l = next) {
+            next = l->next;
+            nb_func_new(&l->f);
+            nb_lazy_func_free(l, true);
+        }
+    }
+
+    /* Also consult the module that defined the functions, in case this one
+       shares its contents (see module_reuse()) */
+    PyObject *result = PyDict_GetItemWithError(PyModule_GetDict(t->module), name);
+    if (result) {
+        Py_INCREF(result);
+    } else if (!PyErr_Occurred()) {
+        PyObject *modname = PyModule_GetNameObject(t->module);
+        if (modname) {
+            PyErr_Format(PyExc_AttributeError,
+                         "module '%U' has no attribute '%U'", modname, name);
+            Py_DECREF(modname);
+        }
+    }
+
+    return result;
+}
+
+/// Module-level '__dir__': include functions that were not yet created
+static PyObject *nb_lazy_dir(PyObject *capsule, PyObject *) {
+    return nb_lazy_names(
+        (nb_lazy_table *) PyCapsule_GetPointer(capsule, "nb_lazy_table"), false);
+}
+
+static PyMethodDef nb_lazy_getattr_def = {
+    "__getattr__", (PyCFunction) nb_lazy_getattr, METH_O,
+    "Implementation detail of nanobind::lazy"
+};
+
+static PyMethodDef nb_lazy_dir_def = {
+    "__dir__", (PyCFunction) nb_lazy_dir, METH_NOARGS,
+    "Implementation detail of nanobind::lazy"
+};
+
+/// Return the lazy function table of 'module' (creating it if needed), or
+/// nullptr if the module provides its own '__getattr__'
+static nb_lazy_table *nb_lazy_table_get(PyObject *module) noexcept {
+    PyObject *dict = PyModule_GetDict(module),
+             *getattr = PyDict_GetItemString(dict, "__getattr__");
+
+    if (getattr) {
+        if (!PyCFunction_Check(getattr) ||
+            PyCFunction_GetFunction(getattr) != (PyCFunction) nb_lazy_getattr)
+            return nullptr;
+        return (nb_lazy_table *) PyCapsule_GetPointer(
+            PyCFunction_GetSelf(getattr), "nb_lazy_table");
+    }
+
+    nb_lazy_table *t = new nb_lazy_table();
+    t->module = module;
+
+    PyObject *capsule = PyCapsule_New(t, "nb_lazy_table", nb_lazy_table_free);
+    if (!capsule)
+        fail("nanobind::detail::nb_lazy_table_get(): allocation failed!");
+
+    PyObject *getattr_func =
+                 PyCFunction_NewEx(&nb_lazy_getattr_def, capsule, module),
+             *dir_func = PyCFunction_NewEx(&nb_lazy_dir_def, capsule, module);
+    Py_DECREF(capsule);
+
+    if (!getattr_func || !dir_func ||
+        PyDict_SetItemString(dict, "__getattr__", getattr_func) ||
+        PyDict_SetItemString(dict, "__dir__", dir_func))
+        fail("nanobind::detail::nb_lazy_table_get(): could not install "
+             "'__getattr__'!");
+
+    Py_DECREF(getattr_func);
+    Py_DECREF(dir_func);
+
+    return t;
+}
+
+/**
+ * Record a function annotated with nb::lazy() instead of creating it. Returns
+ * 'false' when this isn't possible (the function then is created right away)
+ */
+static bool nb_func_lazy_add(const func_data_prelim<0> *f) noexcept {
+    const uint32_t required = (uint32_t) func_flags::has_scope |
+                              (uint32_t) func_flags::has_name,
+                   excluded = (uint32_t) func_flags::is_method |
+                              (uint32_t) func_flags::return_ref;
+
+    if ((f->flags & (required | excluded)) != required ||
+        !PyModule_Check(f->scope) ||
+        PyDict_GetItemString(PyModule_GetDict(f->scope), f->name))
+        return false;
+
+    nb_lazy_table *t = nb_lazy_table_get(f->scope);
+    if (!t)
+        return false;
+
+    const bool has_args = f->flags & (uint32_t) func_flags::has_args;
+    size_t nargs = has_args ? f->nargs : 0, ntypes = 1, ndescr = 1;
+    while (f->descr_types[ntypes - 1])
+        ntypes++;
+    ndescr += strlen(f->descr);
+
+    size_t types_offset = nb_lazy_args_offset + sizeof(arg_data) * nargs,
+           descr_offset = types_offset + sizeof(const std::type_info *) * ntypes;
+
+    uint8_t *p = (uint8_t *) malloc(descr_offset + ndescr);
+    if (!p)
+        fail("nanobind::detail::nb_func_lazy_add(): out of memory!");
+
+    nb_lazy_func *l = (nb_lazy_func *) p;
+    l->next = nullptr;
+    memcpy((void *) &l->f, f, nb_lazy_args_offset - offsetof(nb_lazy_func, f));
+    l->f.flags &= ~(uint32_t) func_flags::is_lazy;
+
+    arg_data *args = (arg_data *) (p + nb_lazy_args_offset);
+    memcpy(args, std::launder((arg_data *) f->args), sizeof(arg_data) * nargs);
+    for (size_t i = 0; i < nargs; ++i)
+        Py_XINCREF(args[i].value);
+
+    l->f.descr_types = (const std::type_info **) (p + types_offset);
+    memcpy(l->f.descr_types, f->descr_types,
+           sizeof(const std::type_info *) * ntypes);
+    l->f.descr = (const char *) (p + descr_offset);
+    memcpy(p + descr_offset, f->descr, ndescr);
+
+    auto [it, success] = t->funcs.try_emplace(std::string_view(f->name), l);
+    if (!success) {
+        nb_lazy_func *tail = it->second;
+        while (tail->next)
+            tail = tail->next;
+        tail->next = l;
+    }
+
+    return true;
+}
+
 PyObject *nb_func_new(const void *in_) noexcept {
     func_data_prelim<0> *f = (func_data_prelim<0> *) in_;
 
+    if ((f->flags & (uint32_t) func_flags::is_lazy) && nb_func_lazy_add(f))
+        return nullptr;
+
     const bool has_scope      = f->flags & (uint32_t) func_flags::has_scope,
                has_name       = f->flags & (uint32_t) func_flags::has_name,
                has_args       = f->flags & (uint32_t) func_flags::has_args,
@@ -184,6 +445,7 @@ PyObject *nb_func_new(const void *in_) noexcept {
     }
 
     // Create a new function and destroy the old one
+    nb_func_stats stats_prev { };
     Py_ssize_t to_copy = func_prev ? Py_SIZE(func_prev) : 0;
     nb_func *func = (nb_func *) PyType_GenericAlloc(
         is_method ? internals.nb_method : internals.nb_func, to_copy + 1);
@@ -192,12 +454,14 @@ PyObject *nb_func_new(const void *in_) noexcept {
              has_name ? f->name : "<anonymous>");
 
     func->max_nargs_pos = f->nargs;
+    func->ncleanup = f->ncleanup;
     func->complex_call = has_args || has_var_args || has_var_kwargs;
 
     if (func_prev) {
         func->complex_call |= ((nb_func *) func_prev)->complex_call;
         func->max_nargs_pos = std::max(func->max_nargs_pos,
                                        ((nb_func *) func_prev)->max_nargs_pos);
+        func->ncleanup += ((nb_func *) func_prev)->ncleanup;
 
         func_data *cur  = nb_func_data(func),
                   *prev = nb_func_data(func_prev);
@@ -210,14 +474,19 @@ PyObject *nb_func_new(const void *in_) noexcept {
         auto it = internals.funcs.find(func_prev);
         if (it == internals.funcs.end())
             fail("nanobind::detail::nb_func_new(): internal update failed (1)!");
+        stats_prev = it->second;
         internals.funcs.erase(it);
     }
 
-    func->vectorcall = func->complex_call ? nb_func_vectorcall_complex
-                                          : nb_func_vectorcall_simple;
+    if (func->complex_call)
+        func->vectorcall = nb_func_vectorcall_complex;
+    else if (to_copy == 0)
+        func->vectorcall = nb_func_vectorcall_simple_1;
+    else
+        func->vectorcall = nb_func_vectorcall_simple;
 
     // Register the function
-    auto [it, success] = internals.funcs.insert(func);
+    auto [it, success] = internals.funcs.try_emplace(func, stats_prev);
     if (!success)
         fail("nanobind::detail::nb_func_new(): internal update failed (2)!");
 
@@ -371,10 +640,32 @@ static NB_NOINLINE PyObject *nb_func_error_noconvert(PyObject *self,
 }
 
 /// Used by nb_func_vectorcall: convert a C++ exception into a Python error
-static NB_NOINLINE void nb_func_convert_cpp_exception() noexcept {
+NB_NOINLINE void nb_func_convert_cpp_exception() noexcept {
     std::exception_ptr e = std::current_exception();
+    nb_internals &internals = internals_get();
+
+#if defined(NB_EXCEPTION_TYPE)
+    /* Translators registered for the exact type of the exception are found
+       without rethrowing it once per registered translator. This is skipped
+       if a translator without a type was registered afterwards, since it
+       takes precedence and might handle the exception differently. */
+    auto &typed = internals.exception_translators_typed.get();
+    const std::type_info *type;
+    if (!typed.empty() && (type = NB_EXCEPTION_TYPE()) != nullptr) {
+        auto it = typed.find(std::type_index(*type));
+        if (it != typed.end() &&
+            it->second.untyped == internals.exception_translators_untyped) {
+            try {
+                it->second.translator(e, it->second.payload);
+                return;
+            } catch (...) {
+                e = std::current_exception();
+            }
+        }
+    }
+#endif
 
-    for (auto pair : internals_get().exception_translators) {
+    for (auto pair : internals.exception_translators) {
         try {
             // Try exception translator & forward payload
             pair.first(e, pair.second);
@@ -389,7 +680,135 @@ static NB_NOINLINE void nb_func_convert_cpp_exception() noexcept {
                     "could not be translated!");
 }
 
-static PyTypeObject *nb_type_cache = nullptr;
+static uint64_t nb_func_time_ns() noexcept {
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * \brief Collects the statistics of a single function call when
+ * 'nb_internals::stats_enabled' is set, otherwise does nothing.
+ *
+ * Counters are accumulated locally and only added to the entry in
+ * 'nb_internals::funcs' when the call finishes, since nested calls may
+ * register new functions and thereby invalidate references into the map.
+ */
+struct nb_func_stats_scope {
+    PyObject *self;
+    nb_func_stats *stats = nullptr, *prev, local;
+    uint64_t start;
+
+    NB_INLINE nb_func_stats_scope(PyObject *self) : self(self) {
+        if (internals_get().stats_enabled)
+            begin();
+    }
+
+    NB_INLINE ~nb_func_stats_scope() {
+        if (stats)
+            end();
+    }
+
+    NB_NOINLINE void begin() noexcept {
+        local = nb_func_stats();
+        local.calls = 1;
+        stats = &local;
+        prev = current_func_stats;
+        current_func_stats = stats;
+        start = nb_func_time_ns();
+    }
+
+    NB_NOINLINE void end() noexcept {
+        local.time_ns = nb_func_time_ns() - start;
+        current_func_stats = prev;
+
+        auto &funcs = internals_get().funcs;
+        auto it = funcs.find(self);
+        if (it != funcs.end())
+            it.value() += local;
+    }
+};
+
+/// Used by nb_func_vectorcall: invoke a single overload, convert C++ exceptions
+static NB_INLINE PyObject *nb_func_invoke(const func_data *f, PyObject **args,
+                                          uint8_t *args_flags,
+                                          cleanup_list *cleanup,
+                                          bool &cacheable,
+                                          nb_func_stats *stats) noexcept {
+    if (stats)
+        stats->attempts++;
+
+    try {
+        return f->impl((void *) f->capture, args, args_flags,
+                       (rv_policy) (f->flags & 0b111), cleanup);
+    } catch (next_overload &) {
+        // Rejected by user code, which may depend on the argument values
+        cacheable = false;
+        return NB_NEXT_OVERLOAD;
+    } catch (python_error &e) {
+        e.restore();
+    } catch (...) {
+        nb_func_convert_cpp_exception();
+    }
+
+    if (stats)
+        stats->exceptions++;
+
+    return nullptr;
+}
+
+/**
+ * Check if the overload cache of 'func' refers to the given positional
+ * arguments. Only initialized nanobind instances and enumerations ever enter
+ * the cache, since their acceptance by a type caster is determined by their
+ * type. Builtin types are excluded: casters may accept or reject them based on
+ * their value (e.g. integer ranges, or the length of a 'str' bound to 'char')
+ * without the dispatch loop being able to tell.
+ */
+static NB_INLINE bool nb_func_cache_lookup(const nb_func *func,
+                                           PyObject *const *args_in,
+                                           size_t nargs_in) noexcept {
+    const nb_func_cache &c = func->cache;
+    if (!c.valid || c.nargs != nargs_in)
+        return false;
+
+    for (size_t i = 0; i < nargs_in; ++i) {
+        if (c.types[i] != Py_TYPE(args_in[i]))
+            return false;
+    }
+
+    return true;
+}
+
+/// Remember the overload that succeeded for the given positional arguments
+static void nb_func_cache_store(nb_func *func, PyObject *const *args_in,
+                                size_t nargs_in, size_t index, int pass,
+                                bool is_constructor) noexcept {
+    nb_func_cache &c = func->cache;
+
+    if (nargs_in > NB_FUNC_CACHE_NARGS || index > UINT32_MAX)
+        return;
+
+    nb_internals &internals = internals_get();
+
+    for (size_t i = 0; i < nargs_in; ++i) {
+        PyTypeObject *tp = Py_TYPE(args_in[i]),
+                     *meta = Py_TYPE((PyObject *) tp);
+
+        if (meta != internals.nb_type && meta != internals.nb_enum)
+            return;
+
+        // The 'self' argument of a constructor is not yet initialized
+        if (!((nb_inst *) args_in[i])->ready && !(i == 0 && is_constructor))
+            return;
+
+        c.types[i] = tp;
+    }
+
+    c.index = (uint32_t) index;
+    c.nargs = (uint8_t) nargs_in;
+    c.pass = (uint8_t) pass;
+    c.valid = true;
+}
 
 /// Dispatch loop that is used to invoke functions created by nb_func_new
 static PyObject *nb_func_vectorcall_complex(PyObject *self,
@@ -401,6 +820,7 @@ static PyObject *nb_func_vectorcall_complex(PyObject *self,
                  nkwargs_in = kwargs_in ? (size_t) NB_TUPLE_GET_SIZE(kwargs_in) : 0;
 
     func_data *fr = nb_func_data(self);
+    nb_func_stats_scope stats_scope(self);
 
     const bool is_method = fr->flags & (uint32_t) func_flags::is_method,
                is_constructor = fr->flags & (uint32_t) func_flags::is_constructor;
@@ -410,10 +830,8 @@ static PyObject *nb_func_vectorcall_complex(PyObject *self,
     if (is_method) {
         self_arg = nargs_in > 0 ? args_in[0] : nullptr;
 
-        if (!nb_type_cache)
-            nb_type_cache = internals_get().nb_type;
-
-        if (self_arg && Py_TYPE((PyObject *) Py_TYPE(self_arg)) != nb_type_cache)
+        if (self_arg &&
+            Py_TYPE((PyObject *) Py_TYPE(self_arg)) != internals_get().nb_type)
             self_arg = nullptr;
 
         if (!self_arg) {
@@ -453,8 +871,13 @@ static PyObject *nb_func_vectorcall_complex(PyObject *self,
     PyObject *(*error_handler)(PyObject *, PyObject *const *, size_t,
                                PyObject *) noexcept = nullptr;
 
-    // Small array holding temporaries (implicit conversion/*args/**kwargs)
-    cleanup_list cleanup(self_arg);
+    /* Array holding temporaries (implicit conversions, varargs, keyword
+       names), sized for both passes over the overload chain */
+    uint32_t cleanup_size = 1 + 2 * ((nb_func *) self)->ncleanup +
+                            (uint32_t) nkwargs_in;
+    cleanup_list cleanup(
+        self_arg, (PyObject **) alloca(cleanup_size * sizeof(PyObject *)),
+        cleanup_size);
 
     // Preallocate stack memory for function dispatch
     size_t max_nargs_pos = ((nb_func *) self)->max_nargs_pos;
@@ -462,6 +885,24 @@ static PyObject *nb_func_vectorcall_complex(PyObject *self,
     uint8_t *args_flags = (uint8_t *) alloca(max_nargs_pos * sizeof(uint8_t));
     bool *kwarg_used = (bool *) alloca(nkwargs_in * sizeof(bool));
 
+    /* Argument names in 'func_data::args' are interned, which permits matching
+       keyword arguments via pointer identity below. Keyword names produced by
+       the interpreter are normally interned as well; any others are replaced
+       by their interned counterpart here (once per call, not per overload). */
+    PyObject **kwnames = (PyObject **) alloca(nkwargs_in * sizeof(PyObject *));
+    for (size_t j = 0; j < nkwargs_in; ++j) {
+        PyObject *key = NB_TUPLE_GET_ITEM(kwargs_in, j);
+#if !defined(Py_LIMITED_API)
+        if (!PyUnicode_CheckExact(key) || !PyUnicode_CHECK_INTERNED(key))
+#endif
+        {
+            Py_INCREF(key);
+            PyUnicode_InternInPlace(&key);
+            cleanup.append(key);
+        }
+        kwnames[j] = key;
+    }
+
     /*  The logic below tries to find a suitable overload using two passes
         of the overload chain (or 1, if there are no overloads). The first pass
         is strict and permits no implicit conversions, while the second pass
@@ -489,9 +930,29 @@ static PyObject *nb_func_vectorcall_complex(PyObject *self,
         until we get a result other than NB_NEXT_OVERLOAD.
     */
 
-    for (int pass = (count > 1) ? 0 : 1; pass < 2; ++pass) {
+    nb_func *func = (nb_func *) self;
+    bool cacheable = kwargs_in == nullptr;
+
+    /* Pass -1 (if applicable) only tries the overload that previously
+       succeeded for the same positional argument types */
+    int pass_start = (count > 1) ? 0 : 1;
+    if (cacheable && count > 1 && nb_func_cache_lookup(func, args_in, nargs_in))
+        pass_start = -1;
+
+    for (int pass = pass_start; pass < 2; ++pass) {
+        if (pass == 1 && pass_start < 1 && stats_scope.stats)
+            stats_scope.stats->convert_fallbacks++;
+
         for (size_t k = 0; k < count; ++k) {
             const func_data *f = fr + k;
+            int pass_k = pass;
+
+            if (pass < 0) {
+                if (k > 0)
+                    break;
+                f = fr + func->cache.index;
+                pass_k = func->cache.pass;
+            }
 
             const bool has_args       = f->flags & (uint32_t) func_flags::has_args,
                        has_var_args   = f->flags & (uint32_t) func_flags::has_var_args,
@@ -513,7 +974,7 @@ static PyObject *nb_func_vectorcall_complex(PyObject *self,
             size_t i = 0;
             for (; i < nargs_pos; ++i) {
                 PyObject *arg = nullptr;
-                bool arg_convert  = pass == 1,
+                bool arg_convert  = pass_k == 1,
                      arg_none     = false;
 
                 if (i < nargs_in)
@@ -525,8 +986,7 @@ static PyObject *nb_func_vectorcall_complex(PyObject *self,
                     if (kwargs_in && ad.name_py) {
                         PyObject *hit = nullptr;
                         for (size_t j = 0; j < nkwargs_in; ++j) {
-                            PyObject *key = NB_TUPLE_GET_ITEM(kwargs_in, j);
-                            if (key == ad.name_py) {
+                            if (kwnames[j] == ad.name_py) {
                                 hit = args_in[nargs_in + j];
                                 kwarg_used[j] = true;
                                 break;
@@ -597,47 +1057,44 @@ static PyObject *nb_func_vectorcall_complex(PyObject *self,
             if (is_constructor)
                 args_flags[0] = (uint8_t) cast_flags::construct;
 
-            try {
-                // Found a suitable overload, let's try calling it
-                result = f->impl((void *) f->capture, args, args_flags,
-                                 (rv_policy) (f->flags & 0b111), &cleanup);
+            // Found a suitable overload, let's try calling it
+            result = nb_func_invoke(f, args, args_flags, &cleanup, cacheable,
+                                    stats_scope.stats);
 
-                if (!result) {
-                    error_handler = nb_func_error_noconvert;
-                    goto done;
-                }
-            } catch (next_overload &) {
-                result = NB_NEXT_OVERLOAD;
-            } catch (python_error &e) {
-                e.restore();
-                result = nullptr;
-                goto done;
-            } catch (...) {
-                nb_func_convert_cpp_exception();
-                result = nullptr;
+            if (!result) {
+                error_handler = nb_func_error_noconvert;
                 goto done;
             }
 
             if (result != NB_NEXT_OVERLOAD) {
-                if (is_constructor) {
-                    nb_inst *self_arg_nb = (nb_inst *) self_arg;
-                    self_arg_nb->destruct = true;
-                    self_arg_nb->ready = true;
-
-                    const type_data *t = nb_type_data(Py_TYPE(self_arg));
-                    if (t->flags & (uint32_t) type_flags::intrusive_ptr)
-                        t->set_self_py(inst_ptr(self_arg_nb), self_arg);
-                }
-
-                goto done;
+                if (pass >= 0 && count > 1 && cacheable)
+                    nb_func_cache_store(func, args_in, nargs_in, k, pass,
+                                        is_constructor);
+                goto success;
             }
+
+            if (pass < 0)
+                func->cache.valid = false;
         }
     }
 
     error_handler = nb_func_error_overload;
+    goto done;
+
+success:
+    if (is_constructor) {
+        nb_inst *self_arg_nb = (nb_inst *) self_arg;
+        self_arg_nb->destruct = true;
+        self_arg_nb->ready = true;
+
+        const type_data *t = nb_type_data(Py_TYPE(self_arg));
+        if (t->flags & (uint32_t) type_flags::intrusive_ptr)
+            t->set_self_py(inst_ptr(self_arg_nb), self_arg);
+    }
 
 done:
-    cleanup.release();
+    if (cleanup.used())
+        cleanup.release();
 
     if (error_handler)
         result = error_handler(self, args_in, nargs_in, kwargs_in);
@@ -659,6 +1116,8 @@ static PyObject *nb_func_vectorcall_simple(PyObject *self,
                  nargs_in      = (size_t) NB_VECTORCALL_NARGS(nargsf),
                  max_nargs_pos = ((nb_func *) self)->max_nargs_pos;
 
+    nb_func_stats_scope stats_scope(self);
+
     const bool is_method = fr->flags & (uint32_t) func_flags::is_method,
                is_constructor = fr->flags & (uint32_t) func_flags::is_constructor;
 
@@ -667,10 +1126,8 @@ static PyObject *nb_func_vectorcall_simple(PyObject *self,
     if (is_method) {
         self_arg = nargs_in > 0 ? args_in[0] : nullptr;
 
-        if (!nb_type_cache)
-            nb_type_cache = internals_get().nb_type;
-
-        if (self_arg && Py_TYPE((PyObject *) Py_TYPE(self_arg)) != nb_type_cache)
+        if (self_arg &&
+            Py_TYPE((PyObject *) Py_TYPE(self_arg)) != internals_get().nb_type)
             self_arg = nullptr;
 
         if (!self_arg) {
@@ -695,8 +1152,11 @@ static PyObject *nb_func_vectorcall_simple(PyObject *self,
         }
     }
 
-    /// Small array holding temporaries (implicit conversion/*args/**kwargs)
-    cleanup_list cleanup(self_arg);
+    // Array holding temporaries (implicit conversions)
+    uint32_t cleanup_size = 1 + ((nb_func *) self)->ncleanup;
+    cleanup_list cleanup(
+        self_arg, (PyObject **) alloca(cleanup_size * sizeof(PyObject *)),
+        cleanup_size);
 
     // Handler routine that will be invoked in case of an error condition
     PyObject *(*error_handler)(PyObject *, PyObject *const *, size_t,
@@ -712,59 +1172,77 @@ static PyObject *nb_func_vectorcall_simple(PyObject *self,
         goto done;
     }
 
-    for (int pass = (count > 1) ? 0 : 1; pass < 2; ++pass) {
-        memset(args_flags, pass, max_nargs_pos * sizeof(uint8_t));
-        if (is_constructor)
-            args_flags[0] = (uint8_t) cast_flags::construct;
+    {
+        nb_func *func = (nb_func *) self;
+        bool cacheable = true;
+
+        /* Pass -1 (if applicable) only tries the overload that previously
+           succeeded for the same argument types */
+        int pass_start = (count > 1) ? 0 : 1;
+        if (count > 1 && nb_func_cache_lookup(func, args_in, nargs_in))
+            pass_start = -1;
+
+        for (int pass = pass_start; pass < 2; ++pass) {
+            size_t k_start = 0, k_end = count;
+            int pass_k = pass;
+
+            if (pass < 0) {
+                k_start = func->cache.index;
+                k_end = k_start + 1;
+                pass_k = func->cache.pass;
+            } else if (pass == 1 && pass_start < 1 && stats_scope.stats) {
+                stats_scope.stats->convert_fallbacks++;
+            }
 
-        for (size_t k = 0; k < count; ++k) {
-            const func_data *f = fr + k;
+            memset(args_flags, pass_k, max_nargs_pos * sizeof(uint8_t));
+            if (is_constructor)
+                args_flags[0] = (uint8_t) cast_flags::construct;
 
-            if (nargs_in != f->nargs)
-                continue;
+            for (size_t k = k_start; k < k_end; ++k) {
+                const func_data *f = fr + k;
+
+                if (nargs_in != f->nargs)
+                    continue;
 
-            try {
                 // Found a suitable overload, let's try calling it
-                result = f->impl((void *) f->capture, (PyObject **) args_in,
-                                 args_flags, (rv_policy) (f->flags & 0b111),
-                                 &cleanup);
+                result = nb_func_invoke(f, (PyObject **) args_in, args_flags,
+                                        &cleanup, cacheable, stats_scope.stats);
 
                 if (!result) {
                     error_handler = nb_func_error_noconvert;
                     goto done;
                 }
-            } catch (next_overload &) {
-                result = NB_NEXT_OVERLOAD;
-            } catch (python_error &e) {
-                e.restore();
-                result = nullptr;
-                goto done;
-            } catch (...) {
-                nb_func_convert_cpp_exception();
-                result = nullptr;
-                goto done;
-            }
 
-            if (result != NB_NEXT_OVERLOAD) {
-                if (is_constructor) {
-                    nb_inst *self_arg_nb = (nb_inst *) self_arg;
-                    self_arg_nb->destruct = true;
-                    self_arg_nb->ready = true;
-
-                    const type_data *t = nb_type_data(Py_TYPE(self_arg));
-                    if (t->flags & (uint32_t) type_flags::intrusive_ptr)
-                        t->set_self_py(inst_ptr(self_arg_nb), self_arg);
+                if (result != NB_NEXT_OVERLOAD) {
+                    if (pass >= 0 && count > 1 && cacheable)
+                        nb_func_cache_store(func, args_in, nargs_in, k, pass,
+                                            is_constructor);
+                    goto success;
                 }
 
-                goto done;
+                if (pass < 0)
+                    func->cache.valid = false;
             }
         }
     }
 
     error_handler = nb_func_error_overload;
+    goto done;
+
+success:
+    if (is_constructor) {
+        nb_inst *self_arg_nb = (nb_inst *) self_arg;
+        self_arg_nb->destruct = true;
+        self_arg_nb->ready = true;
+
+        const type_data *t = nb_type_data(Py_TYPE(self_arg));
+        if (t->flags & (uint32_t) type_flags::intrusive_ptr)
+            t->set_self_py(inst_ptr(self_arg_nb), self_arg);
+    }
 
 done:
-    cleanup.release();
+    if (cleanup.used())
+        cleanup.release();
 
     if (error_handler)
         result = error_handler(self, args_in, nargs_in, kwargs_in);
@@ -775,6 +1253,93 @@ done:
     return result;
 }
 
+/// Specialized nb_func_vectorcall variant for a single overload w/o keyword arguments
+static PyObject *nb_func_vectorcall_simple_1(PyObject *self,
+                                             PyObject *const *args_in,
+                                             size_t nargsf,
+                                             PyObject *kwargs_in) noexcept {
+    const func_data *f = nb_func_data(self);
+    const size_t nargs_in = (size_t) NB_VECTORCALL_NARGS(nargsf);
+    nb_func_stats_scope stats_scope(self);
+
+    const bool is_method = f->flags & (uint32_t) func_flags::is_method,
+               is_constructor = f->flags & (uint32_t) func_flags::is_constructor;
+
+    // Keyword/None arguments and arity mismatches are reported by the error handler
+    bool fail = kwargs_in != nullptr || nargs_in != f->nargs;
+    for (size_t i = 0; i < nargs_in; ++i)
+        fail |= args_in[i] == Py_None;
+    if (fail)
+        return nb_func_error_overload(self, args_in, nargs_in, kwargs_in);
+
+    PyObject *self_arg = nullptr;
+
+    if (is_method) {
+        self_arg = nargs_in > 0 ? args_in[0] : nullptr;
+
+        if (self_arg &&
+            Py_TYPE((PyObject *) Py_TYPE(self_arg)) != internals_get().nb_type)
+            self_arg = nullptr;
+
+        if (!self_arg) {
+            PyErr_SetString(PyExc_RuntimeError,
+                            "nanobind::detail::nb_func_vectorcall_simple_1(): "
+                            "the 'self' argument of a method call should be a "
+                            "nanobind class.");
+            return nullptr;
+        }
+
+        if (is_constructor && ((nb_inst *) self_arg)->ready) {
+            PyErr_SetString(PyExc_RuntimeError,
+                            "nanobind::detail::nb_func_vectorcall_simple_1(): "
+                            "the __init__ method should not be called on an "
+                            "initialized object!");
+            return nullptr;
+        }
+
+        current_method_data = current_method{ f->name, self_arg };
+    }
+
+    // Only one overload: implicit conversions are permitted right away
+    uint8_t *args_flags = (uint8_t *) alloca(nargs_in * sizeof(uint8_t));
+    memset(args_flags, (uint8_t) cast_flags::convert, nargs_in * sizeof(uint8_t));
+    if (is_constructor)
+        args_flags[0] = (uint8_t) cast_flags::construct;
+
+    // Array holding temporaries (implicit conversions)
+    uint32_t cleanup_size = 1 + f->ncleanup;
+    cleanup_list cleanup(
+        self_arg, (PyObject **) alloca(cleanup_size * sizeof(PyObject *)),
+        cleanup_size);
+
+    bool cacheable = false;
+    PyObject *result = nb_func_invoke(f, (PyObject **) args_in, args_flags,
+                                      &cleanup, cacheable, stats_scope.stats);
+
+    if (result && result != NB_NEXT_OVERLOAD && is_constructor) {
+        nb_inst *self_arg_nb = (nb_inst *) self_arg;
+        self_arg_nb->destruct = true;
+        self_arg_nb->ready = true;
+
+        const type_data *t = nb_type_data(Py_TYPE(self_arg));
+        if (t->flags & (uint32_t) type_flags::intrusive_ptr)
+            t->set_self_py(inst_ptr(self_arg_nb), self_arg);
+    }
+
+    if (cleanup.used())
+        cleanup.release();
+
+    if (!result)
+        result = nb_func_error_noconvert(self, args_in, nargs_in, kwargs_in);
+    else if (result == NB_NEXT_OVERLOAD)
+        result = nb_func_error_overload(self, args_in, nargs_in, kwargs_in);
+
+    if (is_method)
+        current_method_data = current_method{ nullptr, nullptr };
+
+    return result;
+}
+
 static PyObject *nb_bound_method_vectorcall(PyObject *self,
                                             PyObject *const *args_in,
                                             size_t nargsf,
@@ -827,7 +1392,12 @@ PyObject *nb_method_descr_get(PyObject *self, PyObject *inst, PyObject *) {
 
 
 /// Render the function signature of a single function
-static void nb_func_render_signature(const func_data *f) noexcept {
+/**
+ * Render the signature of an overload into 'buf'. Returns 'false' if the
+ * signature references C++ types that have not been bound (yet), in which case
+ * the result should not be cached.
+ */
+static bool nb_func_render_signature(const func_data *f) noexcept {
     const bool is_method      = f->flags & (uint32_t) func_flags::is_method,
                has_args       = f->flags & (uint32_t) func_flags::has_args,
                has_var_args   = f->flags & (uint32_t) func_flags::has_var_args,
@@ -835,6 +1405,7 @@ static void nb_func_render_signature(const func_data *f) noexcept {
 
     const std::type_info **descr_type = f->descr_types;
     nb_internals &internals = internals_get();
+    bool complete = true;
 
     size_t arg_index = 0;
     buf.put_dstr(f->name);
@@ -925,7 +1496,7 @@ static void nb_func_render_signature(const func_data *f) noexcept {
 
                 arg_index++;
 
-                if (arg_index == f->nargs - has_var_args - has_var_kwargs && !has_args)
+                if (arg_index == (size_t) (f->nargs - has_var_args - has_var_kwargs) && !has_args)
                     buf.put(", /");
 
                 break;
@@ -935,10 +1506,10 @@ static void nb_func_render_signature(const func_data *f) noexcept {
                     fail("nb::detail::nb_func_finalize(): missing type!");
 
                 if (!(is_method && arg_index == 0)) {
-                    auto it = internals.type_c2p.find(std::type_index(**descr_type));
+                    type_data *td = nb_type_c2p(internals, *descr_type);
 
-                    if (it != internals.type_c2p.end()) {
-                        handle th((PyObject *) it->second->type_py);
+                    if (td) {
+                        handle th((PyObject *) td->type_py);
                         buf.put_dstr((borrow<str>(th.attr("__module__"))).c_str());
                         buf.put('.');
                         buf.put_dstr((borrow<str>(th.attr("__qualname__"))).c_str());
@@ -946,6 +1517,7 @@ static void nb_func_render_signature(const func_data *f) noexcept {
                         char *name = type_name(*descr_type);
                         buf.put_dstr(name);
                         free(name);
+                        complete = false;
                     }
                 }
 
@@ -960,6 +1532,84 @@ static void nb_func_render_signature(const func_data *f) noexcept {
 
     if (arg_index != f->nargs || *descr_type != nullptr)
         fail("nanobind::detail::nb_func_finalize(%s): arguments inconsistent.", f->name);
+
+    return complete;
+}
+
+/**
+ * Render the signature of 'f' in the format of CPython's '__text_signature__'
+ * (e.g. "($self, arg0, /)"): parameter names without annotations, and default
+ * values that 'inspect' can evaluate. Returns false when a default value is
+ * not a literal, in which case the signature is omitted.
+ */
+static bool nb_func_render_text_signature(const func_data *f) noexcept {
+    const bool is_method      = f->flags & (uint32_t) func_flags::is_method,
+               has_args       = f->flags & (uint32_t) func_flags::has_args,
+               has_var_args   = f->flags & (uint32_t) func_flags::has_var_args,
+               has_var_kwargs = f->flags & (uint32_t) func_flags::has_var_kwargs;
+
+    const size_t nargs_pos = f->nargs - has_var_args - has_var_kwargs;
+
+    buf.put('(');
+    for (size_t i = 0; i < f->nargs; ++i) {
+        if (i > 0)
+            buf.put(", ");
+
+        const char *name = has_args ? f->args[i].name : nullptr;
+
+        if (is_method && i == 0) {
+            buf.put("$self");
+        } else if (has_var_kwargs && i + 1 == f->nargs) {
+            buf.put("**");
+            buf.put_dstr(name ? name : "kwargs");
+        } else if (has_var_args && i == nargs_pos) {
+            buf.put("*");
+            buf.put_dstr(name ? name : "args");
+        } else if (name) {
+            buf.put_dstr(name);
+        } else {
+            buf.put("arg");
+            if (i > size_t(is_method) || f->nargs > 1 + (uint32_t) is_method)
+                buf.put_uint32((uint32_t) (i - is_method));
+        }
+
+        PyObject *o = has_args ? f->args[i].value : nullptr;
+        if (o) {
+            if (o != Py_None && !PyBool_Check(o) && !PyLong_CheckExact(o) &&
+                !PyFloat_CheckExact(o) && !PyUnicode_CheckExact(o))
+                return false;
+
+            PyObject *repr = PyObject_Repr(o);
+            const char *cstr = repr ? PyUnicode_AsUTF8AndSize(repr, nullptr)
+                                    : nullptr;
+            if (cstr) {
+                buf.put('=');
+                buf.put_dstr(cstr);
+            }
+            Py_XDECREF(repr);
+            if (!cstr) {
+                PyErr_Clear();
+                return false;
+            }
+        }
+
+        if (i + 1 == nargs_pos && !has_args)
+            buf.put(", /");
+    }
+    buf.put(')');
+
+    return true;
+}
+
+/// Create a 'str' object and (optionally) store a reference in 'cache'
+static PyObject *nb_func_cache_str(PyObject **cache, const char *s,
+                                   bool store) noexcept {
+    PyObject *result = PyUnicode_FromString(s);
+    if (result && store) {
+        Py_INCREF(result);
+        *cache = result;
+    }
+    return result;
 }
 
 PyObject *nb_func_getattro(PyObject *self, PyObject *name_) {
@@ -990,7 +1640,14 @@ PyObject *nb_func_getattro(PyObject *self, PyObject *name_) {
                 f->scope, PyModule_Check(f->scope) ? "__name__" : "__module__");
         }
     } else if (strcmp(name, "__doc__") == 0) {
+        nb_func *func = (nb_func *) self;
+        if (func->doc) {
+            Py_INCREF(func->doc);
+            return func->doc;
+        }
+
         uint32_t count = (uint32_t) Py_SIZE(self);
+        bool complete = true;
 
         buf.clear();
 
@@ -998,11 +1655,12 @@ PyObject *nb_func_getattro(PyObject *self, PyObject *name_) {
         for (uint32_t i = 0; i < count; ++i) {
             const func_data *fi = f + i;
             if (fi->flags & (uint32_t) func_flags::raw_doc)
-                return PyUnicode_FromString(fi->doc);
+                return nb_func_cache_str(&func->doc, fi->doc, true);
 
-            nb_func_render_signature(fi);
+            complete &= nb_func_render_signature(fi);
             buf.put('\n');
-            if ((fi->flags & (uint32_t) func_flags::has_doc) && fi->doc[0] != '\0')
+            if (((fi->flags & (uint32_t) func_flags::has_doc) && fi->doc[0] != '\0') ||
+                (fi->flags & (uint32_t) func_flags::release_gil))
                 doc_count++;
         }
 
@@ -1011,8 +1669,11 @@ PyObject *nb_func_getattro(PyObject *self, PyObject *name_) {
 
         for (uint32_t i = 0; i < count; ++i) {
             const func_data *fi = f + i;
+            const bool has_doc = (fi->flags & (uint32_t) func_flags::has_doc) &&
+                                 fi->doc[0] != '\0',
+                       release_gil = fi->flags & (uint32_t) func_flags::release_gil;
 
-            if ((fi->flags & (uint32_t) func_flags::has_doc) && fi->doc[0] != '\0') {
+            if (has_doc || release_gil) {
                 buf.put('\n');
 
                 if (doc_count > 1) {
@@ -1022,15 +1683,37 @@ PyObject *nb_func_getattro(PyObject *self, PyObject *name_) {
                     buf.put("``\n\n");
                 }
 
-                buf.put_dstr(fi->doc);
-                buf.put('\n');
+                if (has_doc) {
+                    buf.put_dstr(fi->doc);
+                    buf.put('\n');
+                }
+
+                if (release_gil) {
+                    if (has_doc)
+                        buf.put('\n');
+                    buf.put("Releases the GIL while running.\n");
+                }
             }
         }
 
         if (buf.size() > 0) // remove last newline
             buf.rewind(1);
 
-        return PyUnicode_FromString(buf.get());
+        return nb_func_cache_str(&func->doc, buf.get(), complete);
+    } else if (strcmp(name, "__text_signature__") == 0) {
+        nb_func *func = (nb_func *) self;
+        if (func->text_signature) {
+            Py_INCREF(func->text_signature);
+            return func->text_signature;
+        }
+
+        // Only available for functions that have a single signature
+        if (Py_SIZE(self) == 1 && !(f->flags & (uint32_t) func_flags::raw_doc)) {
+            buf.clear();
+            if (nb_func_render_text_signature(f))
+                return nb_func_cache_str(&func->text_signature, buf.get(),
+                                         true);
+        }
     } else {
         return PyObject_GenericGetAttr(self, name_);
     }
@@ -1039,6 +1722,77 @@ PyObject *nb_func_getattro(PyObject *self, PyObject *name_) {
     return Py_None;
 }
 
+PyObject *func_stats() noexcept {
+    PyObject *result = PyDict_New();
+    if (!result)
+        return nullptr;
+
+    for (const auto &kv : internals_get().funcs) {
+        const nb_func_stats &s = kv.second;
+        if (!s.calls)
+            continue;
+
+        PyObject *entry = Py_BuildValue(
+            "{sKsKsKsKsKsd}",
+            "calls", (unsigned long long) s.calls,
+            "attempts", (unsigned long long) s.attempts,
+            "convert_fallbacks", (unsigned long long) s.convert_fallbacks,
+            "implicit_conversions", (unsigned long long) s.implicit_conversions,
+            "exceptions", (unsigned long long) s.exceptions,
+            "time", (double) s.time_ns * 1e-9);
+
+        if (!entry || PyDict_SetItem(result, (PyObject *) kv.first, entry)) {
+            Py_XDECREF(entry);
+            Py_DECREF(result);
+            return nullptr;
+        }
+
+        Py_DECREF(entry);
+    }
+
+    return result;
+}
+
+void func_stats_reset() noexcept {
+    auto &funcs = internals_get().funcs;
+    for (auto it = funcs.begin(); it != funcs.end(); ++it)
+        it.value() = nb_func_stats();
+}
+
+void func_stats_enable(bool value) noexcept {
+    internals_get().stats_enabled = value;
+}
+
+/// Python binding of nanobind.stats()
+static PyObject *nb_func_stats_get(PyObject *, PyObject *) {
+    return func_stats();
+}
+
+/// Python binding of nanobind.reset_stats()
+static PyObject *nb_func_stats_reset(PyObject *, PyObject *) {
+    func_stats_reset();
+    Py_RETURN_NONE;
+}
+
+/// Python binding of nanobind.enable_stats()
+static PyObject *nb_func_stats_enable(PyObject *, PyObject *value) {
+    int rv = PyObject_IsTrue(value);
+    if (rv < 0)
+        return nullptr;
+    func_stats_enable(rv != 0);
+    Py_RETURN_NONE;
+}
+
+PyMethodDef nb_func_stats_methods[] = {
+    { "stats", nb_func_stats_get, METH_NOARGS,
+      "Return a dictionary mapping nanobind functions to call statistics" },
+    { "reset_stats", nb_func_stats_reset, METH_NOARGS,
+      "Reset the call statistics of all nanobind functions" },
+    { "enable_stats", nb_func_stats_enable, METH_O,
+      "Enable or disable the collection of call statistics" },
+    { nullptr, nullptr, 0, nullptr }
+};
+
 /// Excise a substring from 's'
 static void strexc(char *s, const char *sub) {
     size_t len = strlen(sub);
@@ -1067,5 +1821,19 @@ char *type_name(const std::type_info *t) {
     return name;
 }
 
+void *nb_func_get_capture(PyObject *o, const std::type_info *t) noexcept {
+    if (Py_TYPE(o) != internals_get().nb_func || Py_SIZE(o) != 1)
+        return nullptr;
+
+    func_data *f = nb_func_data(o);
+    if (f->capture_type != t && *f->capture_type != *t)
+        return nullptr;
+
+    if (f->flags & (uint32_t) func_flags::capture_indirect)
+        return f->capture[0];
+    else
+        return (void *) f->capture;
+}
+
 NAMESPACE_END(detail)
 NAMESPACE_END(NB_NAMESPACE)
@@ -9,6 +9,7 @@
 
 #include <nanobind/nanobind.h>
 #include <structmember.h>
+#include <mutex>
 #include "nb_internals.h"
 
 #if defined(__GNUC__) && !defined(__clang__)
@@ -17,7 +18,7 @@
 
 /// Tracks the ABI of nanobind
 #ifndef NB_INTERNALS_VERSION
-#  define NB_INTERNALS_VERSION 2
+#  define NB_INTERNALS_VERSION 4
 #endif
 
 /// On MSVC, debug and release builds are not ABI-compatible!
@@ -68,24 +69,31 @@
 #  define NB_LIMITED_API ""
 #endif
 
-#define NB_INTERNALS_ID "__nb_internals_v" \
+#define NB_ABI_TAG \
     NB_TOSTRING(NB_INTERNALS_VERSION) NB_COMPILER_TYPE NB_STDLIB NB_BUILD_ABI NB_BUILD_TYPE NB_LIMITED_API "__"
 
+#define NB_INTERNALS_ID "__nb_internals_v" NB_ABI_TAG
+
+/// Builtins entry exposing the statistics API to the 'nanobind' Python package
+#define NB_STATS_ID "__nb_stats_v" NB_ABI_TAG
+
 NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
 
 extern int nb_func_traverse(PyObject *, visitproc, void *);
 extern int nb_func_clear(PyObject *);
 extern void nb_func_dealloc(PyObject *);
+extern PyMethodDef nb_func_stats_methods[];
+extern PyMethodDef async_methods[];
 extern int nb_bound_method_traverse(PyObject *, visitproc, void *);
 extern int nb_bound_method_clear(PyObject *);
 extern void nb_bound_method_dealloc(PyObject *);
 extern PyObject *nb_func_getattro(PyObject *, PyObject *);
 extern PyObject *nb_method_descr_get(PyObject *, PyObject *, PyObject *);
 extern int nb_type_setattro(PyObject*, PyObject*, PyObject*);
-extern PyObject *nb_tensor_get(PyObject *, PyObject *);
+extern PyObject *nb_tensor_get(PyObject *, PyObject *, PyObject *);
+extern PyObject *nb_tensor_device(PyObject *, PyObject *);
 extern int nb_tensor_getbuffer(PyObject *exporter, Py_buffer *view, int);
-extern void nb_tensor_releasebuffer(PyObject *, Py_buffer *);
 extern void nb_tensor_dealloc(PyObject *self);
 extern PyObject *nb_tensor_new(PyTypeObject *, PyObject *, PyObject *);
 static PyObject *nb_static_property_get(PyObject *, PyObject *, PyObject *);
@@ -208,7 +216,9 @@ static PyType_Spec nb_static_property_spec = {
 };
 
 static PyMethodDef nb_tensor_methods[] = {
-    { "__dlpack__", (PyCFunction) nb_tensor_get, METH_NOARGS, nullptr },
+    { "__dlpack__", (PyCFunction) (void *) nb_tensor_get,
+      METH_VARARGS | METH_KEYWORDS, nullptr },
+    { "__dlpack_device__", (PyCFunction) nb_tensor_device, METH_NOARGS, nullptr },
     { nullptr, nullptr, 0, nullptr}
 };
 
@@ -218,7 +228,6 @@ static PyType_Slot nb_tensor_slots[] = {
     { Py_tp_new, (void *) nb_tensor_new },
 #if PY_VERSION_HEX >= 0x03090000
     { Py_bf_getbuffer, (void *) nb_tensor_getbuffer },
-    { Py_bf_releasebuffer, (void *) nb_tensor_releasebuffer },
 #endif
     { 0, nullptr }
 };
@@ -264,7 +273,17 @@ int nb_static_property_set(PyObject *self, PyObject *obj, PyObject *value) {
 NB_THREAD_LOCAL current_method current_method_data =
     current_method{ nullptr, nullptr };
 
-static nb_internals *internals_p = nullptr;
+NB_THREAD_LOCAL nb_func_stats *current_func_stats = nullptr;
+
+NB_THREAD_LOCAL internals_tls_cache internals_tls = { nullptr, 0, nullptr };
+
+std::atomic<uint32_t> internals_epoch { 1 };
+
+/// Internals of the main interpreter, released by the Py_AtExit() handler
+static nb_internals *internals_main = nullptr;
+
+/// Serializes internals_make(), which modifies the static type specs above
+static std::mutex internals_make_mutex;
 
 void default_exception_translator(const std::exception_ptr &p, void *) {
     try {
@@ -292,25 +311,153 @@ void default_exception_translator(const std::exception_ptr &p, void *) {
     }
 }
 
-static void internals_cleanup() {
+/// Live instances and keep_alive references of a type, see memory_stats()
+struct memory_type_stats {
+    size_t internal = 0, external = 0, keep_alive = 0;
+};
+
+static PyObject *memory_map_stats(size_t size, size_t buckets) {
+    return Py_BuildValue("{snsnsd}", "size", (Py_ssize_t) size, "buckets",
+                         (Py_ssize_t) buckets, "load_factor",
+                         buckets ? (double) size / (double) buckets : 0.0);
+}
+
+/// Add the entry 'key' -> 'value' (stolen) to 'dict'
+static bool memory_dict_add(PyObject *dict, PyObject *key, PyObject *value) {
+    bool success = value && PyDict_SetItem(dict, key, value) == 0;
+    Py_XDECREF(value);
+    return success;
+}
+
+PyObject *memory_stats() noexcept {
+    nb_internals &internals = internals_get();
+    py_map<PyTypeObject *, memory_type_stats, ptr_hash> types;
+    size_t inst_count = 0, inst_buckets = 0, keep_alive_count = 0,
+           keep_alive_buckets = 0;
+
+    /* Gather the counts while holding the shard locks, Python objects are
+       only created afterwards */
+    for (nb_shard &shard : internals.shards) {
+        nb_lock_guard guard(shard.mutex);
+
+        inst_count += shard.inst_c2p.size();
+        inst_buckets += shard.inst_c2p.bucket_count();
+        keep_alive_count += shard.keep_alive.size();
+        keep_alive_buckets += shard.keep_alive.bucket_count();
+
+        for (const auto &kv : shard.inst_c2p) {
+            nb_inst *inst = kv.second;
+            memory_type_stats &ts = types[Py_TYPE((PyObject *) inst)];
+            if (inst->internal)
+                ts.internal++;
+            else
+                ts.external++;
+            if (inst->keep_alive_slot && nb_inst_keep_alive_slot(inst))
+                ts.keep_alive++;
+        }
+
+        for (const auto &kv : shard.keep_alive)
+            types[Py_TYPE((PyObject *) kv.first)].keep_alive +=
+                kv.second.size();
+    }
+
+    auto &type_c2p = internals.type_c2p.get();
+    PyObject *result = PyDict_New(), *types_py = PyDict_New();
+    bool success = result && types_py;
+
+    for (const auto &kv : types) {
+        if (!success)
+            break;
+        // Instances of Python subclasses use the size of the bound base type
+        size_t size = nb_type_data(kv.first)->size;
+        const memory_type_stats &ts = kv.second;
+        success = memory_dict_add(
+            types_py, (PyObject *) kv.first,
+            Py_BuildValue("{snsnsnsnsn}",
+                          "internal", (Py_ssize_t) ts.internal,
+                          "external", (Py_ssize_t) ts.external,
+                          "internal_bytes", (Py_ssize_t) (ts.internal * size),
+                          "external_bytes", (Py_ssize_t) (ts.external * size),
+                          "keep_alive", (Py_ssize_t) ts.keep_alive));
+    }
+
+    if (success) {
+        const char *names[] = { "types", "inst_c2p", "type_c2p", "keep_alive",
+                                "funcs", "tensor_handles" };
+        PyObject *values[] = {
+            types_py,
+            memory_map_stats(inst_count, inst_buckets),
+            memory_map_stats(type_c2p.size(), type_c2p.bucket_count()),
+            memory_map_stats(keep_alive_count, keep_alive_buckets),
+            PyLong_FromSize_t(internals.funcs.size()),
+            PyLong_FromSize_t(internals.tensor_handle_count.load(
+                std::memory_order_relaxed))
+        };
+        types_py = nullptr;
+
+        for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+            if (success)
+                success = values[i] &&
+                          PyDict_SetItemString(result, names[i], values[i]) == 0;
+            Py_XDECREF(values[i]);
+        }
+    }
+
+    Py_XDECREF(types_py);
+    if (!success) {
+        Py_XDECREF(result);
+        return nullptr;
+    }
+
+    return result;
+}
+
+static PyObject *memory_stats_py(PyObject *, PyObject *) {
+    return memory_stats();
+}
+
+static PyMethodDef internals_methods[] = {
+    { "memory_stats", memory_stats_py, METH_NOARGS,
+      "Return a dictionary describing the live instances, registries, "
+      "functions, and tensors managed by nanobind" },
+    { nullptr, nullptr, 0, nullptr }
+};
+
+static void internals_cleanup(nb_internals *internals_p) {
     bool leak = false;
 
-    if (!internals_p->inst_c2p.empty()) {
-        fprintf(stderr, "nanobind: leaked %zu instances!\n",
-                internals_p->inst_c2p.size());
+    // Invalidate the per-thread caches of internals_get()
+    internals_epoch.fetch_add(1, std::memory_order_relaxed);
+
+    thread_pool_shutdown(*internals_p);
+    async_queue_shutdown(*internals_p);
+
+    /* Immortal instances keep their types (and thereby their functions)
+       alive by design, so the registries must stay in place */
+    if (internals_p->immortal_count.load(std::memory_order_relaxed))
+        return;
+
+    size_t inst_count = 0, keep_alive_count = 0;
+    for (const nb_shard &shard : internals_p->shards) {
+        inst_count += shard.inst_c2p.size();
+        keep_alive_count += shard.keep_alive.size();
+    }
+
+    if (inst_count) {
+        fprintf(stderr, "nanobind: leaked %zu instances!\n", inst_count);
         leak = true;
     }
 
-    if (!internals_p->keep_alive.empty()) {
+    if (keep_alive_count) {
         fprintf(stderr, "nanobind: leaked %zu keep_alive records!\n",
-                internals_p->keep_alive.size());
+                keep_alive_count);
         leak = true;
     }
 
-    if (!internals_p->type_c2p.empty()) {
-        fprintf(stderr, "nanobind: leaked %zu types!\n",
-                internals_p->type_c2p.size());
-        for (const auto &kv : internals_p->type_c2p)
+    auto &type_c2p = internals_p->type_c2p.get();
+    if (!type_c2p.empty()) {
+        fprintf(stderr, "nanobind: leaked %zu types!\n", type_c2p.size());
+        for (const auto &kv : type_c2p)
             fprintf(stderr, " - leaked type \"%s\"\n", kv.second->name);
         leak = true;
     }
@@ -318,32 +465,93 @@ static void internals_cleanup() {
     if (!internals_p->funcs.empty()) {
         fprintf(stderr, "nanobind: leaked %zu functions!\n",
                 internals_p->funcs.size());
-        for (void *f : internals_p->funcs)
+        for (const auto &kv : internals_p->funcs)
             fprintf(stderr, " - leaked function \"%s\"\n",
-                    nb_func_data(f)->name);
+                    nb_func_data(kv.first)->name);
         leak = true;
     }
 
     if (!leak) {
+        for (auto &kv : internals_p->record_formats)
+            free(kv.second);
+        for (nb_field *f : internals_p->fields) {
+            free((char *) f->data.name);
+            free((char *) f->data.doc);
+            delete f;
+        }
+#if NB_TYPE_SLOTS
+        delete[] internals_p->slot_names;
+#endif
         delete internals_p;
-        internals_p = nullptr;
     } else {
         fprintf(stderr, "nanobind: this is likely caused by a reference "
                         "counting issue in the binding code.\n");
     }
 }
 
-static void internals_make() {
+/// Dictionary that publishes the internals of an interpreter
+static PyObject *internals_dict(PyInterpreterState *interp) {
+#if defined(Py_LIMITED_API) && Py_LIMITED_API < 0x03090000
+    // Sub-interpreters are not supported here, see interp_get()
+    (void) interp;
+    return PyEval_GetBuiltins();
+#else
+    /* Unlike the builtins, which are reset before the modules of an
+       interpreter are torn down, this dictionary is cleared afterwards */
+    return PyInterpreterState_GetDict(interp);
+#endif
+}
+
+static void internals_cleanup_main() {
+    internals_cleanup(internals_main);
+    internals_main = nullptr;
+}
+
+#if !defined(Py_LIMITED_API) || Py_LIMITED_API >= 0x03090000
+/// Capsule destructor releasing the internals of a sub-interpreter
+static void internals_capsule_free(PyObject *capsule) {
+    internals_cleanup((nb_internals *) PyCapsule_GetPointer(capsule, nullptr));
+}
+#endif
+
+static nb_internals *internals_make(PyInterpreterState *interp) {
+    std::lock_guard<std::mutex> guard(internals_make_mutex);
     str nb_name("nanobind");
 
-    internals_p = new nb_internals();
+#if defined(Py_LIMITED_API)
+    // The stable ABI can't query the main interpreter, assume it comes first
+    bool is_main = internals_main == nullptr;
+#else
+    bool is_main = interp == PyInterpreterState_Main();
+#endif
 
-    PyObject *capsule = PyCapsule_New(internals_p, nullptr, nullptr);
+#if defined(Py_LIMITED_API) && Py_LIMITED_API < 0x03090000
+    /* The builtins are reset before the modules of an interpreter are torn
+       down, hence the internals of sub-interpreters are never released */
+    void (*capsule_free)(PyObject *) = nullptr;
+#else
+    /* The internals of sub-interpreters are released (and the per-thread
+       caches of internals_get() invalidated) along with the dictionary */
+    void (*capsule_free)(PyObject *) =
+        is_main ? nullptr : internals_capsule_free;
+#endif
+
+    nb_internals *internals_p = new nb_internals();
+    internals_tls = { interp, internals_epoch.load(std::memory_order_relaxed),
+                      internals_p };
+
+    PyObject *capsule = PyCapsule_New(internals_p, nullptr, capsule_free),
+             *dict = internals_dict(interp);
     PyObject *nb_module = PyModule_NewObject(nb_name.ptr());
-    int rv = PyDict_SetItemString(PyEval_GetBuiltins(), NB_INTERNALS_ID, capsule);
-    if (rv || !capsule || !nb_module)
+    if (!capsule || !dict || !nb_module ||
+        PyDict_SetItemString(dict, NB_INTERNALS_ID, capsule) ||
+        PyModule_AddFunctions(nb_module, nb_func_stats_methods) ||
+        PyModule_AddFunctions(nb_module, async_methods) ||
+        PyModule_AddFunctions(nb_module, internals_methods) ||
+        PyDict_SetItemString(PyEval_GetBuiltins(), NB_STATS_ID, nb_module))
         fail("nanobind::detail::internals_make(): allocation failed!");
     Py_DECREF(capsule);
+    Py_DECREF(nb_module);
 
     internals_p->type_basicsize =
         cast<int>(handle(&PyType_Type).attr("__basicsize__"));
@@ -388,9 +596,14 @@ static void internals_make() {
         !internals_p->nb_tensor)
         fail("nanobind::detail::internals_make(): type initialization failed!");
 
+#if NB_TYPE_VECTORCALL
+    // Heap types don't inherit PyType_Type's vectorcall flag (see nb_type_vectorcall())
+    internals_p->nb_type->tp_flags |= Py_TPFLAGS_HAVE_VECTORCALL;
+    internals_p->nb_type->tp_vectorcall_offset = PyType_Type.tp_vectorcall_offset;
+#endif
+
 #if PY_VERSION_HEX < 0x03090000
     internals_p->nb_tensor->tp_as_buffer->bf_getbuffer = nb_tensor_getbuffer;
-    internals_p->nb_tensor->tp_as_buffer->bf_releasebuffer = nb_tensor_releasebuffer;
     internals_p->nb_func->tp_flags |= NB_HAVE_VECTORCALL;
     internals_p->nb_func->tp_vectorcall_offset = offsetof(nb_func, vectorcall);
     internals_p->nb_method->tp_flags |= NB_HAVE_VECTORCALL;
@@ -399,36 +612,57 @@ static void internals_make() {
     internals_p->nb_bound_method->tp_vectorcall_offset = offsetof(nb_bound_method, vectorcall);
 #endif
 
-    register_exception_translator(default_exception_translator, nullptr);
+    register_exception_translator(default_exception_translator, nullptr, nullptr);
 
-    if (Py_AtExit(internals_cleanup))
+    if (!is_main)
+        return internals_p;
+
+    internals_main = internals_p;
+    if (Py_AtExit(internals_cleanup_main))
         fprintf(stderr,
                 "Warning: could not install the nanobind cleanup handler! This "
                 "is needed to check for reference leaks and release remaining "
                 "resources at interpreter shutdown (e.g., to avoid leaks being "
                 "reported by tools like 'valgrind'). If you are a user of a "
                 "python extension library, you can ignore this warning.");
+
+    return internals_p;
 }
 
-static void internals_fetch() {
-    PyObject *capsule =
-        PyDict_GetItemString(PyEval_GetBuiltins(), NB_INTERNALS_ID);
+static nb_internals *internals_fetch(PyInterpreterState *interp) {
+    PyObject *dict = internals_dict(interp),
+             *capsule = dict ? PyDict_GetItemString(dict, NB_INTERNALS_ID)
+                             : nullptr;
+    if (!capsule)
+        return nullptr;
 
-    if (capsule) {
-        internals_p = (nb_internals *) PyCapsule_GetPointer(capsule, nullptr);
-        if (!internals_p)
-            fail("nanobind::detail::internals_fetch(): internal error!");
-        return;
-    }
-
-    internals_make();
+    nb_internals *internals_p =
+        (nb_internals *) PyCapsule_GetPointer(capsule, nullptr);
+    if (!internals_p)
+        fail("nanobind::detail::internals_fetch(): internal error!");
+    return internals_p;
 }
 
-nb_internals &internals_get() noexcept {
+nb_internals &internals_get_slow() noexcept {
+    PyInterpreterState *interp = interp_get();
+    nb_internals *internals_p = internals_fetch(interp);
+
     if (!internals_p)
-        internals_fetch();
+        return *internals_make(interp);
+
+    internals_tls = { interp, internals_epoch.load(std::memory_order_relaxed),
+                      internals_p };
     return *internals_p;
 }
 
+nb_internals *internals_peek() noexcept {
+    const internals_tls_cache &c = internals_tls;
+    if (c.interp == interp_get() &&
+        c.epoch == internals_epoch.load(std::memory_order_relaxed))
+        return c.internals;
+
+    return internals_fetch(interp_get());
+}
+
 NAMESPACE_END(detail)
 NAMESPACE_END(NB_NAMESPACE)
@@ -10,6 +10,12 @@
 #include <tsl/robin_set.h>
 #include <typeindex>
 #include <cstring>
+#include <vector>
+#include <atomic>
+
+#if defined(NB_FREE_THREADED) || defined(Py_GIL_DISABLED)
+#  include <mutex>
+#endif
 
 #if defined(_MSC_VER)
 #  define NB_THREAD_LOCAL __declspec(thread)
@@ -17,10 +23,32 @@
 #  define NB_THREAD_LOCAL __thread
 #endif
 
+/* Bound types are constructed via PyTypeObject::tp_vectorcall, which requires
+   Python 3.9+ and is not part of the stable ABI */
+#if !defined(Py_LIMITED_API) && PY_VERSION_HEX >= 0x03090000
+#  define NB_TYPE_VECTORCALL 1
+#else
+#  define NB_TYPE_VECTORCALL 0
+#endif
+
+/* Operators of bound types directly fill the type's number slots (this
+   requires access to PyTypeObject, which the stable ABI doesn't provide) */
+#if !defined(Py_LIMITED_API)
+#  define NB_TYPE_SLOTS 1
+#else
+#  define NB_TYPE_SLOTS 0
+#endif
+
 
 NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
 
+/// Storage of a getset descriptor created by field_install()
+struct nb_field {
+    PyGetSetDef def;
+    field_data data;
+};
+
 /// Nanobind function metadata (overloads, etc.)
 struct func_data : func_data_prelim<0> {
     arg_data *args;
@@ -55,13 +83,40 @@ struct nb_inst { // usually: 24 bytes
 
     /// Does this instance hold reference to others? (via internals.keep_alive)
     bool clear_keep_alive : 1;
+
+    /**
+     * Is the header followed by an inline keep-alive slot? Non-GC instances
+     * with external storage have one, which holds the first patient (if any)
+     * without a separate 'internals.keep_alive' entry. It is protected by
+     * the mutex of the instance's keep_alive shard.
+     */
+    bool keep_alive_slot : 1;
+
+    /// Is the instance kept alive permanently? (see nb_inst_make_immortal())
+    bool immortal : 1;
 };
 
 static_assert(sizeof(nb_inst) == sizeof(PyObject) + sizeof(void *));
 
-struct nb_enum_supplement {
-    PyObject *name;
-    const char *doc;
+/// Return the inline keep-alive slot of an instance (see 'nb_inst::keep_alive_slot')
+NB_INLINE PyObject *&nb_inst_keep_alive_slot(nb_inst *inst) {
+    return *(PyObject **) (inst + 1);
+}
+
+/// Maximum number of positional arguments that the overload cache can key on
+constexpr size_t NB_FUNC_CACHE_NARGS = 4;
+
+/**
+ * Single-entry overload resolution cache of an 'nb_func'. It remembers the
+ * overload (and dispatch pass) that last succeeded for a given tuple of
+ * positional argument types, which is tried first by later calls.
+ */
+struct nb_func_cache {
+    PyTypeObject *types[NB_FUNC_CACHE_NARGS];
+    uint32_t index;
+    uint8_t nargs;
+    uint8_t pass;
+    bool valid;
 };
 
 /// Python object representing a bound C++ function
@@ -69,13 +124,38 @@ struct nb_func {
     PyObject_VAR_HEAD
     PyObject* (*vectorcall)(PyObject *, PyObject * const*, size_t, PyObject *);
     uint32_t max_nargs_pos;
+
+    /// Estimated temporaries of a call, summed over the overload chain
+    uint32_t ncleanup;
+
     bool complex_call;
+    nb_func_cache cache;
+
+    /// Rendered '__doc__' and '__text_signature__' (once all types are bound)
+    PyObject *doc, *text_signature;
+};
+
+/// Buffer protocol representation of an `nb_tensor`, see nb_tensor_getbuffer()
+struct nb_buffer_info {
+    const char *format;
+    Py_ssize_t itemsize, len;
+    bool c_contig, f_contig;
+    /// 'ndim' shape entries followed by 'ndim' strides (in bytes)
+    Py_ssize_t *shape, *strides;
 };
 
 /// Python object representing a `nb_tensor` (which wraps a DLPack tensor)
 struct nb_tensor {
     PyObject_HEAD
     PyObject *capsule;
+    /// Device of the wrapped tensor, reported by '__dlpack_device__()'
+    int32_t device_type, device_id;
+    /// Export the data as read-only via the buffer protocol?
+    bool readonly;
+    /// Buffer format of record tensors (owned by 'nb_internals::record_formats')
+    const char *format;
+    /// Buffer protocol metadata, computed upon the first request
+    nb_buffer_info *buffer;
 };
 
 /// Python object representing an `nb_method` bound to an instance (analogous to non-public PyMethod_Type)
@@ -102,8 +182,29 @@ struct ptr_hash {
 
 struct ptr_type_hash {
     NB_INLINE size_t
-    operator()(const std::pair<const void *, std::type_index> &value) const {
-        return ptr_hash()(value.first) ^ value.second.hash_code();
+    operator()(const std::pair<const void *, const std::type_info *> &value) const {
+        return ptr_hash()(value.first) ^ ptr_hash()(value.second);
+    }
+};
+
+/// Per-type record of which trampoline methods are overridden in Python
+struct trampoline_entry {
+    const char *name;
+    PyObject *key;
+    uint8_t state; // 0: unknown, 1: overridden, 2: not overridden
+};
+
+struct trampoline_cache {
+    size_t size;
+    size_t epoch; // see trampoline_cache_invalidate()
+    bool inst_dict; // instances have a __dict__ that may contain overrides
+    trampoline_entry entries[1];
+};
+
+struct ptr_pair_hash {
+    NB_INLINE size_t
+    operator()(const std::pair<const void *, const void *> &value) const {
+        return ptr_hash()(value.first) ^ (ptr_hash()(value.second) << 1);
     }
 };
 
@@ -166,9 +267,188 @@ template <typename key, typename value, typename hash = std::hash<key>,
 using py_map =
     tsl::robin_map<key, value, hash, eq, py_allocator<std::pair<key, value>>>;
 
+/**
+ * Native value table of an enumeration (stored in 'type_data::supplement').
+ * Values are keyed by their sign- or zero-extended 64 bit representation and
+ * map to borrowed references of the '(name, doc, instance)' records owned by
+ * the '__entries' dictionary (which keeps them visible to the GC).
+ */
+struct nb_enum_supplement {
+    /// All entries, including those also reachable through 'dense'
+    py_map<uint64_t, PyObject *> entries;
+
+    /// Direct lookup table covering '[dense_min, dense_min + dense_size)'
+    PyObject **dense = nullptr;
+    uint64_t dense_min = 0;
+    size_t dense_size = 0;
+
+    /// Set by nb_enum_put() when 'dense' must be rebuilt
+    bool dirty = false;
+};
+
+/// How tensor_import() converts instances of a Python type into a DLPack capsule
+struct tensor_import_entry {
+    /// Framework-specific 'to_dlpack()' function (owned reference, or NULL)
+    PyObject *to_dlpack;
+
+    /// Does the type provide the '__dlpack__()'/'__dlpack_device__()' methods?
+    bool has_dlpack, has_dlpack_device;
+
+    /// Framework of the type ('tensor_framework' enumeration value)
+    uint8_t framework;
+};
+
 using keep_alive_set =
     py_set<keep_alive_entry, keep_alive_hash, keep_alive_eq>;
 
+/**
+ * When compiled with 'NB_FREE_THREADED' (implied by free-threaded Python
+ * builds that define 'Py_GIL_DISABLED'), the registries of nb_internals no
+ * longer rely on the GIL: instances and keep_alive records are partitioned
+ * into shards with separate locks, and type lookups are lock-free. Otherwise,
+ * there is a single shard and all locking compiles away.
+ */
+#if defined(Py_GIL_DISABLED) && !defined(NB_FREE_THREADED)
+#  define NB_FREE_THREADED
+#endif
+
+#if defined(NB_FREE_THREADED)
+#  define NB_SHARD_COUNT 32
+#else
+#  define NB_SHARD_COUNT 1
+#endif
+
+/// Mutex that detaches the thread state while blocking (if supported)
+struct nb_mutex {
+#if defined(Py_GIL_DISABLED)
+    void lock() { PyMutex_Lock(&m); }
+    void unlock() { PyMutex_Unlock(&m); }
+    PyMutex m { };
+#elif defined(NB_FREE_THREADED)
+    void lock() { m.lock(); }
+    void unlock() { m.unlock(); }
+    std::mutex m;
+#else
+    void lock() { }
+    void unlock() { }
+#endif
+};
+
+/// Scoped lock of a nb_mutex
+struct nb_lock_guard {
+    nb_lock_guard(nb_mutex &m) : m(m) { m.lock(); }
+    ~nb_lock_guard() { m.unlock(); }
+    nb_lock_guard(const nb_lock_guard &) = delete;
+    nb_lock_guard &operator=(const nb_lock_guard &) = delete;
+    nb_mutex &m;
+};
+
+/// Partition of the instance and keep_alive registries, see nb_internals::shard()
+struct nb_shard {
+    /**
+     * Instance pointer -> Python object mapping. The type component refers to
+     * the canonical 'type_data::type' record, which permits comparing and
+     * hashing it by pointer identity.
+     */
+    py_map<std::pair<void *, const std::type_info *>, nb_inst *, ptr_type_hash>
+        inst_c2p;
+
+    /// Dictionary of sets storing keep_alive references
+    py_map<void *, keep_alive_set, ptr_hash> keep_alive;
+
+    /// Protects the above maps
+    nb_mutex mutex;
+};
+
+/**
+ * \brief Map that is read often and changed rarely (e.g. when types are
+ * registered)
+ *
+ * In free-threaded mode, readers access an immutable snapshot without
+ * locking, while 'update()' publishes a modified copy. Superseded snapshots
+ * may still be in use by concurrent readers and are only released along with
+ * the map. Otherwise, the map is updated in place.
+ */
+template <typename Map> struct nb_read_mostly {
+#if defined(NB_FREE_THREADED)
+    nb_read_mostly() : current(new Map()) { }
+    ~nb_read_mostly() {
+        delete current.load(std::memory_order_relaxed);
+        for (Map *m : retired)
+            delete m;
+    }
+
+    /// Current snapshot (the reference must only be used for reading)
+    Map &get() { return *current.load(std::memory_order_acquire); }
+
+    template <typename Func> void update(Func &&func) {
+        nb_lock_guard guard(mutex);
+        Map *prev = current.load(std::memory_order_relaxed),
+            *next = new Map(*prev);
+        func(*next);
+        current.store(next, std::memory_order_release);
+        retired.push_back(prev);
+    }
+
+private:
+    std::atomic<Map *> current;
+    std::vector<Map *> retired;
+    nb_mutex mutex;
+#else
+    Map &get() { return map; }
+    template <typename Func> void update(Func &&func) { func(map); }
+
+private:
+    Map map;
+#endif
+};
+
+/// Per-function dispatch statistics, collected while 'stats_enabled' is set
+struct nb_func_stats {
+    uint64_t calls = 0;                ///< Number of calls
+    uint64_t attempts = 0;             ///< Number of overloads that were tried
+    uint64_t convert_fallbacks = 0;    ///< Calls that needed a second (convert) pass
+    uint64_t implicit_conversions = 0; ///< Successful implicit conversions
+    uint64_t exceptions = 0;           ///< C++ exceptions translated into Python
+    uint64_t time_ns = 0;              ///< Cumulative wall time (incl. nested calls)
+
+    void operator+=(const nb_func_stats &s) {
+        calls += s.calls;
+        attempts += s.attempts;
+        convert_fallbacks += s.convert_fallbacks;
+        implicit_conversions += s.implicit_conversions;
+        exceptions += s.exceptions;
+        time_ns += s.time_ns;
+    }
+};
+
+/// Capacity of the freelist of tensor handles, see tensor_handle_alloc()
+constexpr size_t NB_TENSOR_POOL_SIZE = 32;
+
+/// Size classes (64 B .. 1 MiB) and per-class capacity, see tensor_allocate()
+constexpr size_t NB_TENSOR_STORAGE_CLASSES = 15;
+constexpr size_t NB_TENSOR_STORAGE_POOL_SIZE = 4;
+
+/// Bounded cache of short Python strings, see str_intern()
+constexpr size_t NB_STR_CACHE_SIZE = 1024;
+constexpr size_t NB_STR_CACHE_MAX_LEN = 64;
+
+struct str_cache_entry {
+    PyObject *str;
+    size_t hash;
+};
+
+/// Entry of 'nb_internals::exception_translators_typed'
+struct exception_translator_typed {
+    exception_translator translator;
+    void *payload;
+    size_t untyped;
+};
+
+struct thread_pool;
+struct future_interp;
+struct async_queue;
+
 struct nb_internals {
     /// Registered metaclasses for nanobind classes and enumerations
     PyTypeObject *nb_type, *nb_enum;
@@ -186,21 +466,125 @@ struct nb_internals {
     /// Size fields of PyTypeObject
     int type_basicsize, type_itemsize;
 
-    /// Instance pointer -> Python object mapping
-    py_map<std::pair<void *, std::type_index>, nb_inst *, ptr_type_hash>
-        inst_c2p;
+    /// Registries of instances and keep_alive references, see shard()
+    nb_shard shards[NB_SHARD_COUNT];
 
-    /// C++ type -> Python type mapping
-    py_map<std::type_index, type_data *> type_c2p;
+    /// C++ type -> Python type mapping (by type name, see nb_type_c2p())
+    nb_read_mostly<py_map<std::type_index, type_data *>> type_c2p;
 
-    /// Dictionary of sets storing keep_alive references
-    py_map<void *, keep_alive_set, ptr_hash> keep_alive;
+    /// Cache of 'type_c2p' keyed by 'std::type_info' pointer identity
+    nb_read_mostly<py_map<const std::type_info *, type_data *, ptr_hash>>
+        type_c2p_fast;
+
+    /**
+     * Further 'std::type_info' instances (e.g., from other shared libraries)
+     * in 'type_c2p_fast' that refer to a type besides 'type_data::type', so
+     * that they can be removed along with it. Only accessed while updating
+     * 'type_c2p_fast'.
+     */
+    py_map<const type_data *, std::vector<const std::type_info *>, ptr_hash>
+        type_c2p_alias;
+
+    /// Shard storing the instance registered at, or the keep_alive set of 'p'
+    NB_INLINE nb_shard &shard(void *p) {
+#if NB_SHARD_COUNT > 1
+        // Use the upper bits, the maps within each shard consume the lower ones
+        return shards[ptr_hash()(p) / (SIZE_MAX / NB_SHARD_COUNT + 1)];
+#else
+        (void) p;
+        return shards[0];
+#endif
+    }
+
+    /**
+     * Memoized outcome of implicit conversions keyed by (source Python type,
+     * destination type), see nb_type_get_implicit() for the encoding
+     */
+    py_map<std::pair<const void *, const void *>, int32_t, ptr_pair_hash>
+        implicit_cache;
+
+    /// Freelist of tensor handle blocks for tensors of rank <= 4
+    void *tensor_pool[NB_TENSOR_POOL_SIZE] { };
+    size_t tensor_pool_size = 0;
+
+    /// Number of live tensor handles, see memory_stats()
+    std::atomic<size_t> tensor_handle_count { 0 };
+
+    /// Number of instances marked via nb_inst_make_immortal() (disables the
+    /// leak report, see internals_cleanup())
+    std::atomic<size_t> immortal_count { 0 };
+
+    /// Freelists of tensor storage blocks indexed by size class
+    void *tensor_storage_pool[NB_TENSOR_STORAGE_CLASSES]
+                             [NB_TENSOR_STORAGE_POOL_SIZE] { };
+    size_t tensor_storage_pool_size[NB_TENSOR_STORAGE_CLASSES] { };
+
+    /// Functions converting a DLPack capsule, indexed by 'tensor_framework'
+    PyObject *tensor_from_dlpack[5] { };
+
+    /// NumPy fallback of 'tensor_from_dlpack' (for versions without DLPack)
+    PyObject *tensor_numpy_asarray = nullptr;
 
-    /// nb_func/meth instance list for leak reporting
-    py_set<void *, ptr_hash> funcs;
+    /// 'copyreg.__newobj__' and 'pickle.PickleBuffer', see inst_reduce_ex()
+    PyObject *pickle_newobj = nullptr;
+    PyObject *pickle_buffer = nullptr;
+
+    /// Buffer protocol format strings of record types, see record_register()
+    py_map<std::type_index, char *> record_formats;
+
+    /// Getset descriptor definitions created by field_install()
+    std::vector<nb_field *> fields;
+
+    /// Memoized strategy of tensor_import() for converting a Python type
+    py_map<PyTypeObject *, tensor_import_entry, ptr_hash> tensor_import_cache;
+
+    /**
+     * Heap types referenced by 'implicit_cache' or 'tensor_import_cache' ->
+     * weak reference purging them, see type_cache_watch()
+     */
+    py_map<PyTypeObject *, PyObject *, ptr_hash> cached_types;
+
+    /// nb_func/meth instance list for leak reporting and call statistics
+    py_map<void *, nb_func_stats, ptr_hash> funcs;
+
+    /// Direct-mapped cache of short strings keyed by their content hash
+    str_cache_entry str_cache[NB_STR_CACHE_SIZE] { };
+
+    /// Strings of NB_INTERN() call sites indexed by site (owned references)
+    nb_read_mostly<std::vector<PyObject *>> interned;
+
+    /// Collect per-function call statistics? (see nanobind.stats())
+    bool stats_enabled = false;
 
     /// Registered C++ -> Python exception translators
     std::vector<std::pair<exception_translator, void *>> exception_translators;
+
+    /// Number of translators registered without an exception type
+    size_t exception_translators_untyped = 0;
+
+    /// Translators registered for a specific exception type (also in the list
+    /// above), along with the value of 'exception_translators_untyped' at the
+    /// time of their registration
+    nb_read_mostly<py_map<std::type_index, exception_translator_typed>>
+        exception_translators_typed;
+
+    /// Worker threads shared by all extensions, see parallel_run()
+    thread_pool *pool = nullptr;
+
+    /// Pending asyncio futures of this interpreter, see future_new()
+    future_interp *futures = nullptr;
+
+    /// Calls of asynchronous callbacks created by this interpreter, see
+    /// async_queue_get()
+    async_queue *async_calls = nullptr;
+
+    /// Live instance of each extension module (for reimports), see module_reuse()
+    py_map<PyModuleDef *, PyObject *, ptr_hash> modules;
+
+#if NB_TYPE_SLOTS
+    /// Interned names of the number and comparison slot methods, see nb_slot_init()
+    PyObject **slot_names = nullptr;
+#endif
 };
 
 struct current_method {
@@ -210,15 +594,100 @@ struct current_method {
 
 extern NB_THREAD_LOCAL current_method current_method_data;
 
-extern nb_internals &internals_get() noexcept;
+/// Statistics record of the function call in progress (if stats are enabled)
+extern NB_THREAD_LOCAL nb_func_stats *current_func_stats;
+
+/**
+ * Every interpreter has its own 'nb_internals' instance, which is published
+ * in its state dictionary. Each thread caches the instance used by the
+ * last lookup, keyed by the interpreter state and an epoch that changes
+ * whenever the internals of an interpreter are released.
+ */
+struct internals_tls_cache {
+    PyInterpreterState *interp;
+    uint32_t epoch;
+    nb_internals *internals;
+};
+
+extern NB_THREAD_LOCAL internals_tls_cache internals_tls;
+extern std::atomic<uint32_t> internals_epoch;
+extern nb_internals &internals_get_slow() noexcept;
+
+NB_INLINE PyInterpreterState *interp_get() noexcept {
+#if defined(Py_LIMITED_API) && Py_LIMITED_API < 0x03090000
+    return nullptr; // sub-interpreters are not supported
+#else
+    return PyInterpreterState_Get();
+#endif
+}
+
+#if !defined(Py_LIMITED_API)
+/**
+ * Thread state of the calling thread if it holds the GIL, otherwise nullptr.
+ * Unlike PyGILState_Check(), this also works with sub-interpreters.
+ */
+NB_INLINE PyThreadState *tstate_attached() noexcept {
+#if PY_VERSION_HEX >= 0x030D0000
+    return PyThreadState_GetUnchecked();
+#else
+    /* Older versions may return the thread state that holds the GIL,
+       even if it belongs to another thread */
+    PyThreadState *ts = _PyThreadState_UncheckedGet();
+    return ts && ts->thread_id == PyThread_get_thread_ident() ? ts : nullptr;
+#endif
+}
+#endif
+
+/// Return the internals of the current interpreter (the GIL must be held)
+NB_INLINE nb_internals &internals_get() noexcept {
+    const internals_tls_cache &c = internals_tls;
+    if (c.interp == interp_get() &&
+        c.epoch == internals_epoch.load(std::memory_order_relaxed))
+        return *c.internals;
+    return internals_get_slow();
+}
+
+/// Like internals_get(), but returns nullptr instead of creating the internals
+extern nb_internals *internals_peek() noexcept;
+extern void thread_pool_shutdown(nb_internals &internals) noexcept;
+extern void async_queue_shutdown(nb_internals &internals) noexcept;
+extern type_data *nb_type_c2p_slow(nb_internals &internals,
+                                   const std::type_info *type) noexcept;
+
+/**
+ * \brief Look up the type record of a C++ type
+ *
+ * Hashing 'std::type_index' may hash the mangled type name, hence lookups go
+ * through a cache keyed by pointer identity first. The name-based map only
+ * needs to be consulted for new 'std::type_info' instances (e.g. ones that
+ * originate from another shared library).
+ */
+NB_INLINE type_data *nb_type_c2p(nb_internals &internals,
+                                 const std::type_info *type) noexcept {
+    auto &fast = internals.type_c2p_fast.get();
+    auto it = fast.find(type);
+    if (it != fast.end())
+        return it->second;
+    return nb_type_c2p_slow(internals, type);
+}
 extern char *type_name(const std::type_info *t);
+extern void nb_func_convert_cpp_exception() noexcept;
 
 // Forward declarations
 extern int nb_type_init(PyObject *, PyObject *, PyObject *);
 extern void nb_type_dealloc(PyObject *o);
+extern void implicit_cache_clear(nb_internals &internals) noexcept;
+extern bool type_cache_watch(nb_internals &internals, PyTypeObject *tp) noexcept;
+extern void trampoline_cache_free(type_data *t) noexcept;
+extern void trampoline_cache_invalidate() noexcept;
 extern PyObject *inst_new_impl(PyTypeObject *tp, void *value);
 extern void nb_enum_prepare(PyType_Slot **s, bool is_arithmetic);
+extern PyObject *nb_enum_find(type_data *t, const void *value) noexcept;
+extern void nb_enum_free(type_data *t) noexcept;
 extern int nb_static_property_set(PyObject *, PyObject *, PyObject *);
+extern bool tensor_load_arith(PyObject *o, uint8_t flags, uint8_t code,
+                              size_t size, void *(*resize)(void *, size_t),
+                              void *payload) noexcept;
 
 /// Fetch the nanobind function record from a 'nb_func' instance
 NB_INLINE func_data *nb_func_data(void *o) {
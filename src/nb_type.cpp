@@ -8,6 +8,7 @@
 */
 
 #include "nb_internals.h"
+#include <memory>
 
 #if defined(_MSC_VER)
 #  pragma warning(disable: 4706) // assignment within conditional expression
@@ -50,25 +51,38 @@ static int inst_init(PyObject *self, PyObject *, PyObject *) {
 /// Allocate memory for a nb_type instance with internal or external storage
 PyObject *inst_new_impl(PyTypeObject *tp, void *value) {
     bool gc = PyType_HasFeature(tp, Py_TPFLAGS_HAVE_GC);
-    const type_data *t = nb_type_data(tp);
+    type_data *t = nb_type_data(tp);
     size_t align = (size_t) t->align;
 
     nb_inst *self;
 
-    if (!gc) {
+    if (!gc && !value && t->pool) {
+        // Recycle a block from the type's freelist (see inst_dealloc())
+        self = (nb_inst *) t->pool;
+        t->pool = *(void **) self;
+        t->pool_size--;
+        PyObject_Init((PyObject *) self, tp);
+        self->ready = self->destruct = self->cpp_delete =
+            self->clear_keep_alive = self->keep_alive_slot =
+            self->immortal = false;
+    } else if (!gc) {
         size_t size = sizeof(nb_inst);
         if (!value) {
             // Internal storage: space for the object and padding for alignment
             size += t->size;
             if (align > sizeof(void *))
                 size += align - sizeof(void *);
+        } else {
+            // External storage: space for the inline keep-alive slot
+            size += sizeof(PyObject *);
         }
 
         self = (nb_inst *) PyObject_Malloc(size);
         if (!self)
             return PyErr_NoMemory();
-        memset(self, 0, sizeof(nb_inst));
+        memset(self, 0, value ? size : sizeof(nb_inst));
         PyObject_Init((PyObject *) self, tp);
+        self->keep_alive_slot = value != nullptr;
     } else {
         self = (nb_inst *) PyType_GenericAlloc(tp, 0);
     }
@@ -93,10 +107,14 @@ PyObject *inst_new_impl(PyTypeObject *tp, void *value) {
             self->offset = offset;
             self->direct = true;
         } else {
+            // Offset *not* representable, store a pointer (after the keep-alive slot)
+            size_t pos = sizeof(nb_inst);
+
             if (!gc) {
-                // Offset *not* representable, allocate extra memory for a pointer
-                nb_inst *self_2 =
-                    (nb_inst *) PyObject_Realloc(self, sizeof(nb_inst) + sizeof(void *));
+                pos += sizeof(PyObject *);
+
+                nb_inst *self_2 = (nb_inst *) PyObject_Realloc(
+                    self, pos + sizeof(void *));
 
                 if (!self_2) {
                     PyObject_Free(self);
@@ -106,18 +124,27 @@ PyObject *inst_new_impl(PyTypeObject *tp, void *value) {
                 self = self_2;
             }
 
-            *(void **) (self + 1) = value;
-            self->offset = (int32_t) sizeof(nb_inst);
+            *(void **) ((uint8_t *) self + pos) = value;
+            self->offset = (int32_t) pos;
             self->direct = false;
         }
 
         self->internal = false;
     }
 
+    // Internally stored value types can never be looked up by pointer
+    if (self->internal && (t->flags & (uint32_t) type_flags::is_value_type))
+        return (PyObject *) self;
+
     // Update hash table that maps from C++ to Python instance
-    auto [it, success] = internals_get().inst_c2p.try_emplace(
-        std::pair<void *, std::type_index>(value, *t->type),
-        self);
+    nb_shard &shard = internals_get().shard(value);
+    bool success;
+    {
+        nb_lock_guard guard(shard.mutex);
+        success = shard.inst_c2p.try_emplace(
+            std::pair<void *, const std::type_info *>(value, t->type),
+            self).second;
+    }
 
     if (!success)
         fail("nanobind::detail::inst_new(): duplicate object!");
@@ -130,9 +157,84 @@ PyObject *inst_new(PyTypeObject *type, PyObject *, PyObject *) {
     return inst_new_impl(type, nullptr);
 }
 
+#if NB_TYPE_SLOTS
+static void nb_type_inherit_slots(PyTypeObject *tp) noexcept;
+#endif
+
+#if NB_TYPE_VECTORCALL
+/**
+ * \brief Construct an instance of a bound type: a shortcut over the generic
+ * type.__call__ -> inst_new() -> slot_tp_init() sequence, which performs an
+ * attribute lookup of '__init__' and converts the arguments to a tuple/dict.
+ */
+static PyObject *nb_type_vectorcall(PyObject *self, PyObject *const *args_in,
+                                    size_t nargsf,
+                                    PyObject *kwargs_in) noexcept {
+    PyTypeObject *tp = (PyTypeObject *) self;
+    nb_func *init = (nb_func *) nb_type_data(tp)->init;
+    size_t nargs = NB_VECTORCALL_NARGS(nargsf);
+
+    PyObject *inst = inst_new_impl(tp, nullptr);
+    if (!inst)
+        return nullptr;
+
+    PyObject *result;
+    if (nargsf & NB_VECTORCALL_ARGUMENTS_OFFSET) {
+        PyObject **args_tmp = (PyObject **) args_in - 1;
+        PyObject *tmp = args_tmp[0];
+        args_tmp[0] = inst;
+        result = init->vectorcall((PyObject *) init, args_tmp, nargs + 1, kwargs_in);
+        args_tmp[0] = tmp;
+    } else {
+        PyObject **args_tmp = (PyObject **) PyObject_Malloc((nargs + 1) * sizeof(PyObject *));
+        if (!args_tmp) {
+            Py_DECREF(inst);
+            return PyErr_NoMemory();
+        }
+        args_tmp[0] = inst;
+        for (size_t i = 0; i < nargs; ++i)
+            args_tmp[i + 1] = args_in[i];
+        result = init->vectorcall((PyObject *) init, args_tmp, nargs + 1, kwargs_in);
+        PyObject_Free(args_tmp);
+    }
+
+    if (!result) {
+        Py_DECREF(inst);
+        return nullptr;
+    }
+
+    Py_DECREF(result);
+    return inst;
+}
+
+/**
+ * \brief Enable nb_type_vectorcall() while the type's '__init__' is a bound
+ * overload chain and '__new__' has not been replaced. The cached '__init__'
+ * pointer is borrowed from the type dictionary.
+ */
+static void nb_type_update_vectorcall(PyTypeObject *tp, PyObject *name,
+                                      PyObject *value) noexcept {
+    nb_internals &internals = internals_get();
+    type_data *t = nb_type_data(tp);
+
+    if (Py_TYPE((PyObject *) tp) != internals.nb_type ||
+        (t->flags & (uint32_t) type_flags::is_python_type) ||
+        !PyUnicode_Check(name))
+        return;
+
+    if (PyUnicode_CompareWithASCIIString(name, "__init__") == 0)
+        t->init = value && Py_TYPE(value) == internals.nb_method ? value : nullptr;
+    else if (PyUnicode_CompareWithASCIIString(name, "__new__") != 0)
+        return;
+
+    tp->tp_vectorcall =
+        t->init && tp->tp_new == inst_new ? nb_type_vectorcall : nullptr;
+}
+#endif
+
 static void inst_dealloc(PyObject *self) {
     PyTypeObject *tp = Py_TYPE(self);
-    const type_data *t = nb_type_data(tp);
+    type_data *t = nb_type_data(tp);
 
     bool gc = PyType_HasFeature(tp, Py_TPFLAGS_HAVE_GC);
     if (gc)
@@ -163,16 +265,29 @@ static void inst_dealloc(PyObject *self) {
             operator delete(p, std::align_val_t(t->align));
     }
 
+    /* No lock needed: keep_alive() requires a reference to the nurse, hence
+       it can't run concurrently with its deallocation */
+    if (inst->keep_alive_slot)
+        Py_XDECREF(nb_inst_keep_alive_slot(inst));
+
     nb_internals &internals = internals_get();
     if (inst->clear_keep_alive) {
-        auto it = internals.keep_alive.find(self);
-        if (it == internals.keep_alive.end())
-            fail("nanobind::detail::inst_dealloc(\"%s\"): inconsistent "
-                 "keep_alive information", t->name);
+        keep_alive_set ref_set;
+
+        {
+            nb_shard &shard = internals.shard(self);
+            nb_lock_guard guard(shard.mutex);
 
-        keep_alive_set ref_set = std::move(it.value());
-        internals.keep_alive.erase(it);
+            auto it = shard.keep_alive.find(self);
+            if (it == shard.keep_alive.end())
+                fail("nanobind::detail::inst_dealloc(\"%s\"): inconsistent "
+                     "keep_alive information", t->name);
 
+            ref_set = std::move(it.value());
+            shard.keep_alive.erase(it);
+        }
+
+        // Release the patients without holding the lock (they may be nurses)
         for (keep_alive_entry e: ref_set) {
             if (!e.deleter)
                 Py_DECREF((PyObject *) e.data);
@@ -182,12 +297,17 @@ static void inst_dealloc(PyObject *self) {
     }
 
     // Update hash table that maps from C++ to Python instance
-    auto it = internals.inst_c2p.find(
-        std::pair<void *, std::type_index>(p, *t->type));
-    if (it == internals.inst_c2p.end())
-        fail("nanobind::detail::inst_dealloc(\"%s\"): attempted to delete "
-             "an unknown instance (%p)!", t->name, p);
-    internals.inst_c2p.erase(it);
+    if (!inst->internal || !(t->flags & (uint32_t) type_flags::is_value_type)) {
+        nb_shard &shard = internals.shard(p);
+        nb_lock_guard guard(shard.mutex);
+
+        auto it = shard.inst_c2p.find(
+            std::pair<void *, const std::type_info *>(p, t->type));
+        if (it == shard.inst_c2p.end())
+            fail("nanobind::detail::inst_dealloc(\"%s\"): attempted to delete "
+                 "an unknown instance (%p)!", t->name, p);
+        shard.inst_c2p.erase(it);
+    }
 
     if (gc) {
         #if defined(Py_LIMITED_API)
@@ -198,6 +318,13 @@ static void inst_dealloc(PyObject *self) {
         #endif
 
         tp_free(self);
+    } else if (inst->internal &&
+               (t->flags & (uint32_t) type_flags::is_pooled) &&
+               t->pool_size < t->pool_capacity) {
+        // Push the block onto the type's freelist, the link overlays ob_refcnt
+        *(void **) self = t->pool;
+        t->pool = self;
+        t->pool_size++;
     } else {
         PyObject_Free(self);
     }
@@ -205,26 +332,72 @@ static void inst_dealloc(PyObject *self) {
     Py_DECREF(tp);
 }
 
+size_t nb_type_pool_trim(PyObject *o, size_t keep) noexcept {
+    type_data *t = nb_type_data((PyTypeObject *) o);
+    size_t count = 0;
+
+    while (t->pool && t->pool_size > keep) {
+        void *block = t->pool;
+        t->pool = *(void **) block;
+        t->pool_size--;
+        PyObject_Free(block);
+        count++;
+    }
+
+    return count;
+}
+
 void nb_type_dealloc(PyObject *o) {
     type_data *t = nb_type_data((PyTypeObject *) o);
 
     if (t->type && (t->flags & (uint32_t) type_flags::is_python_type) == 0) {
         nb_internals &internals = internals_get();
-        auto it = internals.type_c2p.find(std::type_index(*t->type));
-        if (it == internals.type_c2p.end())
-            fail("nanobind::detail::nb_type_dealloc(\"%s\"): could not "
-                 "find type!", t->name);
-        internals.type_c2p.erase(it);
+        internals.type_c2p.update([&](auto &type_c2p) {
+            auto it = type_c2p.find(std::type_index(*t->type));
+            if (it == type_c2p.end())
+                fail("nanobind::detail::nb_type_dealloc(\"%s\"): could not "
+                     "find type!", t->name);
+            type_c2p.erase(it);
+        });
+
+        internals.type_c2p_fast.update([&](auto &fast) {
+            fast.erase(t->type);
+
+            auto it2 = internals.type_c2p_alias.find(t);
+            if (it2 != internals.type_c2p_alias.end()) {
+                for (const std::type_info *alias : it2->second)
+                    fast.erase(alias);
+                internals.type_c2p_alias.erase(it2);
+            }
+        });
     }
 
     if (t->flags & (uint32_t) type_flags::has_implicit_conversions) {
         free(t->implicit);
         free(t->implicit_py);
+        free(t->implicit_cast);
+        free(t->implicit_py_cast);
+
+        auto &cache = internals_get().implicit_cache;
+        for (auto it = cache.begin(); it != cache.end(); ) {
+            if (it->first.second == t)
+                it = cache.erase(it);
+            else
+                ++it;
+        }
     }
 
     if (t->flags & (uint32_t) type_flags::has_supplement)
         free(t->supplement);
 
+    if ((t->flags & (uint32_t) type_flags::is_python_type) == 0 &&
+        (t->flags & ((uint32_t) type_flags::is_signed_enum |
+                     (uint32_t) type_flags::is_unsigned_enum)))
+        nb_enum_free(t);
+
+    nb_type_pool_trim(o, 0);
+    trampoline_cache_free(t);
+
     free((char *) t->name);
 
     #if defined(Py_LIMITED_API)
@@ -280,8 +453,16 @@ int nb_type_init(PyObject *self, PyObject *args, PyObject *kwds) {
 
     *t = *t_b;
     t->flags |=  (uint32_t) type_flags::is_python_type;
+    t->init = nullptr;
     t->flags &= ~((uint32_t) type_flags::has_implicit_conversions |
-                  (uint32_t) type_flags::has_supplement);
+                  (uint32_t) type_flags::has_supplement |
+                  (uint32_t) type_flags::is_pooled);
+
+    // Subclasses of enumerations share the value table of their base
+    if (!(t->flags & ((uint32_t) type_flags::is_signed_enum |
+                      (uint32_t) type_flags::is_unsigned_enum)))
+        t->supplement = nullptr;
+
     PyObject *name = nb_type_name((PyTypeObject *) self);
     t->name = NB_STRDUP(PyUnicode_AsUTF8AndSize(name, nullptr));
     Py_DECREF(name);
@@ -290,11 +471,177 @@ int nb_type_init(PyObject *self, PyObject *args, PyObject *kwds) {
     t->base_py = t_b->type_py;
     t->implicit = nullptr;
     t->implicit_py = nullptr;
-    t->supplement = nullptr;
+    t->implicit_cast = nullptr;
+    t->implicit_py_cast = nullptr;
+    t->pool = nullptr;
+    t->pool_size = t->pool_capacity = 0;
+    t->trampoline_cache = nullptr;
+
+#if NB_TYPE_SLOTS
+    nb_type_inherit_slots((PyTypeObject *) self);
+#endif
 
     return 0;
 }
 
+/* Instances of types bound with nb::trivial_pickle expose their bytes via
+   the buffer protocol, which the stable ABI only provides on Python 3.11+ */
+#if !defined(Py_LIMITED_API) || Py_LIMITED_API >= 0x030B0000
+#  define NB_INST_BUFFER 1
+#else
+#  define NB_INST_BUFFER 0
+#endif
+
+/// Return the type data of 'self' if it can be pickled as raw bytes
+static type_data *inst_pickle_check(PyObject *self, const char *func) {
+    type_data *t = nb_type_data(Py_TYPE(self));
+    if (!(t->flags & (uint32_t) type_flags::has_trivial_pickle)) {
+        PyErr_Format(PyExc_TypeError, "%s.%s(): type was not bound with "
+                     "nb::trivial_pickle()!", t->name, func);
+        return nullptr;
+    }
+    return t;
+}
+
+static PyObject *pickle_import(PyObject *&cache, const char *module,
+                               const char *name) {
+    if (!cache) {
+        PyObject *mod = PyImport_ImportModule(module);
+        if (!mod)
+            return nullptr;
+        PyObject *value = PyObject_GetAttrString(mod, name);
+        Py_DECREF(mod);
+        if (!value)
+            return nullptr;
+        cache = value;
+    }
+    return cache;
+}
+
+/**
+ * \brief __reduce_ex__() of types bound with nb::trivial_pickle
+ *
+ * Instances are restored via 'copyreg.__newobj__(cls)' followed by
+ * inst_setstate() with the raw bytes of the instance. Pickle protocol 5 and
+ * newer receive a 'pickle.PickleBuffer' referencing the instance, which can
+ * be transferred out-of-band.
+ */
+static PyObject *inst_reduce_ex(PyObject *self, PyObject *protocol_o) {
+    type_data *t = inst_pickle_check(self, "__reduce_ex__");
+    if (!t)
+        return nullptr;
+
+    long protocol = PyLong_AsLong(protocol_o);
+    if (protocol == -1 && PyErr_Occurred())
+        return nullptr;
+
+    nb_inst *inst = (nb_inst *) self;
+    if (!inst->ready) {
+        PyErr_Format(PyExc_TypeError, "%s.__reduce_ex__(): the instance is "
+                     "not initialized!", t->name);
+        return nullptr;
+    }
+
+    nb_internals &internals = internals_get();
+    PyObject *newobj = pickle_import(internals.pickle_newobj, "copyreg",
+                                     "__newobj__"),
+             *state;
+    if (!newobj)
+        return nullptr;
+
+#if NB_INST_BUFFER
+    if (protocol >= 5) {
+        PyObject *pickle_buffer = pickle_import(internals.pickle_buffer,
+                                                "pickle", "PickleBuffer");
+        if (!pickle_buffer)
+            return nullptr;
+        state = PyObject_CallFunctionObjArgs(pickle_buffer, self, nullptr);
+    } else
+#endif
+    {
+        state = PyBytes_FromStringAndSize((const char *) inst_ptr(inst),
+                                          (Py_ssize_t) t->size);
+    }
+
+    if (!state)
+        return nullptr;
+
+    return Py_BuildValue("O(O)N", newobj, (PyObject *) Py_TYPE(self), state);
+}
+
+/// __setstate__() of types bound with nb::trivial_pickle, see inst_reduce_ex()
+static PyObject *inst_setstate(PyObject *self, PyObject *state) {
+    type_data *t = inst_pickle_check(self, "__setstate__");
+    if (!t)
+        return nullptr;
+
+    nb_inst *inst = (nb_inst *) self;
+    if (inst->ready) {
+        PyErr_Format(PyExc_TypeError, "%s.__setstate__(): the instance is "
+                     "already initialized!", t->name);
+        return nullptr;
+    }
+
+#if NB_INST_BUFFER
+    Py_buffer view;
+    if (PyObject_GetBuffer(state, &view, PyBUF_SIMPLE))
+        return nullptr;
+    const void *buf = view.buf;
+    Py_ssize_t size = view.len;
+#else
+    char *buf;
+    Py_ssize_t size;
+    if (PyBytes_AsStringAndSize(state, &buf, &size))
+        return nullptr;
+#endif
+
+    bool success = size == (Py_ssize_t) t->size;
+    if (success) {
+        memcpy(inst_ptr(inst), buf, t->size);
+        inst->ready = inst->destruct = true;
+    }
+
+#if NB_INST_BUFFER
+    PyBuffer_Release(&view);
+#endif
+
+    if (!success) {
+        PyErr_Format(PyExc_ValueError, "%s.__setstate__(): expected %u bytes, "
+                     "got %zd!", t->name, (unsigned) t->size, size);
+        return nullptr;
+    }
+
+    Py_RETURN_NONE;
+}
+
+#if NB_INST_BUFFER
+/// Read-only view of the raw bytes of an instance bound with nb::trivial_pickle
+static int inst_getbuffer(PyObject *self, Py_buffer *view, int flags) {
+    nb_inst *inst = (nb_inst *) self;
+    type_data *t = inst_pickle_check(self, "__buffer__");
+
+    if (t && !inst->ready) {
+        PyErr_Format(PyExc_BufferError, "%s: the instance is not "
+                     "initialized!", t->name);
+        t = nullptr;
+    }
+
+    if (!t) {
+        view->obj = nullptr;
+        return -1;
+    }
+
+    return PyBuffer_FillInfo(view, self, inst_ptr(inst), (Py_ssize_t) t->size,
+                             1, flags);
+}
+#endif
+
+static PyMethodDef inst_pickle_methods[] = {
+    { "__reduce_ex__", (PyCFunction) inst_reduce_ex, METH_O, nullptr },
+    { "__setstate__", (PyCFunction) inst_setstate, METH_O, nullptr },
+    { nullptr, nullptr, 0, nullptr }
+};
+
 /// Called when a C++ type is bound via nb::class_<>
 PyObject *nb_type_new(const type_data *t) noexcept {
     bool is_signed_enum    = t->flags & (uint32_t) type_flags::is_signed_enum,
@@ -308,6 +655,7 @@ PyObject *nb_type_new(const type_data *t) noexcept {
          has_type_callback = t->flags & (uint32_t) type_flags::has_type_callback,
          has_supplement    = t->flags & (uint32_t) type_flags::has_supplement,
          has_dynamic_attr  = t->flags & (uint32_t) type_flags::has_dynamic_attr,
+         has_trivial_pickle = t->flags & (uint32_t) type_flags::has_trivial_pickle,
          intrusive_ptr     = t->flags & (uint32_t) type_flags::intrusive_ptr;
 
     nb_internals &internals = internals_get();
@@ -345,17 +693,21 @@ PyObject *nb_type_new(const type_data *t) noexcept {
                  "specified!", t->name);
         base = (PyObject *) t->base_py;
     } else if (has_base) {
-        auto it = internals.type_c2p.find(std::type_index(*t->base));
-        if (it == internals.type_c2p.end())
+        type_data *t_base = nb_type_c2p(internals, t->base);
+        if (!t_base)
             fail("nanobind::detail::nb_type_new(\"%s\"): base type \"%s\" not "
                  "known to nanobind!", t->name, type_name(t->base));
-        base = (PyObject *) it->second->type_py;
+        base = (PyObject *) t_base->type_py;
     }
 
     type_data *tb = nullptr;
     if (base) {
         // Check if the base type already has dynamic attributes
         tb = nb_type_data((PyTypeObject *) base);
+        if (tb->flags & (uint32_t) type_flags::is_final)
+            fail("nanobind::detail::nb_type_new(\"%s\"): base type \"%s\" "
+                 "was declared with nb::is_final()!", t->name, tb->name);
+
         if (tb->flags & (uint32_t) type_flags::has_dynamic_attr)
             has_dynamic_attr = true;
 
@@ -395,6 +747,16 @@ PyObject *nb_type_new(const type_data *t) noexcept {
     if (is_enum)
         nb_enum_prepare(&s, is_arithmetic);
 
+    if (has_trivial_pickle) {
+        if (is_enum)
+            fail("nanobind::detail::nb_type_new(\"%s\"): enumerations cannot "
+                 "be combined with nb::trivial_pickle()!", t->name);
+        *s++ = { Py_tp_methods, (void *) inst_pickle_methods };
+#if NB_INST_BUFFER
+        *s++ = { Py_bf_getbuffer, (void *) inst_getbuffer };
+#endif
+    }
+
     for (PyType_Slot *ts = slots; ts != s; ++ts) {
         if (ts->slot == Py_tp_traverse ||
             ts->slot == Py_tp_clear)
@@ -508,11 +870,22 @@ PyObject *nb_type_new(const type_data *t) noexcept {
 
     to->name = name_copy;
     to->type_py = (PyTypeObject *) result;
+    to->pool = nullptr;
+    to->pool_size = 0;
+    if (!(t->flags & (uint32_t) type_flags::is_pooled))
+        to->pool_capacity = 0;
+    to->trampoline_cache = nullptr;
+    to->init = nullptr;
 
     if (has_supplement) {
+        if (is_enum)
+            fail("nanobind::detail::nb_type_new(\"%s\"): enumerations cannot "
+                 "have supplemental data!", t->name);
         if (!to->supplement)
             fail("nanobind::detail::nb_type_new(\"%s\"): supplemental data "
                  "allocation failed!", t->name);
+    } else if (is_enum) {
+        to->supplement = new nb_enum_supplement();
     } else {
         to->supplement = nullptr;
     }
@@ -533,82 +906,268 @@ PyObject *nb_type_new(const type_data *t) noexcept {
         setattr(result, "__module__", modname.ptr());
 
     // Update hash table that maps from std::type_info to Python type
-    auto [it, success] =
-        internals.type_c2p.try_emplace(std::type_index(*t->type), to);
+    bool success = true;
+    internals.type_c2p.update([&](auto &type_c2p) {
+        success = type_c2p.try_emplace(std::type_index(*t->type), to).second;
+    });
     if (!success)
         fail("nanobind::detail::nb_type_new(\"%s\"): type was already "
              "registered!", t->name);
+    internals.type_c2p_fast.update([&](auto &fast) { fast[t->type] = to; });
 
     return result;
 }
 
 /// Encapsulates the implicit conversion part of nb_type_get()
+/**
+ * Codes stored in 'nb_internals::implicit_cache': values >= 0 refer to the
+ * predicate that succeeded last, values <= implicit_cache_cpp to the C++
+ * source type at index 'implicit_cache_cpp - code'.
+ */
+constexpr int32_t implicit_cache_none = -1; ///< No C++ source type matches
+constexpr int32_t implicit_cache_cpp = -2;  ///< First C++ source type matches
+
+static PyObject *type_cache_callback(PyObject *, PyObject *const *args,
+                                     Py_ssize_t nargs) {
+    if (nargs != 1 || !PyWeakref_CheckRefExact(args[0]))
+        fail("nanobind::detail::type_cache_callback(): invalid input!");
+
+    nb_internals &internals = internals_get();
+    PyTypeObject *tp = nullptr;
+    for (auto [k, v] : internals.cached_types) {
+        if (v == args[0]) {
+            tp = k;
+            break;
+        }
+    }
+
+    if (tp) {
+        internals.cached_types.erase(tp);
+        auto &cache = internals.implicit_cache;
+        for (auto it = cache.begin(); it != cache.end(); ) {
+            if (it->first.first == tp)
+                it = cache.erase(it);
+            else
+                ++it;
+        }
+
+        auto it = internals.tensor_import_cache.find(tp);
+        if (it != internals.tensor_import_cache.end()) {
+            Py_XDECREF(it->second.to_dlpack);
+            internals.tensor_import_cache.erase(it);
+        }
+    }
+
+    Py_DECREF(args[0]);
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyMethodDef type_cache_callback_def = {
+    "type_cache_callback",
+    (PyCFunction) (void *) type_cache_callback,
+    METH_FASTCALL,
+    "Implementation detail of nanobind::detail::type_cache_watch"
+};
+
+/**
+ * Heap types can be destroyed and their address reused. Before memoizing
+ * anything keyed by such a type, this function installs a weak reference that
+ * purges the entries again when that happens. Returns 'false' when the type
+ * cannot be watched, in which case nothing should be cached.
+ */
+bool type_cache_watch(nb_internals &internals, PyTypeObject *tp) noexcept {
+    if (!PyType_HasFeature(tp, Py_TPFLAGS_HEAPTYPE) ||
+        internals.cached_types.find(tp) != internals.cached_types.end())
+        return true;
+
+    PyObject *callback = PyCFunction_New(&type_cache_callback_def, nullptr);
+    PyObject *weakref =
+        callback ? PyWeakref_NewRef((PyObject *) tp, callback) : nullptr;
+    Py_XDECREF(callback);
+
+    if (!weakref) {
+        PyErr_Clear();
+        return false;
+    }
+
+    internals.cached_types[tp] = weakref;
+    return true;
+}
+
+/// Memoize the outcome of an implicit conversion from a given Python type
+static void implicit_cache_put(nb_internals &internals, PyTypeObject *tp,
+                               const type_data *dst_type, int32_t code) {
+    if (!type_cache_watch(internals, tp))
+        return;
+
+    internals.implicit_cache[std::pair<const void *, const void *>(tp, dst_type)] = code;
+}
+
+void implicit_cache_clear(nb_internals &internals) noexcept {
+    internals.implicit_cache.clear();
+}
+
+/// Construct a new instance of 'dst_type' using a direct C++ conversion
+static PyObject *implicit_construct(const type_data *dst_type,
+                                    bool (*cast)(void *, PyObject *,
+                                                 cleanup_list *),
+                                    PyObject *src, cleanup_list *cleanup,
+                                    bool &error) noexcept {
+    PyObject *result = inst_new_impl(dst_type->type_py, nullptr);
+    if (!result) {
+        PyErr_Clear();
+        error = true;
+        return nullptr;
+    }
+
+    nb_inst *inst = (nb_inst *) result;
+    bool success = false;
+    try {
+        success = cast(inst_ptr(inst), src, cleanup);
+    } catch (...) {
+        error = true;
+    }
+
+    if (!success) {
+        Py_DECREF(result);
+        return nullptr;
+    }
+
+    inst->destruct = true;
+    inst->ready = true;
+    if (dst_type->flags & (uint32_t) type_flags::intrusive_ptr)
+        dst_type->set_self_py(inst_ptr(inst), result);
+
+    return result;
+}
+
+/// Check whether predicate 'i' accepts 'src' (constructing 'result' if possible)
+static bool implicit_try_py(const type_data *dst_type, int32_t i, PyObject *src,
+                            cleanup_list *cleanup, PyObject *&result,
+                            bool &error) noexcept {
+    bool (*cast)(void *, PyObject *, cleanup_list *) =
+        dst_type->implicit_py_cast[i];
+
+    if (cast) {
+        result = implicit_construct(dst_type, cast, src, cleanup, error);
+        return result || error;
+    }
+
+    return dst_type->implicit_py[i](dst_type->type_py, src, cleanup);
+}
+
 static NB_NOINLINE bool nb_type_get_implicit(PyObject *src,
                                              const std::type_info *cpp_type_src,
                                              const type_data *dst_type,
                                              nb_internals &internals,
                                              cleanup_list *cleanup, void **out) {
-    if (dst_type->implicit && cpp_type_src) {
+    PyTypeObject *tp = Py_TYPE(src);
+    int32_t hint = implicit_cache_none, code = implicit_cache_none;
+    bool check_cpp = true, error = false;
+    PyObject *result = nullptr;
+
+    auto cache_it = internals.implicit_cache.find(
+        std::pair<const void *, const void *>(tp, dst_type));
+    bool cached = cache_it != internals.implicit_cache.end();
+
+    // Note: conversions may recurse and invalidate 'cache_it'
+    if (cached) {
+        hint = code = cache_it->second;
+        if (code <= implicit_cache_cpp)
+            goto found;
+
+        // Predicates depend on the value, try the one that matched last time
+        check_cpp = false;
+        if (code >= 0 &&
+            implicit_try_py(dst_type, code, src, cleanup, result, error))
+            goto found;
+    }
+
+    if (check_cpp && dst_type->implicit && cpp_type_src) {
         const std::type_info **it = dst_type->implicit;
         const std::type_info *v;
 
-        while ((v = *it++)) {
-            if (v == cpp_type_src || *v == *cpp_type_src)
+        for (int32_t i = 0; (v = it[i]); ++i) {
+            if (v == cpp_type_src || *v == *cpp_type_src) {
+                code = implicit_cache_cpp - i;
                 goto found;
+            }
         }
 
-        it = dst_type->implicit;
-        while ((v = *it++)) {
-            auto it2 = internals.type_c2p.find(std::type_index(*v));
-            if (it2 != internals.type_c2p.end() &&
-                PyType_IsSubtype(Py_TYPE(src), it2->second->type_py))
+        for (int32_t i = 0; (v = it[i]); ++i) {
+            type_data *td = nb_type_c2p(internals, v);
+            if (td && PyType_IsSubtype(tp, td->type_py)) {
+                code = implicit_cache_cpp - i;
                 goto found;
+            }
         }
     }
 
     if (dst_type->implicit_py) {
-        bool (**it)(PyTypeObject *, PyObject *, cleanup_list *) noexcept =
-            dst_type->implicit_py;
-        bool (*v2)(PyTypeObject *, PyObject *, cleanup_list *) noexcept;
-
-        while ((v2 = *it++)) {
-            if (v2(dst_type->type_py, src, cleanup))
+        for (int32_t i = 0; dst_type->implicit_py[i]; ++i) {
+            if (i == hint)
+                continue;
+            if (implicit_try_py(dst_type, i, src, cleanup, result, error)) {
+                code = i;
                 goto found;
+            }
         }
     }
 
+    // Keep the most recent predicate hint if there is one
+    if (!cached)
+        implicit_cache_put(internals, tp, dst_type, implicit_cache_none);
+
     return false;
 
 found:
-
-    PyObject *result;
+    if (code != hint)
+        implicit_cache_put(internals, tp, dst_type, code);
+
+    if (!result && !error) {
+        bool (*cast)(void *, PyObject *, cleanup_list *) =
+            code < 0 ? dst_type->implicit_cast[implicit_cache_cpp - code]
+                     : nullptr;
+
+        if (cast) {
+            result = implicit_construct(dst_type, cast, src, cleanup, error);
+            if (!result)
+                error = true;
+        } else {
 #if PY_VERSION_HEX < 0x03090000 || defined(Py_LIMITED_API)
-    PyObject *args = PyTuple_New(1);
-    if (!args) {
-        PyErr_Clear();
-        return false;
-    }
-    Py_INCREF(src);
-    NB_TUPLE_SET_ITEM(args, 0, src);
-    result = PyObject_CallObject((PyObject *) dst_type->type_py, args);
-    Py_DECREF(args);
+            PyObject *args = PyTuple_New(1);
+            if (!args) {
+                PyErr_Clear();
+                return false;
+            }
+            Py_INCREF(src);
+            NB_TUPLE_SET_ITEM(args, 0, src);
+            result = PyObject_CallObject((PyObject *) dst_type->type_py, args);
+            Py_DECREF(args);
 #else
-    PyObject *args[2] = { nullptr, src };
-    result = PyObject_Vectorcall((PyObject *) dst_type->type_py, args + 1,
-                                 NB_VECTORCALL_ARGUMENTS_OFFSET + 1, nullptr);
+            PyObject *args[2] = { nullptr, src };
+            result = PyObject_Vectorcall((PyObject *) dst_type->type_py, args + 1,
+                                         NB_VECTORCALL_ARGUMENTS_OFFSET + 1, nullptr);
 #endif
+            if (!result) {
+                PyErr_Clear();
+                error = true;
+            }
+        }
+    }
 
     if (result) {
         cleanup->append(result);
         *out = inst_ptr((nb_inst *) result);
+        if (current_func_stats)
+            current_func_stats->implicit_conversions++;
         return true;
     } else {
-        PyErr_Clear();
-
         PyObject *name = nb_inst_name(src);
         PyErr_WarnFormat(PyExc_RuntimeWarning, 1,
                          "nanobind: implicit conversion from type '%U' "
-                         "to type '%s' failed!", dst_type->name);
+                         "to type '%s' failed!", name, dst_type->name);
         Py_DECREF(name);
 
         return false;
@@ -641,12 +1200,16 @@ bool nb_type_get(const std::type_info *cpp_type, PyObject *src, uint8_t flags,
         // Check if the source / destination typeid are an exact match
         bool valid = cpp_type == cpp_type_src || *cpp_type == *cpp_type_src;
 
-        // If not, look up the Python type and check the inheritance chain
+        /* If not, look up the Python type and check the inheritance chain.
+           Final types have no subtypes, which makes an exact match the only
+           possibility. */
         if (!valid) {
-            auto it = internals.type_c2p.find(std::type_index(*cpp_type));
-            if (it != internals.type_c2p.end()) {
-                dst_type = it->second;
-                valid = PyType_IsSubtype(src_type, dst_type->type_py);
+            dst_type = nb_type_c2p(internals, cpp_type);
+            if (dst_type) {
+                if (dst_type->flags & (uint32_t) type_flags::is_final)
+                    valid = src_type == dst_type->type_py;
+                else
+                    valid = PyType_IsSubtype(src_type, dst_type->type_py);
             }
         }
 
@@ -671,11 +1234,8 @@ bool nb_type_get(const std::type_info *cpp_type, PyObject *src, uint8_t flags,
 
     // Try an implicit conversion as last resort (if possible & requested)
     if ((flags & (uint16_t) cast_flags::convert) && cleanup) {
-        if (!src_is_nb_type) {
-            auto it = internals.type_c2p.find(std::type_index(*cpp_type));
-            if (it != internals.type_c2p.end())
-                dst_type = it->second;
-        }
+        if (!src_is_nb_type)
+            dst_type = nb_type_c2p(internals, cpp_type);
 
         if (dst_type &&
             (dst_type->flags & (uint32_t) type_flags::has_implicit_conversions))
@@ -715,8 +1275,24 @@ void keep_alive(PyObject *nurse, PyObject *patient) noexcept {
     PyTypeObject *metaclass = Py_TYPE((PyObject *) Py_TYPE(nurse));
 
     if (metaclass == internals.nb_type || metaclass == internals.nb_enum) {
+        nb_inst *inst = (nb_inst *) nurse;
+        nb_shard &shard = internals.shard(nurse);
+        nb_lock_guard guard(shard.mutex);
+
+        // Store the first patient in the inline slot if there is one
+        if (inst->keep_alive_slot) {
+            PyObject *&slot = nb_inst_keep_alive_slot(inst);
+            if (!slot) {
+                Py_INCREF(patient);
+                slot = patient;
+                return;
+            } else if (slot == patient) {
+                return;
+            }
+        }
+
         // Populate nanobind-internal data structures
-        keep_alive_set &keep_alive = internals.keep_alive[nurse];
+        keep_alive_set &keep_alive = shard.keep_alive[nurse];
 
         auto [it, success] = keep_alive.emplace(patient);
         if (success) {
@@ -754,7 +1330,9 @@ void keep_alive(PyObject *nurse, void *payload,
     nb_internals &internals = internals_get();
 
     if (metaclass == internals.nb_type || metaclass == internals.nb_enum) {
-        keep_alive_set &keep_alive = internals.keep_alive[nurse];
+        nb_shard &shard = internals.shard(nurse);
+        nb_lock_guard guard(shard.mutex);
+        keep_alive_set &keep_alive = shard.keep_alive[nurse];
         auto [it, success] = keep_alive.emplace(payload, callback);
         if (!success)
             raise("keep_alive(): the given 'payload' pointer was already registered!");
@@ -766,37 +1344,73 @@ void keep_alive(PyObject *nurse, void *payload,
     }
 }
 
-PyObject *nb_type_put(const std::type_info *cpp_type, void *value,
-                      rv_policy rvp, cleanup_list *cleanup,
-                      bool *is_new) noexcept {
-    // Convert nullptr -> None
-    if (!value) {
-        Py_INCREF(Py_None);
-        return Py_None;
-    }
-
-    // Check if the instance is already registered with nanobind
+void *keep_alive_find(PyObject *nurse,
+                      void (*deleter)(void *) noexcept) noexcept {
     nb_internals &internals = internals_get();
-    auto it = internals.inst_c2p.find(
-        std::pair<void *, std::type_index>(value, *cpp_type));
-    if (it != internals.inst_c2p.end() && rvp != rv_policy::copy) {
-        PyObject *result = (PyObject *) it->second;
-        Py_INCREF(result);
-        return result;
-    } else if (rvp == rv_policy::none) {
+    PyTypeObject *metaclass = Py_TYPE((PyObject *) Py_TYPE(nurse));
+
+    if ((metaclass != internals.nb_type && metaclass != internals.nb_enum) ||
+        !((nb_inst *) nurse)->clear_keep_alive)
+        return nullptr;
+
+    nb_shard &shard = internals.shard(nurse);
+    nb_lock_guard guard(shard.mutex);
+
+    auto it = shard.keep_alive.find(nurse);
+    if (it == shard.keep_alive.end())
         return nullptr;
+
+    for (const keep_alive_entry &entry : it->second) {
+        if (entry.deleter == deleter)
+            return entry.data;
     }
 
-    // Look up the corresponding type
-    auto it2 = internals.type_c2p.find(std::type_index(*cpp_type));
-    if (it2 == internals.type_c2p.end())
+    return nullptr;
+}
+
+void shared_ptr_delete(void *p) noexcept {
+    delete (std::shared_ptr<void> *) p;
+}
+
+void weak_ptr_delete(void *p) noexcept {
+    delete (std::weak_ptr<void> *) p;
+}
+
+/// Shared implementation of nb_type_put() and nb_type_put_n()
+static PyObject *nb_type_put_impl(nb_internals &internals, type_data *t,
+                                  void *value, rv_policy rvp,
+                                  cleanup_list *cleanup, bool *is_new,
+                                  bool lookup) noexcept {
+    // Enumeration values map to the unique instance created by nb_enum_put()
+    if (t->flags & ((uint32_t) type_flags::is_signed_enum |
+                    (uint32_t) type_flags::is_unsigned_enum)) {
+        PyObject *result = nb_enum_find(t, value);
+        if (result) {
+            Py_INCREF(result);
+            return result;
+        }
+    }
+
+    if (lookup && rvp != rv_policy::copy) {
+        nb_shard &shard = internals.shard(value);
+        nb_lock_guard guard(shard.mutex);
+
+        auto it = shard.inst_c2p.find(
+            std::pair<void *, const std::type_info *>(value, t->type));
+        if (it != shard.inst_c2p.end()) {
+            PyObject *result = (PyObject *) it->second;
+            Py_INCREF(result);
+            return result;
+        }
+    }
+
+    if (rvp == rv_policy::none)
         return nullptr;
 
     // The reference_internals RVP needs a self pointer, give up if unavailable
     if (rvp == rv_policy::reference_internal && (!cleanup || !cleanup->self()))
         return nullptr;
 
-    type_data *t = it2->second;
     const bool intrusive = t->flags & (uint32_t) type_flags::intrusive_ptr;
     if (intrusive)
         rvp = rv_policy::take_ownership;
@@ -867,6 +1481,73 @@ PyObject *nb_type_put(const std::type_info *cpp_type, void *value,
     return (PyObject *) inst;
 }
 
+PyObject *nb_type_put(const std::type_info *cpp_type, void *value,
+                      rv_policy rvp, cleanup_list *cleanup,
+                      bool *is_new) noexcept {
+    // Convert nullptr -> None
+    if (!value) {
+        Py_INCREF(Py_None);
+        return Py_None;
+    }
+
+    // Look up the corresponding type
+    nb_internals &internals = internals_get();
+    type_data *t = nb_type_c2p(internals, cpp_type);
+    if (!t)
+        return nullptr;
+
+    /* Check if the instance is already registered with nanobind. Value types
+       that are copied or moved always produce a new instance. */
+    bool lookup = !(t->flags & (uint32_t) type_flags::is_value_type) ||
+                  (rvp != rv_policy::copy && rvp != rv_policy::move);
+
+    return nb_type_put_impl(internals, t, value, rvp, cleanup, is_new, lookup);
+}
+
+PyObject *nb_type_put_n(const std::type_info *cpp_type, void *values,
+                        size_t stride, size_t count, rv_policy rvp,
+                        cleanup_list *cleanup) noexcept {
+    nb_internals &internals = internals_get();
+    type_data *t = nb_type_c2p(internals, cpp_type);
+    if (!t)
+        return nullptr;
+
+    PyObject *list = PyList_New((Py_ssize_t) count);
+    if (!list)
+        return nullptr;
+
+    const bool intrusive = t->flags & (uint32_t) type_flags::intrusive_ptr,
+               store_in_obj = rvp == rv_policy::copy || rvp == rv_policy::move;
+
+    // Same identity semantics as nb_type_put()
+    bool lookup = !(t->flags & (uint32_t) type_flags::is_value_type) ||
+                  !store_in_obj;
+
+    if (!store_in_obj || intrusive ||
+        !(t->flags & (uint32_t) type_flags::is_value_type)) {
+        for (nb_shard &shard : internals.shards) {
+            nb_lock_guard guard(shard.mutex);
+            shard.inst_c2p.reserve(shard.inst_c2p.size() +
+                                   count / NB_SHARD_COUNT);
+        }
+    }
+
+    uint8_t *p = (uint8_t *) values;
+    for (size_t i = 0; i < count; ++i, p += stride) {
+        PyObject *o =
+            nb_type_put_impl(internals, t, p, rvp, cleanup, nullptr, lookup);
+
+        if (!o) {
+            Py_DECREF(list);
+            return nullptr;
+        }
+
+        NB_LIST_SET_ITEM(list, (Py_ssize_t) i, o);
+    }
+
+    return list;
+}
+
 PyObject *nb_type_put_unique(const std::type_info *cpp_type, void *value,
                              cleanup_list *cleanup, bool cpp_delete) noexcept {
     rv_policy policy = cpp_delete ? rv_policy::take_ownership : rv_policy::none;
@@ -934,6 +1615,289 @@ void nb_type_relinquish_ownership(PyObject *o, bool cpp_delete) {
     inst->ready = false;
 }
 
+#if NB_TYPE_SLOTS
+/**
+ * Operators defined via nb::self (and any other function named like a number
+ * slot or comparison) are dispatched by the following slot implementations.
+ * They replace CPython's generic 'slot_nb_add' etc. that are installed when
+ * such an attribute is assigned, and which resolve the dunder method by
+ * name on every call. An operator implemented by an nb_func is invoked via
+ * its vectorcall entry point without further indirection.
+ */
+
+enum class nb_slot_kind { binary, inplace, unary };
+
+struct nb_slot {
+    const char *name, *rname;
+    nb_slot_kind kind;
+    size_t offset;
+};
+
+#define NB_SLOT_BINARY(name, slot)                                            \
+    { "__" #name "__", "__r" #name "__", nb_slot_kind::binary,                \
+      offsetof(PyNumberMethods, slot) }
+#define NB_SLOT_INPLACE(name, slot)                                           \
+    { "__i" #name "__", nullptr, nb_slot_kind::inplace,                       \
+      offsetof(PyNumberMethods, slot) }
+#define NB_SLOT_UNARY(name, slot)                                             \
+    { "__" #name "__", nullptr, nb_slot_kind::unary,                          \
+      offsetof(PyNumberMethods, slot) }
+
+static const nb_slot nb_slots[] = {
+    NB_SLOT_BINARY(add, nb_add), NB_SLOT_BINARY(sub, nb_subtract),
+    NB_SLOT_BINARY(mul, nb_multiply), NB_SLOT_BINARY(truediv, nb_true_divide),
+    NB_SLOT_BINARY(mod, nb_remainder), NB_SLOT_BINARY(lshift, nb_lshift),
+    NB_SLOT_BINARY(rshift, nb_rshift), NB_SLOT_BINARY(and, nb_and),
+    NB_SLOT_BINARY(xor, nb_xor), NB_SLOT_BINARY(or, nb_or),
+    NB_SLOT_INPLACE(add, nb_inplace_add),
+    NB_SLOT_INPLACE(sub, nb_inplace_subtract),
+    NB_SLOT_INPLACE(mul, nb_inplace_multiply),
+    NB_SLOT_INPLACE(truediv, nb_inplace_true_divide),
+    NB_SLOT_INPLACE(mod, nb_inplace_remainder),
+    NB_SLOT_INPLACE(lshift, nb_inplace_lshift),
+    NB_SLOT_INPLACE(rshift, nb_inplace_rshift),
+    NB_SLOT_INPLACE(and, nb_inplace_and),
+    NB_SLOT_INPLACE(xor, nb_inplace_xor),
+    NB_SLOT_INPLACE(or, nb_inplace_or),
+    NB_SLOT_UNARY(neg, nb_negative), NB_SLOT_UNARY(pos, nb_positive),
+    NB_SLOT_UNARY(abs, nb_absolute), NB_SLOT_UNARY(invert, nb_invert)
+};
+
+#undef NB_SLOT_BINARY
+#undef NB_SLOT_INPLACE
+#undef NB_SLOT_UNARY
+
+static constexpr size_t nb_slot_count = sizeof(nb_slots) / sizeof(nb_slot);
+
+/// Comparison dunders indexed by Py_LT, Py_LE, Py_EQ, Py_NE, Py_GT, Py_GE
+static const char *nb_richcompare_names[] = {
+    "__lt__", "__le__", "__eq__", "__ne__", "__gt__", "__ge__"
+};
+
+/**
+ * Layout of 'nb_internals::slot_names': forward and reflected name of each
+ * entry of 'nb_slots', followed by the comparisons
+ */
+static constexpr size_t nb_slot_richcompare_offset = 2 * nb_slot_count,
+                        nb_slot_name_count = nb_slot_richcompare_offset + 6;
+
+/**
+ * Implementations of the entries of 'nb_slots' followed by 'tp_richcompare',
+ * and the generic CPython slot functions that they replace
+ */
+static void *nb_slot_funcs[nb_slot_count + 1] { };
+static void *nb_slot_generic[nb_slot_count + 1] { };
+
+static void *nb_slot_get(PyTypeObject *tp, size_t index) noexcept {
+    return *(void **) ((uint8_t *) tp->tp_as_number + nb_slots[index].offset);
+}
+
+static void **nb_slot_ptr(PyTypeObject *tp, size_t index) noexcept {
+    if (index == nb_slot_count)
+        return (void **) &tp->tp_richcompare;
+    if (!tp->tp_as_number)
+        return nullptr;
+    return (void **) ((uint8_t *) tp->tp_as_number + nb_slots[index].offset);
+}
+
+/**
+ * Call the method 'slot_names[name]' of 'args[0]' like CPython's
+ * vectorcall_method()
+ */
+static PyObject *nb_slot_call(size_t name, PyObject *const *args,
+                              size_t nargs) noexcept {
+    nb_internals &internals = internals_get();
+    PyTypeObject *tp = Py_TYPE(args[0]);
+    PyObject *func = _PyType_Lookup(tp, internals.slot_names[name]);
+
+    if (!func) {
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+
+    PyTypeObject *func_tp = Py_TYPE(func);
+    if (func_tp == internals.nb_method)
+        return ((nb_func *) func)->vectorcall(func, args, nargs, nullptr);
+    else if (PyType_HasFeature(func_tp, Py_TPFLAGS_METHOD_DESCRIPTOR))
+        return PyObject_Vectorcall(func, args, nargs, nullptr);
+
+    descrgetfunc descr_get = func_tp->tp_descr_get;
+    if (!descr_get)
+        return PyObject_Vectorcall(func, args + 1, nargs - 1, nullptr);
+
+    PyObject *bound = descr_get(func, args[0], (PyObject *) tp);
+    if (!bound)
+        return nullptr;
+    PyObject *result = PyObject_Vectorcall(bound, args + 1, nargs - 1, nullptr);
+    Py_DECREF(bound);
+    return result;
+}
+
+/// Binary operator, follows the logic of CPython's SLOT1BINFULL() macro
+template <size_t I> static PyObject *nb_slot_binary(PyObject *self, PyObject *other) {
+    PyTypeObject *tp_self = Py_TYPE(self), *tp_other = Py_TYPE(other);
+    void *func = nb_slot_funcs[I];
+    PyObject *result;
+
+    bool do_other = tp_self != tp_other && tp_other->tp_as_number &&
+                    nb_slot_get(tp_other, I) == func;
+
+    if (tp_self->tp_as_number && nb_slot_get(tp_self, I) == func) {
+        // Like CPython's method_is_overloaded(): only let a subclass go first
+        // if it provides its own reflected operator
+        PyObject *rname = internals_get().slot_names[2 * I + 1];
+        if (do_other && PyType_IsSubtype(tp_other, tp_self) &&
+            _PyType_Lookup(tp_other, rname) != _PyType_Lookup(tp_self, rname)) {
+            PyObject *args[2] = { other, self };
+            result = nb_slot_call(2 * I + 1, args, 2);
+            if (result != Py_NotImplemented)
+                return result;
+            Py_DECREF(result);
+            do_other = false;
+        }
+
+        PyObject *args[2] = { self, other };
+        result = nb_slot_call(2 * I, args, 2);
+        if (result != Py_NotImplemented || tp_self == tp_other)
+            return result;
+        Py_DECREF(result);
+    }
+
+    if (do_other) {
+        PyObject *args[2] = { other, self };
+        return nb_slot_call(2 * I + 1, args, 2);
+    }
+
+    Py_INCREF(Py_NotImplemented);
+    return Py_NotImplemented;
+}
+
+template <size_t I> static PyObject *nb_slot_inplace(PyObject *self, PyObject *other) {
+    PyObject *args[2] = { self, other };
+    return nb_slot_call(2 * I, args, 2);
+}
+
+template <size_t I> static PyObject *nb_slot_unary(PyObject *self) {
+    return nb_slot_call(2 * I, &self, 1);
+}
+
+static PyObject *nb_slot_richcompare(PyObject *self, PyObject *other, int op) {
+    PyObject *args[2] = { self, other };
+    return nb_slot_call(nb_slot_richcompare_offset + op, args, 2);
+}
+
+template <size_t... Is>
+static bool nb_slot_funcs_init(std::index_sequence<Is...>) noexcept {
+    ((nb_slot_funcs[Is] =
+          nb_slots[Is].kind == nb_slot_kind::binary
+              ? (void *) nb_slot_binary<Is>
+              : (nb_slots[Is].kind == nb_slot_kind::inplace
+                     ? (void *) nb_slot_inplace<Is>
+                     : (void *) nb_slot_unary<Is>)), ...);
+    nb_slot_funcs[nb_slot_count] = (void *) nb_slot_richcompare;
+    return true;
+}
+
+[[maybe_unused]] static bool nb_slot_funcs_ready =
+    nb_slot_funcs_init(std::make_index_sequence<nb_slot_count>());
+
+/// Intern the slot names (per interpreter, as are interned strings)
+static void nb_slot_init(nb_internals &internals) noexcept {
+    PyObject **names = new PyObject *[nb_slot_name_count] { };
+
+    for (size_t i = 0; i < nb_slot_count; ++i) {
+        names[2 * i] = PyUnicode_InternFromString(nb_slots[i].name);
+        if (nb_slots[i].rname)
+            names[2 * i + 1] = PyUnicode_InternFromString(nb_slots[i].rname);
+    }
+
+    for (size_t i = 0; i < 6; ++i)
+        names[nb_slot_richcompare_offset + i] =
+            PyUnicode_InternFromString(nb_richcompare_names[i]);
+
+    internals.slot_names = names;
+}
+
+/**
+ * \brief Replace CPython's generic slot function 'index' of 'tp' by the
+ * above implementation. CPython propagates a slot update to subclasses that
+ * inherit the attribute, hence the same is done for them.
+ */
+static void nb_slot_patch(PyTypeObject *tp, size_t index) noexcept {
+    void **ptr = nb_slot_ptr(tp, index);
+    if (!ptr || !*ptr || *ptr != nb_slot_generic[index])
+        return;
+
+    *ptr = nb_slot_funcs[index];
+
+    PyObject *subclasses = PyObject_CallMethod((PyObject *) tp,
+                                               "__subclasses__", nullptr);
+    if (!subclasses) {
+        PyErr_Clear();
+        return;
+    }
+
+    Py_ssize_t n = NB_LIST_GET_SIZE(subclasses);
+    for (Py_ssize_t i = 0; i < n; ++i)
+        nb_slot_patch((PyTypeObject *) NB_LIST_GET_ITEM(subclasses, i), index);
+
+    Py_DECREF(subclasses);
+}
+
+/// Python subclasses of bound types start out with CPython's generic slots
+static void nb_type_inherit_slots(PyTypeObject *tp) noexcept {
+    for (size_t i = 0; i <= nb_slot_count; ++i)
+        nb_slot_patch(tp, i);
+}
+
+/**
+ * \brief Redirect the number/comparison slot associated with an attribute
+ * that was just assigned (e.g. '__add__' or '__radd__') to the above
+ * implementations if CPython installed its generic slot function
+ */
+static void nb_type_update_slots(PyTypeObject *tp, PyObject *name,
+                                 PyObject *value) noexcept {
+    if (!value || !PyUnicode_Check(name))
+        return;
+
+    Py_ssize_t size;
+    const char *s = PyUnicode_AsUTF8AndSize(name, &size);
+    if (!s || size < 6 || s[0] != '_' || s[1] != '_') {
+        PyErr_Clear();
+        return;
+    }
+
+    nb_internals &internals = internals_get();
+    if (!internals.slot_names)
+        nb_slot_init(internals);
+
+    size_t index = nb_slot_count + 1;
+    for (size_t i = 0; i < 6; ++i) {
+        if (strcmp(s, nb_richcompare_names[i]) == 0)
+            index = nb_slot_count;
+    }
+
+    for (size_t i = 0; i < nb_slot_count; ++i) {
+        const nb_slot &slot = nb_slots[i];
+        if (strcmp(s, slot.name) == 0 ||
+            (slot.rname && strcmp(s, slot.rname) == 0))
+            index = i;
+    }
+
+    if (index > nb_slot_count)
+        return;
+
+    /* Assigning a nb_func makes CPython install its generic slot function,
+       which is how the latter is identified */
+    void **ptr = nb_slot_ptr(tp, index);
+    if (ptr && *ptr && !nb_slot_generic[index] &&
+        Py_TYPE(value) == internals.nb_method)
+        nb_slot_generic[index] = *ptr;
+
+    nb_slot_patch(tp, index);
+}
+#endif
+
 /// Special case to handle 'Class.property = value' assignments
 int nb_type_setattro(PyObject* obj, PyObject* name, PyObject* value) {
     nb_internals &internals = internals_get();
@@ -960,25 +1924,54 @@ int nb_type_setattro(PyObject* obj, PyObject* name, PyObject* value) {
         setattrofunc tp_setattro = PyType_Type.tp_setattro;
     #endif
 
-    return tp_setattro(obj, name, value);
+    int rv = tp_setattro(obj, name, value);
+
+    // Attribute changes may add or remove Python overrides of virtual methods
+    if (rv == 0) {
+        trampoline_cache_invalidate();
+#if NB_TYPE_VECTORCALL
+        nb_type_update_vectorcall((PyTypeObject *) obj, name, value);
+#endif
+#if NB_TYPE_SLOTS
+        nb_type_update_slots((PyTypeObject *) obj, name, value);
+#endif
+    }
+
+    return rv;
 }
 
 bool nb_type_isinstance(PyObject *o, const std::type_info *t) noexcept {
-    nb_internals &internals = internals_get();
-    auto it = internals.type_c2p.find(std::type_index(*t));
-    if (it == internals.type_c2p.end())
+    type_data *td = nb_type_c2p(internals_get(), t);
+    if (!td)
         return false;
-    return PyType_IsSubtype(Py_TYPE(o), it->second->type_py);
+    if (td->flags & (uint32_t) type_flags::is_final)
+        return Py_TYPE(o) == td->type_py;
+    return PyType_IsSubtype(Py_TYPE(o), td->type_py);
 }
 
 PyObject *nb_type_lookup(const std::type_info *t) noexcept {
-    nb_internals &internals = internals_get();
-    auto it = internals.type_c2p.find(std::type_index(*t));
-    if (it != internals.type_c2p.end())
-        return (PyObject *) it->second->type_py;
+    type_data *td = nb_type_c2p(internals_get(), t);
+    if (td)
+        return (PyObject *) td->type_py;
     return nullptr;
 }
 
+type_data *nb_type_c2p_slow(nb_internals &internals,
+                            const std::type_info *type) noexcept {
+    auto &type_c2p = internals.type_c2p.get();
+    auto it = type_c2p.find(std::type_index(*type));
+    if (it == type_c2p.end())
+        return nullptr;
+
+    // Remember this 'std::type_info' instance for subsequent lookups
+    type_data *t = it->second;
+    internals.type_c2p_fast.update([&](auto &fast) {
+        if (fast.try_emplace(type, t).second && type != t->type)
+            internals.type_c2p_alias[t].push_back(type);
+    });
+    return t;
+}
+
 bool nb_type_check(PyObject *t) noexcept {
     nb_internals &internals = internals_get();
     PyTypeObject *metaclass = Py_TYPE(t);
@@ -1032,6 +2025,58 @@ std::pair<bool, bool> nb_inst_state(PyObject *o) noexcept {
     return { (bool) nbi->ready, (bool) nbi->destruct };
 }
 
+void nb_inst_make_immortal(PyObject *o) noexcept {
+    nb_inst *nbi = (nb_inst *) o;
+    if (nbi->immortal)
+        return;
+
+    // This reference is never released
+    Py_INCREF(o);
+    nbi->immortal = true;
+
+    internals_get().immortal_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool nb_inst_immortal(PyObject *o) noexcept {
+    return ((nb_inst *) o)->immortal;
+}
+
+/* Does the calling thread hold the GIL? This deliberately avoids
+   PyGILState_Check(), which isn't part of the limited API and
+   unconditionally returns 1 once a sub-interpreter has been created.
+   Limited API builds always acquire the GIL. */
+static bool intrusive_tstate_attached() noexcept {
+#if defined(Py_LIMITED_API)
+    return false;
+#else
+    return tstate_attached() != nullptr;
+#endif
+}
+
+void intrusive_inc_ref_py(PyObject *o) noexcept {
+    if (((nb_inst *) o)->immortal)
+        return;
+
+    if (intrusive_tstate_attached()) {
+        Py_INCREF(o);
+    } else {
+        gil_scoped_acquire guard;
+        Py_INCREF(o);
+    }
+}
+
+void intrusive_dec_ref_py(PyObject *o) noexcept {
+    if (((nb_inst *) o)->immortal)
+        return;
+
+    if (intrusive_tstate_attached()) {
+        Py_DECREF(o);
+    } else {
+        gil_scoped_acquire guard;
+        Py_DECREF(o);
+    }
+}
+
 void nb_inst_destruct(PyObject *o) noexcept {
     nb_inst *nbi = (nb_inst *) o;
     type_data *t = nb_type_data(Py_TYPE(o));
@@ -0,0 +1,205 @@
+/*
+    src/parallel.cpp: shared thread pool backing nb::parallel_for()
+
+    Copyright (c) 2022 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#include <nanobind/parallel.h>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include "nb_internals.h"
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+/// A parallel_run() invocation whose chunks are claimed by the workers
+struct parallel_job {
+    parallel_func func;
+    void *payload;
+    size_t size, chunk_size, chunk_count;
+
+    /// Index of the next unclaimed chunk
+    std::atomic<size_t> next { 0 };
+
+    /// Number of workers currently processing chunks (protected by the mutex)
+    size_t workers = 0;
+
+    /// First exception raised by 'func'
+    std::exception_ptr error;
+    std::mutex error_mutex;
+};
+
+struct thread_pool {
+    std::mutex mutex;
+    std::condition_variable cv_work, cv_done;
+    std::vector<std::thread> threads;
+    parallel_job *job = nullptr;
+    uint64_t generation = 0;
+    bool busy = false;
+    bool shutdown = false;
+};
+
+/// Is the current thread processing chunks of a parallel_run() invocation?
+static NB_THREAD_LOCAL bool parallel_active = false;
+
+static std::mutex pool_mutex;
+
+static void parallel_process(parallel_job &job) noexcept {
+    while (true) {
+        size_t index = job.next.fetch_add(1, std::memory_order_relaxed);
+        if (index >= job.chunk_count)
+            break;
+
+        size_t begin = index * job.chunk_size,
+               end = std::min(begin + job.chunk_size, job.size);
+
+        try {
+            job.func(job.payload, begin, end);
+        } catch (...) {
+            std::lock_guard<std::mutex> guard(job.error_mutex);
+            if (!job.error)
+                job.error = std::current_exception();
+            // Skip the remaining chunks
+            job.next.store(job.chunk_count, std::memory_order_relaxed);
+        }
+    }
+}
+
+static void thread_pool_worker(thread_pool *pool) noexcept {
+    parallel_active = true;
+    uint64_t generation = 0;
+
+    std::unique_lock<std::mutex> lock(pool->mutex);
+    while (true) {
+        pool->cv_work.wait(lock, [&] {
+            return pool->shutdown || pool->generation != generation;
+        });
+        if (pool->shutdown)
+            break;
+        generation = pool->generation;
+
+        parallel_job *job = pool->job;
+        if (!job)
+            continue;
+        job->workers++;
+
+        lock.unlock();
+        parallel_process(*job);
+        lock.lock();
+
+        if (--job->workers == 0)
+            pool->cv_done.notify_all();
+    }
+}
+
+static thread_pool *thread_pool_get() {
+    nb_internals &internals = internals_get();
+
+    std::lock_guard<std::mutex> guard(pool_mutex);
+    if (!internals.pool) {
+        thread_pool *pool = new thread_pool();
+        unsigned long count = std::thread::hardware_concurrency();
+        const char *env = getenv("NB_NUM_THREADS");
+        if (env && *env)
+            count = strtoul(env, nullptr, 10);
+        for (unsigned long i = 1; i < count; ++i)
+            pool->threads.emplace_back(thread_pool_worker, pool);
+        internals.pool = pool;
+    }
+
+    return internals.pool;
+}
+
+void thread_pool_shutdown(nb_internals &internals) noexcept {
+    thread_pool *pool = internals.pool;
+    if (!pool)
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(pool->mutex);
+        pool->shutdown = true;
+    }
+    pool->cv_work.notify_all();
+
+    for (std::thread &t : pool->threads)
+        t.join();
+
+    delete pool;
+    internals.pool = nullptr;
+}
+
+size_t parallel_threads() {
+    return thread_pool_get()->threads.size() + 1;
+}
+
+void parallel_run(size_t size, size_t grain, parallel_func func,
+                  void *payload) {
+    if (size == 0)
+        return;
+    if (grain == 0)
+        grain = 1;
+
+    // Nested invocations and small ranges run on the current thread
+    if (parallel_active || size <= grain) {
+        func(payload, 0, size);
+        return;
+    }
+
+    thread_pool *pool = thread_pool_get();
+    size_t threads = pool->threads.size() + 1;
+
+    /* Split the range into several chunks per thread so that threads which
+       finish early take over part of the remaining work */
+    size_t chunk_size = (size + 4 * threads - 1) / (4 * threads);
+    if (chunk_size < grain)
+        chunk_size = grain;
+
+    parallel_job job;
+    job.func = func;
+    job.payload = payload;
+    job.size = size;
+    job.chunk_size = chunk_size;
+    job.chunk_count = (size + chunk_size - 1) / chunk_size;
+
+    PyThreadState *state = PyEval_SaveThread();
+
+    bool shared;
+    {
+        std::lock_guard<std::mutex> guard(pool->mutex);
+        // Another thread is using the pool: don't oversubscribe the machine
+        shared = !pool->busy && !pool->threads.empty();
+        if (shared) {
+            pool->busy = true;
+            pool->job = &job;
+            pool->generation++;
+        }
+    }
+
+    if (shared)
+        pool->cv_work.notify_all();
+
+    parallel_active = true;
+    parallel_process(job);
+    parallel_active = false;
+
+    if (shared) {
+        std::unique_lock<std::mutex> lock(pool->mutex);
+        pool->job = nullptr;
+        pool->cv_done.wait(lock, [&] { return job.workers == 0; });
+        pool->busy = false;
+    }
+
+    PyEval_RestoreThread(state);
+
+    if (job.error)
+        std::rethrow_exception(job.error);
+}
+
+NAMESPACE_END(detail)
+NAMESPACE_END(NB_NAMESPACE)
@@ -1,5 +1,9 @@
 #include <nanobind/tensor.h>
+#include <algorithm>
 #include <atomic>
+#include <string>
+#include <vector>
+#include <limits>
 #include "nb_internals.h"
 
 NAMESPACE_BEGIN(NB_NAMESPACE)
@@ -17,11 +21,137 @@ struct tensor_handle {
     managed_tensor *tensor;
     std::atomic<size_t> refcount;
     PyObject *owner;
-    bool free_shape;
-    bool free_strides;
+    /// Object that the tensor was imported from (or NULL), see tensor_wrap()
+    PyObject *source;
+    /// Storage allocated by tensor_allocate() (or NULL)
+    void *storage;
+    /// Number of shape/stride entries stored in the handle block
+    uint32_t capacity;
+    /// Size class of 'storage', or 'tensor_storage_unpooled'
+    uint8_t storage_class;
+    uint8_t source_framework;
+    /// Does 'tensor->dl_tensor.strides' point into the handle block?
+    bool strides_inline;
     bool call_deleter;
 };
 
+/* Tensor handles are allocated in one block together with a 'managed_tensor'
+   and 'capacity' shape and stride entries each. tensor_create() uses all of
+   them, while tensor_import() only uses the strides (when the imported tensor
+   doesn't specify them). Blocks of tensors with rank <= 4 are recycled via a
+   freelist in 'nb_internals'. */
+static constexpr uint32_t tensor_pool_ndim = 4;
+
+static tensor_handle *tensor_handle_alloc(size_t ndim) {
+    nb_internals &internals = internals_get();
+    bool pooled = ndim <= tensor_pool_ndim;
+    void *ptr;
+
+    if (pooled && internals.tensor_pool_size) {
+        ptr = internals.tensor_pool[--internals.tensor_pool_size];
+    } else {
+        size_t capacity = pooled ? tensor_pool_ndim : ndim;
+        ptr = PyMem_Malloc(sizeof(tensor_handle) + sizeof(managed_tensor) +
+                           2 * capacity * sizeof(int64_t));
+        if (!ptr)
+            fail("nanobind::detail::tensor_handle_alloc(): out of memory!");
+    }
+
+    tensor_handle *th = new (ptr) tensor_handle();
+    th->capacity = pooled ? tensor_pool_ndim : (uint32_t) ndim;
+    internals.tensor_handle_count.fetch_add(1, std::memory_order_relaxed);
+    return th;
+}
+
+static void tensor_handle_free(tensor_handle *th) {
+    nb_internals &internals = internals_get();
+    internals.tensor_handle_count.fetch_sub(1, std::memory_order_relaxed);
+    if (th->capacity == tensor_pool_ndim &&
+        internals.tensor_pool_size < NB_TENSOR_POOL_SIZE)
+        internals.tensor_pool[internals.tensor_pool_size++] = th;
+    else
+        PyMem_Free(th);
+}
+
+static managed_tensor *tensor_handle_mt(tensor_handle *th) {
+    return (managed_tensor *) (th + 1);
+}
+
+static int64_t *tensor_handle_shape(tensor_handle *th) {
+    return (int64_t *) (tensor_handle_mt(th) + 1);
+}
+
+static int64_t *tensor_handle_strides(tensor_handle *th) {
+    return tensor_handle_shape(th) + th->capacity;
+}
+
+/* Storage of tensors created by tensor_allocate(). Blocks of up to 1 MiB are
+   rounded up to a power of two, aligned to the maximum supported alignment,
+   and recycled per size class. */
+static constexpr size_t tensor_storage_max_alignment = 256;
+static constexpr size_t tensor_storage_min_log2 = 6;
+static constexpr uint8_t tensor_storage_unpooled = 0xFF;
+
+static void *aligned_malloc(size_t size, size_t alignment) {
+    void *raw = malloc(size + alignment + sizeof(void *));
+    if (!raw)
+        return nullptr;
+    uintptr_t ptr = ((uintptr_t) raw + sizeof(void *) + alignment - 1) &
+                    ~(uintptr_t) (alignment - 1);
+    ((void **) ptr)[-1] = raw;
+    return (void *) ptr;
+}
+
+static void aligned_free(void *ptr) { free(((void **) ptr)[-1]); }
+
+static void *tensor_storage_alloc(size_t size, size_t alignment,
+                                  uint8_t &storage_class) {
+    size_t log2 = tensor_storage_min_log2;
+    while (log2 < tensor_storage_min_log2 + NB_TENSOR_STORAGE_CLASSES &&
+           ((size_t) 1 << log2) < size)
+        ++log2;
+
+    if (log2 == tensor_storage_min_log2 + NB_TENSOR_STORAGE_CLASSES) {
+        storage_class = tensor_storage_unpooled;
+        return aligned_malloc(size, alignment);
+    }
+
+    nb_internals &internals = internals_get();
+    size_t index = log2 - tensor_storage_min_log2;
+    storage_class = (uint8_t) index;
+
+    size_t &pool_size = internals.tensor_storage_pool_size[index];
+    if (pool_size)
+        return internals.tensor_storage_pool[index][--pool_size];
+
+    return aligned_malloc((size_t) 1 << log2, tensor_storage_max_alignment);
+}
+
+static void tensor_storage_free(void *ptr, uint8_t storage_class) {
+    if (storage_class != tensor_storage_unpooled) {
+        nb_internals &internals = internals_get();
+        size_t &pool_size = internals.tensor_storage_pool_size[storage_class];
+        if (pool_size < NB_TENSOR_STORAGE_POOL_SIZE) {
+            internals.tensor_storage_pool[storage_class][pool_size++] = ptr;
+            return;
+        }
+    }
+
+    aligned_free(ptr);
+}
+
+/// Returns an unused handle block to the pool when going out of scope
+struct scoped_tensor_handle {
+    scoped_tensor_handle(size_t ndim) : th(tensor_handle_alloc(ndim)) { }
+    ~scoped_tensor_handle() { if (th) tensor_handle_free(th); }
+    tensor_handle *release() {
+        tensor_handle *temp = th;
+        th = nullptr;
+        return temp;
+    }
+    tensor_handle *th;
+};
+
 PyObject *nb_tensor_new(PyTypeObject *tp, PyObject *args,
                         PyObject *kwargs) {
 
@@ -37,13 +167,25 @@ PyObject *nb_tensor_new(PyTypeObject *tp, PyObject *args,
         fail("nanobind::detail::nb_tensor_new(): internal error!");
 
     PyObject *capsule = NB_TUPLE_GET_ITEM(args, 0);
-    ((nb_tensor *) result)->capsule = capsule;
+    void *ptr = PyCapsule_GetPointer(capsule, "dltensor");
+    if (!ptr)
+        fail("nanobind::detail::nb_tensor_new(): invalid capsule!");
+
+    nb_tensor *t = (nb_tensor *) result;
+    const dlpack::device &device = ((managed_tensor *) ptr)->dl_tensor.device;
+    t->capsule = capsule;
+    t->device_type = device.device_type;
+    t->device_id = device.device_id;
+    t->readonly = false;
+    t->format = nullptr;
+    t->buffer = nullptr;
     Py_INCREF(capsule);
     return result;
 }
 
 void nb_tensor_dealloc(PyObject *self) {
     Py_DECREF(((nb_tensor *) self)->capsule);
+    PyMem_Free(((nb_tensor *) self)->buffer);
 
     freefunc tp_free;
 #if defined(Py_LIMITED_API)
@@ -55,31 +197,51 @@ void nb_tensor_dealloc(PyObject *self) {
     tp_free(self);
 }
 
-PyObject *nb_tensor_get(PyObject *self, PyObject *) {
+/* '__dlpack__(stream=None)': the stream is accepted for protocol compliance.
+   Tensors created by C++ code are expected to be ready when they are returned,
+   hence no further synchronization is needed. */
+PyObject *nb_tensor_get(PyObject *self, PyObject *args, PyObject *kwargs) {
+    static const char *kwlist[] = { "stream", nullptr };
+    PyObject *stream = nullptr;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|$O:__dlpack__",
+                                     (char **) kwlist, &stream))
+        return nullptr;
+
     PyObject *result = ((nb_tensor *) self)->capsule;
+
+    // Record types are a nanobind extension that DLPack consumers don't know
+    managed_tensor *mt =
+        (managed_tensor *) PyCapsule_GetPointer(result, "dltensor");
+    if (mt && mt->dl_tensor.dtype.code == (uint8_t) dlpack::dtype_code::Record) {
+        PyErr_SetString(PyExc_TypeError,
+                        "nanobind::tensor: record tensors can't be exported "
+                        "via DLPack, use the buffer protocol instead!");
+        return nullptr;
+    } else if (!mt) {
+        PyErr_Clear();
+    }
+
     Py_INCREF(result);
     return result;
 }
 
-int nb_tensor_getbuffer(PyObject *exporter, Py_buffer *view, int) {
-    nb_tensor *self = (nb_tensor *) exporter;
-
-    void *ptr = PyCapsule_GetPointer(self->capsule, "dltensor");
-    if (!ptr)
-        fail("nanobind::tensor::nb_tensor_getbuffer(): internal error!");
-
-    dlpack::tensor &t = ((managed_tensor *) ptr)->dl_tensor;
-
-    if (t.device.device_type != device::cpu::value) {
-        PyErr_SetString(PyExc_BufferError, "Only CPU-allocated tensors can be "
-                                           "accessed via the buffer protocol!");
-        return -1;
-    }
+PyObject *nb_tensor_device(PyObject *self, PyObject *) {
+    nb_tensor *t = (nb_tensor *) self;
+    return Py_BuildValue("(ii)", (int) t->device_type, (int) t->device_id);
+}
 
+/**
+ * Compute the buffer protocol representation of a tensor. The result is
+ * stored in a single allocation that is cached by the 'nb_tensor' instance,
+ * hence repeated buffer requests (e.g., 'np.asarray()' in a loop) don't
+ * allocate.
+ */
+/// Buffer protocol format character(s) of a DLPack dtype (or NULL)
+static const char *dtype_format(const dlpack::dtype &dtype) {
     const char *format = nullptr;
-    switch ((dlpack::dtype_code) t.dtype.code) {
+    switch ((dlpack::dtype_code) dtype.code) {
         case dlpack::dtype_code::Int:
-            switch (t.dtype.bits) {
+            switch (dtype.bits) {
                 case 8: format = "b"; break;
                 case 16: format = "h"; break;
                 case 32: format = "i"; break;
@@ -88,7 +250,7 @@ int nb_tensor_getbuffer(PyObject *exporter, Py_buffer *view, int) {
             break;
 
         case dlpack::dtype_code::UInt:
-            switch (t.dtype.bits) {
+            switch (dtype.bits) {
                 case 8: format = "B"; break;
                 case 16: format = "H"; break;
                 case 32: format = "I"; break;
@@ -97,155 +259,288 @@ int nb_tensor_getbuffer(PyObject *exporter, Py_buffer *view, int) {
             break;
 
         case dlpack::dtype_code::Float:
-            switch (t.dtype.bits) {
+            switch (dtype.bits) {
                 case 16: format = "e"; break;
                 case 32: format = "f"; break;
                 case 64: format = "d"; break;
             }
             break;
 
+        case dlpack::dtype_code::Complex:
+            switch (dtype.bits) {
+                case 64: format = "Zf"; break;
+                case 128: format = "Zd"; break;
+            }
+            break;
+
+        case dlpack::dtype_code::Bool:
+            if (dtype.bits == 8)
+                format = "?";
+            break;
+
         default:
             break;
     }
 
-    if (!format || t.dtype.lanes != 1) {
+    return dtype.lanes == 1 ? format : nullptr;
+}
+
+static nb_buffer_info *nb_tensor_buffer_info(const dlpack::tensor &t,
+                                             const char *record_format) {
+    const char *format = record_format ? record_format : dtype_format(t.dtype);
+
+    if (!format) {
         PyErr_SetString(
             PyExc_BufferError,
             "Don't know how to convert DLPack dtype into buffer protocol format!");
+        return nullptr;
+    }
+
+    size_t ndim = (size_t) t.ndim;
+    nb_buffer_info *info = (nb_buffer_info *) PyMem_Malloc(
+        sizeof(nb_buffer_info) + 2 * ndim * sizeof(Py_ssize_t));
+    if (!info) {
+        PyErr_NoMemory();
+        return nullptr;
+    }
+
+    info->format = format;
+    info->itemsize = ((Py_ssize_t) t.dtype.bits * t.dtype.lanes + 7) / 8;
+    info->shape = (Py_ssize_t *) (info + 1);
+    info->strides = info->shape + ndim;
+    info->len = info->itemsize;
+
+    for (size_t i = 0; i < ndim; ++i) {
+        info->shape[i] = (Py_ssize_t) t.shape[i];
+        info->len *= info->shape[i];
+    }
+
+    // Tensors without strides are C-contiguous
+    Py_ssize_t c_accum = info->itemsize, f_accum = info->itemsize;
+    info->c_contig = info->f_contig = true;
+
+    for (size_t i = ndim; i-- > 0; ) {
+        info->strides[i] = t.strides ? (Py_ssize_t) t.strides[i] * info->itemsize
+                                     : c_accum;
+        if (info->shape[i] != 1 && info->strides[i] != c_accum)
+            info->c_contig = false;
+        c_accum *= info->shape[i];
+    }
+
+    for (size_t i = 0; i < ndim; ++i) {
+        if (info->shape[i] != 1 && info->strides[i] != f_accum)
+            info->f_contig = false;
+        f_accum *= info->shape[i];
+    }
+
+    return info;
+}
+
+int nb_tensor_getbuffer(PyObject *exporter, Py_buffer *view, int flags) {
+    nb_tensor *self = (nb_tensor *) exporter;
+
+    void *ptr = PyCapsule_GetPointer(self->capsule, "dltensor");
+    if (!ptr)
+        fail("nanobind::tensor::nb_tensor_getbuffer(): internal error!");
+
+    dlpack::tensor &t = ((managed_tensor *) ptr)->dl_tensor;
+
+    if (t.device.device_type != device::cpu::value) {
+        PyErr_SetString(PyExc_BufferError, "Only CPU-allocated tensors can be "
+                                           "accessed via the buffer protocol!");
         return -1;
     }
 
-    view->format = (char *) format;
-    view->itemsize = t.dtype.bits / 8;
-    view->buf = (void *) ((uintptr_t) t.data + t.byte_offset);
-    view->obj = exporter;
-    Py_INCREF(exporter);
+    if (!self->buffer) {
+        self->buffer = nb_tensor_buffer_info(t, self->format);
+        if (!self->buffer)
+            return -1;
+    }
 
-    Py_ssize_t len = view->itemsize;
-    scoped_pymalloc<Py_ssize_t> strides(t.ndim), shape(t.ndim);
-    for (int32_t i = 0; i < t.ndim; ++i) {
-        len *= (Py_ssize_t) t.shape[i];
-        strides[i] = (Py_ssize_t) t.strides[i] * view->itemsize;
-        shape[i] = (Py_ssize_t) t.shape[i];
+    const nb_buffer_info *info = self->buffer;
+
+    if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE && self->readonly) {
+        PyErr_SetString(PyExc_BufferError, "The tensor is read-only!");
+        return -1;
+    }
+
+    // Requests without strides (e.g., PyBUF_SIMPLE/PyBUF_ND) need C order
+    bool c_contig_req = (flags & PyBUF_STRIDES) != PyBUF_STRIDES ||
+                        (flags & PyBUF_C_CONTIGUOUS) == PyBUF_C_CONTIGUOUS;
+    bool f_contig_req = (flags & PyBUF_F_CONTIGUOUS) == PyBUF_F_CONTIGUOUS;
+    bool any_contig_req = (flags & PyBUF_ANY_CONTIGUOUS) == PyBUF_ANY_CONTIGUOUS;
+
+    if ((c_contig_req && !info->c_contig) ||
+        (f_contig_req && !info->f_contig) ||
+        (any_contig_req && !info->c_contig && !info->f_contig)) {
+        PyErr_SetString(PyExc_BufferError,
+                        "The tensor does not have the requested memory layout!");
+        return -1;
     }
 
-    view->ndim = t.ndim;
-    view->len = len;
-    view->readonly = false;
+    view->buf = (void *) ((uintptr_t) t.data + t.byte_offset);
+    view->obj = exporter;
+    Py_INCREF(exporter);
+    view->len = info->len;
+    view->itemsize = info->itemsize;
+    view->readonly = self->readonly;
+    view->format = (flags & PyBUF_FORMAT) ? (char *) info->format : nullptr;
+    view->ndim = (flags & PyBUF_ND) == PyBUF_ND ? t.ndim : 1;
+    view->shape = (flags & PyBUF_ND) == PyBUF_ND ? info->shape : nullptr;
+    view->strides =
+        (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? info->strides : nullptr;
     view->suboffsets = nullptr;
     view->internal = nullptr;
-    view->strides = strides.release();
-    view->shape = shape.release();
 
     return 0;
 }
 
-void nb_tensor_releasebuffer(PyObject *, Py_buffer *view) {
-    PyMem_Free(view->shape);
-    PyMem_Free(view->strides);
-}
+/**
+ * Parse a buffer protocol format string consisting of an optional byte order
+ * prefix, an optional 'Z' (complex) prefix, and a single type character.
+ * Non-native byte orders, structured and repeated types are rejected.
+ */
+static bool buffer_format_parse(const char *format, Py_ssize_t itemsize,
+                                dlpack::dtype &dt) {
+    if (!format)
+        format = "B";
 
-static PyObject *dlpack_from_buffer_protocol(PyObject *o) {
-    scoped_pymalloc<Py_buffer> view;
-    scoped_pymalloc<managed_tensor> mt;
-
-    if (PyObject_GetBuffer(o, view.get(), PyBUF_RECORDS)) {
-        PyErr_Clear();
-        return nullptr;
+    int32_t num = 1;
+    bool little_endian = *(uint8_t *) &num == 1;
+
+    switch (*format) {
+        case '@':
+        case '=': format++; break;
+        case '<': if (!little_endian) return false; format++; break;
+        case '>':
+        case '!': if (little_endian) return false; format++; break;
+        default: break;
     }
 
-    char format = 'B';
-    const char *format_str = view->format;
-    if (format_str)
-        format = *format_str;
+    bool complex = *format == 'Z';
+    if (complex)
+        format++;
+
+    if (format[0] == '\0' || format[1] != '\0' || itemsize <= 0 ||
+        itemsize > 16)
+        return false;
+
+    dlpack::dtype_code code;
+    switch (*format) {
+        case 'c':
+        case 'b':
+        case 'h':
+        case 'i':
+        case 'l':
+        case 'q':
+        case 'n': code = dlpack::dtype_code::Int; break;
+
+        case 'B':
+        case 'H':
+        case 'I':
+        case 'L':
+        case 'Q':
+        case 'N': code = dlpack::dtype_code::UInt; break;
+
+        case 'e':
+        case 'f':
+        case 'd': code = dlpack::dtype_code::Float; break;
+
+        case '?': code = dlpack::dtype_code::Bool; break;
 
-    bool skip_first = format == '@' || format == '=';
+        default:
+            return false;
+    }
 
-    int32_t num = 1;
-    if(*(uint8_t *) &num == 1) {
-        if (format == '<')
-            skip_first = true;
-    } else {
-        if (format == '!' || format == '>')
-            skip_first = true;
+    if (complex) {
+        if (code != dlpack::dtype_code::Float)
+            return false;
+        code = dlpack::dtype_code::Complex;
     }
 
-    if (skip_first && format_str)
-        format = *++format_str;
+    dt.code = (uint8_t) code;
+    dt.bits = (uint8_t) (itemsize * 8);
+    dt.lanes = 1;
+    return true;
+}
 
-    dlpack::dtype dt { };
-    bool fail = format_str && format_str[1] != '\0';
+/// DLPack tensor wrapping a buffer; shape and strides follow in the same block
+struct buffer_tensor {
+    managed_tensor mt;
+    Py_buffer view;
+};
 
-    if (!fail) {
-        switch (format) {
-            case 'c':
-            case 'b':
-            case 'h':
-            case 'i':
-            case 'l':
-            case 'q':
-            case 'n': dt.code = (uint8_t) dlpack::dtype_code::Int; break;
-
-            case 'B':
-            case 'H':
-            case 'I':
-            case 'L':
-            case 'Q':
-            case 'N': dt.code = (uint8_t) dlpack::dtype_code::UInt; break;
-
-            case 'e':
-            case 'f':
-            case 'd': dt.code = (uint8_t) dlpack::dtype_code::Float; break;
+static PyObject *dlpack_from_buffer_protocol(PyObject *o, bool readonly) {
+    Py_buffer view;
 
-            default:
-                fail = true;
+    if (PyObject_GetBuffer(o, &view, PyBUF_RECORDS)) {
+        PyErr_Clear();
+        // Read-only memory (e.g. 'bytes') is only usable via const tensors
+        if (!readonly || PyObject_GetBuffer(o, &view, PyBUF_RECORDS_RO)) {
+            PyErr_Clear();
+            return nullptr;
         }
-        dt.lanes = 1;
-        dt.bits = (uint8_t) (view->itemsize * 8);
+    }
+
+    dlpack::dtype dt { };
+    bool fail = !buffer_format_parse(view.format, view.itemsize, dt);
+
+    for (Py_ssize_t i = 0; i < view.ndim && view.strides && !fail; ++i)
+        fail = view.strides[i] % view.itemsize != 0;
+
+    buffer_tensor *bt = nullptr;
+    if (!fail) {
+        bt = (buffer_tensor *) PyMem_Malloc(
+            sizeof(buffer_tensor) + 2 * (size_t) view.ndim * sizeof(int64_t));
+        fail = bt == nullptr;
     }
 
     if (fail) {
-        PyBuffer_Release(view.get());
+        PyBuffer_Release(&view);
         return nullptr;
     }
 
+    managed_tensor *mt = &bt->mt;
+    bt->view = view;
+
     mt->deleter = [](managed_tensor *mt2) {
         gil_scoped_acquire guard;
-        Py_buffer *buf = (Py_buffer *) mt2->manager_ctx;
-        PyBuffer_Release(buf);
-        PyMem_Free(mt2->dl_tensor.shape);
-        PyMem_Free(mt2->dl_tensor.strides);
-        PyMem_Free(mt2);
+        buffer_tensor *bt2 = (buffer_tensor *) mt2->manager_ctx;
+        PyBuffer_Release(&bt2->view);
+        PyMem_Free(bt2);
     };
 
     /* DLPack mandates 256-byte alignment of the 'DLTensor::data' field, but
        PyTorch unfortunately ignores the 'byte_offset' value.. :-( */
 #if 0
-    uintptr_t value_int = (uintptr_t) view->buf,
+    uintptr_t value_int = (uintptr_t) view.buf,
               value_rounded = (value_int / 256) * 256;
 #else
-    uintptr_t value_int = (uintptr_t) view->buf,
+    uintptr_t value_int = (uintptr_t) view.buf,
               value_rounded = value_int;
 #endif
 
     mt->dl_tensor.data = (void *) value_rounded;
     mt->dl_tensor.device = { device::cpu::value, 0 };
-    mt->dl_tensor.ndim = view->ndim;
+    mt->dl_tensor.ndim = view.ndim;
     mt->dl_tensor.dtype = dt;
     mt->dl_tensor.byte_offset = value_int - value_rounded;
 
-    scoped_pymalloc<int64_t> strides(view->ndim);
-    scoped_pymalloc<int64_t> shape(view->ndim);
-    for (size_t i = 0; i < (size_t) view->ndim; ++i) {
-        strides[i] = (int64_t) (view->strides[i] / view->itemsize);
-        shape[i] = (int64_t) view->shape[i];
+    // Some exporters (e.g. ctypes) omit the strides of C-contiguous buffers
+    int64_t *shape = (int64_t *) (bt + 1),
+            *strides = shape + view.ndim, accum = 1;
+    for (size_t i = (size_t) view.ndim; i-- > 0; ) {
+        strides[i] = view.strides ? (int64_t) (view.strides[i] / view.itemsize)
+                                  : accum;
+        shape[i] = (int64_t) view.shape[i];
+        accum *= shape[i];
     }
 
-    mt->manager_ctx = view.release();
-    mt->dl_tensor.shape = shape.release();
-    mt->dl_tensor.strides = strides.release();
+    mt->manager_ctx = bt;
+    mt->dl_tensor.shape = shape;
+    mt->dl_tensor.strides = strides;
 
-    return PyCapsule_New(mt.release(), "dltensor", [](PyObject *o) {
+    return PyCapsule_New(mt, "dltensor", [](PyObject *o) {
         error_scope scope; // temporarily save any existing errors
         managed_tensor *mt =
             (managed_tensor *) PyCapsule_GetPointer(o, "dltensor");
@@ -258,40 +553,137 @@ static PyObject *dlpack_from_buffer_protocol(PyObject *o) {
     });
 }
 
+static tensor_handle *tensor_convert(const dlpack::tensor &t,
+                                     const tensor_req *req) noexcept;
+
+/**
+ * Call 'o.__dlpack__(stream=...)' if the tensor resides on a device with
+ * stream semantics, so that the producer synchronizes with the consumer's
+ * stream instead of the whole device. Returns NULL (with a cleared error
+ * state) when the producer doesn't support this.
+ */
+static PyObject *tensor_dlpack_stream(PyObject *o, intptr_t stream) {
+    PyObject *device = PyObject_CallMethod(o, "__dlpack_device__", nullptr);
+    if (!device) {
+        PyErr_Clear();
+        return nullptr;
+    }
+
+    long device_type = -1;
+    if (PyTuple_Check(device) && NB_TUPLE_GET_SIZE(device) == 2)
+        device_type = PyLong_AsLong(NB_TUPLE_GET_ITEM(device, 0));
+    Py_DECREF(device);
+    PyErr_Clear();
+
+    if (device_type != device::cuda::value &&
+        device_type != device::cuda_managed::value &&
+        device_type != device::rocm::value)
+        return nullptr;
+
+    PyObject *method = PyObject_GetAttrString(o, "__dlpack__"),
+             *args = PyTuple_New(0),
+             *kwargs = PyDict_New(),
+             *value = PyLong_FromSsize_t((Py_ssize_t) stream),
+             *result = nullptr;
+
+    if (method && args && kwargs && value &&
+        PyDict_SetItemString(kwargs, "stream", value) == 0)
+        result = PyObject_Call(method, args, kwargs);
+
+    Py_XDECREF(value);
+    Py_XDECREF(kwargs);
+    Py_XDECREF(args);
+    Py_XDECREF(method);
+
+    if (!result)
+        PyErr_Clear();
+    return result;
+}
+
+/**
+ * Determine how instances of 'tp' are converted into a DLPack capsule. This
+ * involves an attribute lookup and potentially importing a framework-specific
+ * module, hence the outcome is memoized in 'nb_internals::tensor_import_cache'.
+ * When this isn't possible, 'temp' holds the reference to 'to_dlpack'.
+ */
+static tensor_import_entry tensor_import_lookup(PyTypeObject *tp,
+                                                object &temp) {
+    nb_internals &internals = internals_get();
+    auto it = internals.tensor_import_cache.find(tp);
+    if (it != internals.tensor_import_cache.end())
+        return it->second;
+
+    tensor_import_entry entry { nullptr, false, false,
+                                (uint8_t) tensor_framework::none };
+
+    entry.has_dlpack = PyObject_HasAttrString((PyObject *) tp, "__dlpack__");
+    entry.has_dlpack_device =
+        PyObject_HasAttrString((PyObject *) tp, "__dlpack_device__");
+
+    try {
+        const char *module_name =
+            borrow<str>(handle(tp).attr("__module__")).c_str();
+
+        object package;
+        if (strncmp(module_name, "tensorflow.", 11) == 0) {
+            package = module_::import_("tensorflow.experimental.dlpack");
+            entry.framework = (uint8_t) tensor_framework::tensorflow;
+        } else if (strcmp(module_name, "torch") == 0) {
+            package = module_::import_("torch.utils.dlpack");
+            entry.framework = (uint8_t) tensor_framework::pytorch;
+        } else if (strncmp(module_name, "jaxlib", 6) == 0) {
+            package = module_::import_("jax.dlpack");
+            entry.framework = (uint8_t) tensor_framework::jax;
+        } else if (strcmp(module_name, "numpy") == 0) {
+            entry.framework = (uint8_t) tensor_framework::numpy;
+        }
+
+        if (package.is_valid())
+            entry.to_dlpack = object(package.attr("to_dlpack")).release().ptr();
+    } catch (...) {
+        entry.to_dlpack = nullptr;
+    }
+
+    // Heap types that don't support weak references can't be cached
+    if (!type_cache_watch(internals, tp)) {
+        temp = steal(entry.to_dlpack);
+        return entry;
+    }
+
+    internals.tensor_import_cache[tp] = entry;
+    return entry;
+}
+
 tensor_handle *tensor_import(PyObject *o, const tensor_req *req,
                              bool convert) noexcept {
     object capsule;
+    uint8_t framework = (uint8_t) tensor_framework::none;
 
     // If this is not a capsule, try calling o.__dlpack__()
     if (!PyCapsule_CheckExact(o)) {
-        capsule = steal(PyObject_CallMethod(o, "__dlpack__", nullptr));
+        object temp;
+        tensor_import_entry entry = tensor_import_lookup(Py_TYPE(o), temp);
+        framework = entry.framework;
 
-        if (!capsule.is_valid()) {
-            PyErr_Clear();
-            PyTypeObject *tp = Py_TYPE(o);
+        if (entry.has_dlpack && entry.has_dlpack_device && req->req_stream)
+            capsule = steal(tensor_dlpack_stream(o, req->stream));
 
-            try {
-                const char *module_name =
-                    borrow<str>(handle(tp).attr("__module__")).c_str();
-
-                object package;
-                if (strncmp(module_name, "tensorflow.", 11) == 0)
-                    package = module_::import_("tensorflow.experimental.dlpack");
-                else if (strcmp(module_name, "torch") == 0)
-                    package = module_::import_("torch.utils.dlpack");
-                else if (strncmp(module_name, "jaxlib", 6) == 0)
-                    package = module_::import_("jax.dlpack");
-
-                if (package.is_valid())
-                    capsule = package.attr("to_dlpack")(handle(o));
-            } catch (...) {
-                capsule.clear();
-            }
+        if (entry.has_dlpack && !capsule.is_valid()) {
+            capsule = steal(PyObject_CallMethod(o, "__dlpack__", nullptr));
+            if (!capsule.is_valid())
+                PyErr_Clear();
+        }
+
+        if (!capsule.is_valid() && entry.to_dlpack) {
+            capsule = steal(
+                PyObject_CallFunctionObjArgs(entry.to_dlpack, o, nullptr));
+            if (!capsule.is_valid())
+                PyErr_Clear();
         }
 
         // Try creating a tensor via the buffer protocol
         if (!capsule.is_valid())
-            capsule = steal(dlpack_from_buffer_protocol(o));
+            capsule = steal(dlpack_from_buffer_protocol(o, req->accept_readonly));
 
         if (!capsule.is_valid())
             return nullptr;
@@ -332,7 +724,8 @@ tensor_handle *tensor_import(PyObject *o, const tensor_req *req,
         }
     }
 
-    scoped_pymalloc<int64_t> strides(t.ndim);
+    scoped_tensor_handle result((size_t) t.ndim);
+    int64_t *strides = tensor_handle_strides(result.th);
     if ((req->req_order || t.strides == nullptr) && t.ndim > 0) {
         size_t accum = 1;
 
@@ -365,7 +758,15 @@ tensor_handle *tensor_import(PyObject *o, const tensor_req *req,
         }
     }
 
-    // Support implicit conversion of 'dtype' and order
+    // Convert CPU tensors natively (cast and relayout in a single pass)
+    if (pass_device && pass_shape && (!pass_dtype || !pass_order) && convert &&
+        t.device.device_type == device::cpu::value) {
+        tensor_handle *result = tensor_convert(t, req);
+        if (result)
+            return result;
+    }
+
+    // Otherwise, ask the framework to perform the conversion
     if (pass_device && pass_shape && (!pass_dtype || !pass_order) && convert &&
         capsule.ptr() != o) {
         PyTypeObject *tp = Py_TYPE(o);
@@ -380,15 +781,20 @@ tensor_handle *tensor_import(PyObject *o, const tensor_req *req,
             return nullptr;
 
         const char *prefix = nullptr;
-        char dtype[8];
+        char dtype[11];
         switch (req->dtype.code) {
             case (uint8_t) dlpack::dtype_code::Int: prefix = "int"; break;
             case (uint8_t) dlpack::dtype_code::UInt: prefix = "uint"; break;
             case (uint8_t) dlpack::dtype_code::Float: prefix = "float"; break;
+            case (uint8_t) dlpack::dtype_code::Complex: prefix = "complex"; break;
+            case (uint8_t) dlpack::dtype_code::Bool: prefix = "bool"; break;
             default:
                 return nullptr;
         }
-        snprintf(dtype, sizeof(dtype), "%s%u", prefix, req->dtype.bits);
+        if (req->dtype.code == (uint8_t) dlpack::dtype_code::Bool)
+            snprintf(dtype, sizeof(dtype), "%s", prefix);
+        else
+            snprintf(dtype, sizeof(dtype), "%s%u", prefix, req->dtype.bits);
 
         object converted;
         try {
@@ -418,19 +824,20 @@ tensor_handle *tensor_import(PyObject *o, const tensor_req *req,
         return nullptr;
 
     // Create a reference-counted wrapper
-    scoped_pymalloc<tensor_handle> result;
-    result->tensor = (managed_tensor *) ptr;
-    result->refcount = 0;
-    result->owner = nullptr;
-    result->free_shape = false;
-    result->call_deleter = true;
+    tensor_handle *th = result.th;
+    th->tensor = (managed_tensor *) ptr;
+    th->source_framework = framework;
+    th->call_deleter = true;
+
+    if (framework != (uint8_t) tensor_framework::none) {
+        th->source = o;
+        Py_INCREF(o);
+    }
 
     // Ensure that the strides member is always initialized
-    if (t.strides) {
-        result->free_strides = false;
-    } else {
-        result->free_strides = true;
-        t.strides = strides.release();
+    if (!t.strides) {
+        th->strides_inline = true;
+        t.strides = strides;
     }
 
     // Mark the dltensor capsule as "consumed"
@@ -458,25 +865,298 @@ void tensor_dec_ref(tensor_handle *th) noexcept {
         fail("tensor_dec_ref(): reference count became negative!");
     } else if (rc_value == 1) {
         Py_XDECREF(th->owner);
+        Py_XDECREF(th->source);
         managed_tensor *mt = th->tensor;
-        if (th->free_shape) {
-            PyMem_Free(mt->dl_tensor.shape);
-            mt->dl_tensor.shape = nullptr;
-        }
-        if (th->free_strides) {
-            PyMem_Free(mt->dl_tensor.strides);
-            mt->dl_tensor.strides = nullptr;
-        }
         if (th->call_deleter) {
+            if (th->strides_inline)
+                mt->dl_tensor.strides = nullptr;
             if (mt->deleter)
                 mt->deleter(mt);
-        } else {
-            PyMem_Free(mt);
         }
-        PyMem_Free(th);
+        if (th->storage)
+            tensor_storage_free(th->storage, th->storage_class);
+        tensor_handle_free(th);
     }
 }
 
+template <typename Dst, typename Src> static bool tensor_fits(Src v) {
+    using L = std::numeric_limits<Dst>;
+    if constexpr (std::is_signed_v<Src> == std::is_signed_v<Dst>)
+        return v >= L::min() && v <= L::max();
+    else if constexpr (std::is_signed_v<Src>)
+        return v >= 0 && (std::make_unsigned_t<Src>) v <= L::max();
+    else
+        return v <= (std::make_unsigned_t<Dst>) L::max();
+}
+
+template <typename Dst, typename Src>
+static bool tensor_copy_1d(Dst *dst, const uint8_t *src, size_t n,
+                           int64_t stride) {
+    if (std::is_same_v<Dst, Src> && stride == 1) {
+        memcpy(dst, src, n * sizeof(Dst));
+        return true;
+    }
+
+    const Src *p = (const Src *) src;
+    if constexpr (std::is_integral_v<Dst> && std::is_integral_v<Src>) {
+        for (size_t i = 0; i < n; ++i, p += stride) {
+            Src v = *p;
+            if (!tensor_fits<Dst>(v))
+                return false;
+            dst[i] = (Dst) v;
+        }
+    } else {
+        for (size_t i = 0; i < n; ++i, p += stride)
+            dst[i] = (Dst) *p;
+    }
+
+    return true;
+}
+
+template <typename Dst>
+static bool tensor_load_1d(Dst *dst, dlpack::dtype dtype, const uint8_t *src,
+                           size_t n, int64_t stride) {
+    if (dtype.lanes != 1)
+        return false;
+
+    switch (dtype.code) {
+        case (uint8_t) dlpack::dtype_code::Int:
+            switch (dtype.bits) {
+                case 8:  return tensor_copy_1d<Dst, int8_t>(dst, src, n, stride);
+                case 16: return tensor_copy_1d<Dst, int16_t>(dst, src, n, stride);
+                case 32: return tensor_copy_1d<Dst, int32_t>(dst, src, n, stride);
+                case 64: return tensor_copy_1d<Dst, int64_t>(dst, src, n, stride);
+            }
+            break;
+
+        case (uint8_t) dlpack::dtype_code::UInt:
+            switch (dtype.bits) {
+                case 8:  return tensor_copy_1d<Dst, uint8_t>(dst, src, n, stride);
+                case 16: return tensor_copy_1d<Dst, uint16_t>(dst, src, n, stride);
+                case 32: return tensor_copy_1d<Dst, uint32_t>(dst, src, n, stride);
+                case 64: return tensor_copy_1d<Dst, uint64_t>(dst, src, n, stride);
+            }
+            break;
+
+        case (uint8_t) dlpack::dtype_code::Float:
+            if constexpr (std::is_floating_point_v<Dst>) {
+                switch (dtype.bits) {
+                    case 32: return tensor_copy_1d<Dst, float>(dst, src, n, stride);
+                    case 64: return tensor_copy_1d<Dst, double>(dst, src, n, stride);
+                }
+            }
+            break;
+    }
+
+    return false;
+}
+
+/// Signature of tensor_load_1d() with a type-erased destination
+using tensor_load_fn = bool (*)(void *, dlpack::dtype, const uint8_t *,
+                                size_t, int64_t);
+
+template <typename Dst>
+static bool tensor_load_1d_erased(void *dst, dlpack::dtype dtype,
+                                  const uint8_t *src, size_t n,
+                                  int64_t stride) {
+    return tensor_load_1d<Dst>((Dst *) dst, dtype, src, n, stride);
+}
+
+static tensor_load_fn tensor_load_fn_for(dlpack::dtype dtype) {
+    if (dtype.lanes != 1)
+        return nullptr;
+
+    switch (dtype.code) {
+        case (uint8_t) dlpack::dtype_code::Int:
+            switch (dtype.bits) {
+                case 8:  return tensor_load_1d_erased<int8_t>;
+                case 16: return tensor_load_1d_erased<int16_t>;
+                case 32: return tensor_load_1d_erased<int32_t>;
+                case 64: return tensor_load_1d_erased<int64_t>;
+            }
+            break;
+
+        case (uint8_t) dlpack::dtype_code::UInt:
+            switch (dtype.bits) {
+                case 8:  return tensor_load_1d_erased<uint8_t>;
+                case 16: return tensor_load_1d_erased<uint16_t>;
+                case 32: return tensor_load_1d_erased<uint32_t>;
+                case 64: return tensor_load_1d_erased<uint64_t>;
+            }
+            break;
+
+        case (uint8_t) dlpack::dtype_code::Float:
+            switch (dtype.bits) {
+                case 32: return tensor_load_1d_erased<float>;
+                case 64: return tensor_load_1d_erased<double>;
+            }
+            break;
+    }
+
+    return nullptr;
+}
+
+/**
+ * Copy a CPU tensor into a new C- or F-contiguous tensor with the dtype
+ * requested by 'req'. The rows of the innermost dimension are converted by
+ * tensor_load_1d(), whose loops are vectorized by the compiler. Returns NULL
+ * when the dtype pair is unsupported (e.g., float -> int) or a value doesn't
+ * fit the target type, in which case the caller may try other strategies.
+ */
+static tensor_handle *tensor_convert(const dlpack::tensor &t,
+                                     const tensor_req *req) noexcept {
+    dlpack::dtype dtype = req->req_dtype ? req->dtype : t.dtype;
+    tensor_load_fn load = tensor_load_fn_for(dtype);
+    size_t ndim = (size_t) t.ndim, itemsize = dtype.bits / 8,
+           src_itemsize = t.dtype.bits / 8;
+
+    if (!load || t.dtype.lanes != 1 || src_itemsize == 0 ||
+        ndim > vectorize_max_ndim)
+        return nullptr;
+
+    // Iterate over the dimensions in the memory order of the result
+    bool f_order = req->req_order == 'F';
+    size_t shape[vectorize_max_ndim], size = 1;
+    int64_t c_strides[vectorize_max_ndim], src_strides[vectorize_max_ndim],
+        dst_strides[vectorize_max_ndim];
+
+    for (size_t i = ndim; i-- > 0; ) {
+        c_strides[i] = (int64_t) size;
+        size *= (size_t) t.shape[i];
+    }
+
+    for (size_t i = 0; i < ndim; ++i) {
+        size_t j = f_order ? ndim - 1 - i : i;
+        shape[i] = (size_t) t.shape[j];
+        src_strides[i] = t.strides ? t.strides[j] : c_strides[j];
+    }
+
+    for (size_t i = 0, accum = 1; i < ndim; ++i) {
+        size_t j = f_order ? i : ndim - 1 - i;
+        dst_strides[j] = (int64_t) accum;
+        accum *= (size_t) t.shape[j];
+    }
+
+    void *data = malloc(size * itemsize + 1);
+    if (!data)
+        return nullptr;
+
+    PyObject *owner =
+        capsule_new(data, nullptr, [](void *p) noexcept { free(p); });
+    if (!owner) {
+        PyErr_Clear();
+        free(data);
+        return nullptr;
+    }
+
+    size_t inner = ndim ? shape[ndim - 1] : 1, outer = inner ? size / inner : 0;
+    int64_t inner_stride = ndim ? src_strides[ndim - 1] : 0;
+    size_t index[vectorize_max_ndim] { };
+    const uint8_t *base = (const uint8_t *) t.data + t.byte_offset;
+    uint8_t *dst = (uint8_t *) data;
+    bool success = true;
+
+    for (size_t o = 0; o < outer && success; ++o) {
+        int64_t offset = 0;
+        for (size_t j = 0; j + 1 < ndim; ++j)
+            offset += (int64_t) index[j] * src_strides[j];
+
+        success = load(dst, t.dtype, base + offset * (int64_t) src_itemsize,
+                       inner, inner_stride);
+        dst += inner * itemsize;
+
+        // Advance the multi-index over all but the innermost dimension
+        for (size_t j = ndim ? ndim - 1 : 0; j-- > 0; ) {
+            if (++index[j] < shape[j])
+                break;
+            index[j] = 0;
+        }
+    }
+
+    tensor_handle *result = nullptr;
+    if (success) {
+        size_t shape_out[vectorize_max_ndim];
+        for (size_t i = 0; i < ndim; ++i)
+            shape_out[i] = (size_t) t.shape[i];
+
+        try {
+            result = tensor_create(data, ndim, shape_out, owner, dst_strides,
+                                   &dtype, device::cpu::value, 0);
+        } catch (...) { }
+    }
+
+    Py_DECREF(owner);
+    return result;
+}
+
+bool tensor_load_arith(PyObject *o, uint8_t flags, uint8_t code, size_t size,
+                       void *(*resize)(void *, size_t), void *payload) noexcept {
+    tensor_req req;
+    tensor_handle *th = tensor_import(o, &req, false);
+    if (!th)
+        return false;
+
+    const dlpack::tensor &t = *tensor_inc_ref(th);
+    bool success = t.device.device_type == device::cpu::value &&
+                   t.ndim == 1 && t.dtype.lanes == 1;
+
+    if (success) {
+        // Conversions require the 'convert' flag, as in load_i32() etc.
+        bool exact = t.dtype.code == code && t.dtype.bits == size * 8;
+        success = exact || (flags & (uint8_t) cast_flags::convert);
+    }
+
+    if (success) {
+        size_t n = (size_t) t.shape[0];
+        void *dst = resize(payload, n);
+        success = dst || n == 0;
+
+        const uint8_t *src = (const uint8_t *) t.data + t.byte_offset;
+        #define NB_LOAD(T)                                                   \
+            success = tensor_load_1d<T>((T *) dst, t.dtype, src, n,          \
+                                        t.strides[0]);                       \
+            break;
+        if (success) {
+            switch (code) {
+                case (uint8_t) dlpack::dtype_code::Int:
+                    switch (size) {
+                        case 1: NB_LOAD(int8_t)
+                        case 2: NB_LOAD(int16_t)
+                        case 4: NB_LOAD(int32_t)
+                        case 8: NB_LOAD(int64_t)
+                        default: success = false;
+                    }
+                    break;
+
+                case (uint8_t) dlpack::dtype_code::UInt:
+                    switch (size) {
+                        case 1: NB_LOAD(uint8_t)
+                        case 2: NB_LOAD(uint16_t)
+                        case 4: NB_LOAD(uint32_t)
+                        case 8: NB_LOAD(uint64_t)
+                        default: success = false;
+                    }
+                    break;
+
+                case (uint8_t) dlpack::dtype_code::Float:
+                    switch (size) {
+                        case 4: NB_LOAD(float)
+                        case 8: NB_LOAD(double)
+                        default: success = false;
+                    }
+                    break;
+
+                default:
+                    success = false;
+            }
+        }
+        #undef NB_LOAD
+    }
+
+    tensor_dec_ref(th);
+    return success;
+}
+
 tensor_handle *tensor_create(void *value, size_t ndim, const size_t *shape_in,
                             PyObject *owner, const int64_t *strides_in,
                             dlpack::dtype *dtype, int32_t device_type,
@@ -492,9 +1172,10 @@ tensor_handle *tensor_create(void *value, size_t ndim, const size_t *shape_in,
 #endif
 
 
-    scoped_pymalloc<managed_tensor> tensor;
-    scoped_pymalloc<tensor_handle> result;
-    scoped_pymalloc<int64_t> shape(ndim), strides(ndim);
+    tensor_handle *result = tensor_handle_alloc(ndim);
+    managed_tensor *tensor = tensor_handle_mt(result);
+    int64_t *shape = tensor_handle_shape(result),
+            *strides = tensor_handle_strides(result);
 
     auto deleter = [](managed_tensor *mt) {
         gil_scoped_acquire guard;
@@ -526,18 +1207,64 @@ tensor_handle *tensor_create(void *value, size_t ndim, const size_t *shape_in,
     tensor->dl_tensor.ndim = (int32_t) ndim;
     tensor->dl_tensor.dtype = *dtype;
     tensor->dl_tensor.byte_offset = value_int - value_rounded;
-    tensor->dl_tensor.shape = shape.release();
-    tensor->dl_tensor.strides = strides.release();
-    tensor->manager_ctx = result.get();
+    tensor->dl_tensor.shape = shape;
+    tensor->dl_tensor.strides = strides;
+    tensor->manager_ctx = result;
     tensor->deleter = deleter;
-    result->tensor = (managed_tensor *) tensor.release();
-    result->refcount = 0;
+    result->tensor = tensor;
     result->owner = owner;
-    result->free_shape = true;
-    result->free_strides = true;
-    result->call_deleter = false;
+    result->source_framework = (uint8_t) tensor_framework::none;
     Py_XINCREF(owner);
-    return result.release();
+    return result;
+}
+
+tensor_handle *tensor_allocate(size_t ndim, const size_t *shape,
+                               dlpack::dtype *dtype, size_t alignment,
+                               char order) {
+    if (alignment == 0 || alignment > tensor_storage_max_alignment ||
+        (alignment & (alignment - 1)) != 0)
+        raise("nanobind::tensor::allocate(): the alignment must be a power "
+              "of two between 1 and %zu!", tensor_storage_max_alignment);
+
+    // Leave room for the alignment padding of aligned_malloc()
+    const size_t max_size = (size_t) PTRDIFF_MAX - tensor_storage_max_alignment;
+
+    size_t size = ((size_t) dtype->bits * dtype->lanes + 7) / 8;
+    for (size_t i = 0; i < ndim; ++i) {
+        if (shape[i] != 0 && size > max_size / shape[i])
+            raise("nanobind::tensor::allocate(): the requested tensor is too "
+                  "large!");
+        size *= shape[i];
+    }
+
+    std::vector<int64_t> f_strides;
+    if (order == 'F') {
+        f_strides.resize(ndim);
+        int64_t accum = 1;
+        for (size_t i = 0; i < ndim; ++i) {
+            f_strides[i] = accum;
+            accum *= (int64_t) shape[i];
+        }
+    }
+
+    uint8_t storage_class;
+    void *storage = tensor_storage_alloc(size, alignment, storage_class);
+    if (!storage)
+        throw std::bad_alloc();
+
+    tensor_handle *th;
+    try {
+        th = tensor_create(storage, ndim, shape, nullptr,
+                           order == 'F' ? f_strides.data() : nullptr, dtype,
+                           device::cpu::value, 0);
+    } catch (...) {
+        tensor_storage_free(storage, storage_class);
+        throw;
+    }
+
+    th->storage = storage;
+    th->storage_class = storage_class;
+    return th;
 }
 
 static void tensor_capsule_destructor(PyObject *o) {
@@ -550,25 +1277,23 @@ static void tensor_capsule_destructor(PyObject *o) {
         PyErr_Clear();
 }
 
-PyObject *tensor_wrap(tensor_handle *th, int framework) noexcept {
-    tensor_inc_ref(th);
-    object o = steal(PyCapsule_New(th->tensor, "dltensor", tensor_capsule_destructor)),
-           package;
-
-    switch ((tensor_framework) framework) {
-        case tensor_framework::none:
-            break;
+/// Return the cached function converting a DLPack capsule for 'framework'
+static PyObject *tensor_from_dlpack(nb_internals &internals,
+                                    tensor_framework framework) {
+    PyObject *&func = internals.tensor_from_dlpack[(int) framework];
+    if (func)
+        return func;
 
+    object package;
+    switch (framework) {
         case tensor_framework::numpy:
             package = module_::import_("numpy");
-            o = handle(internals_get().nb_tensor)(o);
             break;
 
         case tensor_framework::pytorch:
             package = module_::import_("torch.utils.dlpack");
             break;
 
-
         case tensor_framework::tensorflow:
             package = module_::import_("tensorflow.experimental.dlpack");
             break;
@@ -577,36 +1302,250 @@ PyObject *tensor_wrap(tensor_handle *th, int framework) noexcept {
             package = module_::import_("jax.dlpack");
             break;
 
-
         default:
             fail("nanobind::detail::tensor_wrap(): unknown framework "
                  "specified!");
     }
 
+    object result;
+    if (framework == tensor_framework::numpy) {
+        // Older NumPy versions provide '_from_dlpack()' or no DLPack support
+        internals.tensor_numpy_asarray =
+            object(package.attr("asarray")).release().ptr();
+        for (const char *name : { "from_dlpack", "_from_dlpack" }) {
+            if (hasattr(package, name)) {
+                result = package.attr(name);
+                break;
+            }
+        }
+        if (!result.is_valid())
+            result = borrow(internals.tensor_numpy_asarray);
+    } else {
+        result = package.attr("from_dlpack");
+    }
+
+    func = result.release().ptr();
+    return func;
+}
+
+void record_register(const std::type_info *type, size_t size,
+                     const record_field *fields, size_t nfields) {
+    std::vector<const record_field *> sorted(nfields);
+    for (size_t i = 0; i < nfields; ++i)
+        sorted[i] = fields + i;
+    std::sort(sorted.begin(), sorted.end(),
+              [](const record_field *a, const record_field *b) {
+                  return a->offset < b->offset;
+              });
+
+    std::string format = "T{";
+    size_t pos = 0;
+
+    for (const record_field *f : sorted) {
+        const char *fmt = dtype_format(f->dtype);
+        size_t field_size = f->dtype.bits / 8;
+        for (uint32_t i = 0; i < f->ndim; ++i)
+            field_size *= f->shape[i];
+
+        if (!fmt || f->offset < pos || f->offset + field_size > size ||
+            !f->name || !*f->name || strchr(f->name, ':'))
+            raise("nanobind::record_dtype(): invalid, overlapping, or "
+                  "unnamed field \"%s\"!", f->name ? f->name : "");
+
+        format.append(f->offset - pos, 'x');
+        format += '=';
+        if (f->ndim) {
+            format += '(';
+            for (uint32_t i = 0; i < f->ndim; ++i) {
+                if (i)
+                    format += ',';
+                format += std::to_string(f->shape[i]);
+            }
+            format += ')';
+        }
+        format += fmt;
+        format += ':';
+        format += f->name;
+        format += ':';
+        pos = f->offset + field_size;
+    }
+
+    format.append(size - pos, 'x');
+    format += '}';
+
+    nb_internals &internals = internals_get();
+    char *&entry = internals.record_formats[std::type_index(*type)];
+    free(entry);
+    entry = NB_STRDUP(format.c_str());
+}
+
+PyObject *tensor_wrap(tensor_handle *th, int framework, bool readonly,
+                      const std::type_info *record) noexcept {
+    nb_internals &internals = internals_get();
+
+    /* Records can't be expressed via DLPack. They are returned as 'nb_tensor'
+       (if no framework is specified) or converted via the buffer protocol */
+    const char *format = nullptr;
+    if (record) {
+        auto it = internals.record_formats.find(std::type_index(*record));
+        if (it == internals.record_formats.end()) {
+            char *name = type_name(record);
+            PyErr_Format(PyExc_TypeError,
+                         "nanobind::tensor: record type '%s' was not "
+                         "registered via nb::record_dtype()!", name);
+            free(name);
+            return nullptr;
+        }
+
+        if (framework != (int) tensor_framework::none &&
+            framework != (int) tensor_framework::numpy) {
+            PyErr_SetString(PyExc_TypeError,
+                            "nanobind::tensor: record tensors can only be "
+                            "returned as NumPy arrays!");
+            return nullptr;
+        }
+        format = it->second;
+    }
+
+    if (!record && th &&
+        th->tensor->dl_tensor.dtype.code == (uint8_t) dlpack::dtype_code::Record) {
+        PyErr_SetString(PyExc_TypeError,
+                        "nanobind::tensor: record tensors must be returned "
+                        "with a typed record scalar!");
+        return nullptr;
+    }
 
-    if (package.is_valid()) {
+    /* Return the original object if the tensor was imported from 'framework',
+       unless it must become read-only */
+    if (th && th->source && th->source_framework == framework &&
+        framework != (int) tensor_framework::none && !readonly) {
+        Py_INCREF(th->source);
+        return th->source;
+    }
+
+    tensor_inc_ref(th);
+    object o = steal(PyCapsule_New(th->tensor, "dltensor", tensor_capsule_destructor));
+
+    if (format) {
         try {
-            o = package.attr("from_dlpack")(o);
-        } catch (...) {
+            o = handle(internals.nb_tensor)(o);
+            ((nb_tensor *) o.ptr())->readonly = readonly;
+            ((nb_tensor *) o.ptr())->format = format;
             if ((tensor_framework) framework == tensor_framework::numpy) {
-                try {
-                    // Older numpy versions
-                    o = package.attr("_from_dlpack")(o);
-                } catch (...) {
-                    try {
-                        // Yet older numpy versions
-                        o = package.attr("asarray")(o);
-                    } catch (...) {
-                        return nullptr;
-                    }
-                }
-            } else {
-                return nullptr;
+                tensor_from_dlpack(internals, tensor_framework::numpy);
+                o = handle(internals.tensor_numpy_asarray)(o);
+            }
+            return o.release().ptr();
+        } catch (python_error &e) {
+            e.restore();
+            return nullptr;
+        } catch (...) {
+            return nullptr;
+        }
+    }
+
+    if ((tensor_framework) framework == tensor_framework::none)
+        return o.release().ptr();
+
+    try {
+        PyObject *func =
+            tensor_from_dlpack(internals, (tensor_framework) framework);
+
+        if ((tensor_framework) framework == tensor_framework::numpy) {
+            o = handle(internals.nb_tensor)(o);
+
+            // DLPack can't express read-only tensors, use the buffer protocol
+            if (readonly) {
+                ((nb_tensor *) o.ptr())->readonly = true;
+                func = internals.tensor_numpy_asarray;
+            }
+
+            try {
+                return handle(func)(o).release().ptr();
+            } catch (...) {
+                if (func == internals.tensor_numpy_asarray)
+                    throw;
+                return handle(internals.tensor_numpy_asarray)(o).release().ptr();
+            }
+        }
+
+        return handle(func)(o).release().ptr();
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+PyObject *tensor_bytes_buffer(void *data, size_t size, PyObject *owner) noexcept {
+    dlpack::dtype dt { (uint8_t) dlpack::dtype_code::UInt, 8, 1 };
+    tensor_handle *th = nullptr;
+
+    try {
+        th = tensor_create(data, 1, &size, owner, nullptr, &dt,
+                           device::cpu::value, 0);
+        tensor_inc_ref(th);
+        object capsule = steal(tensor_wrap(th, (int) tensor_framework::none,
+                                           true, nullptr));
+        tensor_dec_ref(th);
+        th = nullptr;
+        if (!capsule.is_valid())
+            return nullptr;
+
+        object o = handle(internals_get().nb_tensor)(capsule);
+        ((nb_tensor *) o.ptr())->readonly = true;
+        return o.release().ptr();
+    } catch (python_error &e) {
+        e.restore();
+    } catch (const std::exception &e) {
+        PyErr_SetString(PyExc_RuntimeError, e.what());
+    }
+
+    if (th)
+        tensor_dec_ref(th);
+    return nullptr;
+}
+
+size_t tensor_broadcast(size_t n, tensor_handle **th, const size_t *itemsize,
+                        size_t *shape, int64_t *strides) {
+    size_t ndim = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (th[i] && (size_t) th[i]->tensor->dl_tensor.ndim > ndim)
+            ndim = (size_t) th[i]->tensor->dl_tensor.ndim;
+    }
+
+    if (ndim > vectorize_max_ndim)
+        raise("nanobind::vectorize(): tensors with more than %zu dimensions "
+              "are not supported!", vectorize_max_ndim);
+
+    for (size_t j = 0; j < ndim; ++j)
+        shape[j] = 1;
+
+    for (size_t i = 0; i < n; ++i) {
+        int64_t *s = strides + i * vectorize_max_ndim;
+        for (size_t j = 0; j < ndim; ++j)
+            s[j] = 0;
+
+        if (!th[i])
+            continue;
+
+        const dlpack::tensor &t = th[i]->tensor->dl_tensor;
+        size_t offset = ndim - (size_t) t.ndim;
+
+        for (size_t j = 0; j < (size_t) t.ndim; ++j) {
+            size_t value = (size_t) t.shape[j];
+            size_t &target = shape[offset + j];
+
+            if (value != 1) {
+                if (target != 1 && target != value)
+                    raise("nanobind::vectorize(): incompatible shapes: "
+                          "argument %zu has size %zu along dimension %zu, "
+                          "expected %zu!", i + 1, value, j, target);
+                target = value;
+                s[offset + j] = t.strides[j] * (int64_t) itemsize[i];
             }
         }
     }
 
-    return o.release().ptr();
+    return ndim;
 }
 
 NAMESPACE_END(detail)
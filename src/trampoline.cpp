@@ -13,108 +13,173 @@
 NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
 
-void trampoline_new(void **data, size_t size, void *ptr,
-                    const std::type_info *cpp_type) noexcept {
+PyObject *trampoline_new(void *ptr, const std::type_info *cpp_type) noexcept {
     // GIL is held when the trampoline constructor runs
     nb_internals &internals = internals_get();
-    auto it = internals.inst_c2p.find(
-        std::pair<void *, std::type_index>(ptr, *cpp_type));
-    if (it == internals.inst_c2p.end())
+    type_data *t = nb_type_c2p(internals, cpp_type);
+    if (!t)
+        fail("nanobind::detail::trampoline_new(): type not found!");
+
+    nb_shard &shard = internals.shard(ptr);
+    nb_lock_guard guard(shard.mutex);
+
+    auto it = shard.inst_c2p.find(
+        std::pair<void *, const std::type_info *>(ptr, t->type));
+    if (it == shard.inst_c2p.end())
         fail("nanobind::detail::trampoline_new(): instance not found!");
 
-    data[0] = it->second;
-    memset(data + 1, 0, sizeof(void *) * 2 * size);
+    return (PyObject *) it->second;
+}
+
+void trampoline_cache_free(type_data *t) noexcept {
+    trampoline_cache *cache = (trampoline_cache *) t->trampoline_cache;
+    if (!cache)
+        return;
+    for (size_t i = 0; i < cache->size; ++i)
+        Py_XDECREF(cache->entries[i].key);
+    free(cache);
+    t->trampoline_cache = nullptr;
 }
 
-void trampoline_release(void **data, size_t size) noexcept {
-    // GIL is held when the trampoline destructor runs
-    for (size_t i = 0; i < size; ++i)
-        Py_XDECREF((PyObject *) data[i*2 + 2]);
+/**
+ * Caches are validated against a global epoch, which is advanced whenever an
+ * attribute of a nanobind type (or one of its Python subclasses) changes.
+ * This is cheaper than visiting all subclasses of the modified type.
+ */
+static std::atomic<size_t> trampoline_epoch { 1 };
+
+/// Forget cached override information of all types
+void trampoline_cache_invalidate() noexcept {
+    trampoline_epoch.fetch_add(1, std::memory_order_release);
 }
 
-PyObject *trampoline_lookup(void **data, size_t size, const char *name,
-                            bool pure) {
-    const PyObject *None = Py_None;
+static NB_INLINE bool trampoline_match(const trampoline_entry &e,
+                                       const char *name) {
+    return e.name == name || (e.name && strcmp(e.name, name) == 0);
+}
 
+PyObject *trampoline_lookup(PyObject *self, size_t size, size_t slot,
+                            const char *name, bool pure) {
     current_method cm = current_method_data;
-    if (cm.self == data[0] && (cm.name == name || strcmp(cm.name, name) == 0))
+    if (cm.self == self && (cm.name == name || strcmp(cm.name, name) == 0))
         return nullptr;
 
-    // First quick sweep without lock
-    for (size_t i = 0; i < size; i++) {
-        void *d_name  = data[2*i + 1],
-             *d_value = data[2*i + 2];
-        if (name == d_name && d_value)
-            return d_value != None ? (PyObject *) d_value : nullptr;
+    type_data *t = nb_type_data(Py_TYPE(self));
+
+    // Quick check of the per-type cache without lock
+    size_t epoch = trampoline_epoch.load(std::memory_order_acquire);
+    trampoline_cache *cache = (trampoline_cache *) t->trampoline_cache;
+    if (cache && cache->epoch == epoch && slot < cache->size) {
+        const trampoline_entry &e = cache->entries[slot];
+        if (e.state == 1 && trampoline_match(e, name))
+            return e.key;
+        else if (e.state == 2 && !pure && !cache->inst_dict &&
+                 trampoline_match(e, name))
+            return nullptr;
     }
 
     PyGILState_STATE state = PyGILState_Ensure();
 
-    // Nothing found -- retry, now with lock held
-    for (size_t i = 0; i < size; i++) {
-        void *d_name  = data[2*i + 1],
-             *d_value = data[2*i + 2];
-        if (name == d_name && d_value) {
-            PyGILState_Release(state);
-            return d_value != None ? (PyObject *) d_value : nullptr;
-        }
-    }
-
-    // Sill no luck -- perform a lookup and populate the trampoline
     const char *error = nullptr;
+    PyObject *key = nullptr, *value = nullptr;
     PyTypeObject *value_tp = nullptr;
-
-    size_t offset = 0;
-    for (; offset < size; offset++) {
-        if (data[2 * offset + 1] == nullptr &&
-            data[2 * offset + 2] == nullptr)
-            break;
-    }
-
+    trampoline_entry *e = nullptr;
+    bool shadowed = false;
     nb_internals &internals = internals_get();
-    PyObject *key = nullptr, *value = nullptr;
 
-    if (offset == size) {
-        error = "the trampoline ran out of slots (you will need to increase "
-                "the value provided to the NB_TRAMPOLINE() macro)";
-        goto fail;
+    cache = (trampoline_cache *) t->trampoline_cache;
+    if (!cache) {
+        cache = (trampoline_cache *) calloc(
+            1, sizeof(trampoline_cache) + sizeof(trampoline_entry) * size);
+        if (!cache) {
+            error = "out of memory";
+            goto fail;
+        }
+        cache->size = size;
+        cache->epoch = epoch;
+
+        // Instances with a dictionary may shadow the methods of their type
+        PyObject *dict = PyObject_GenericGetDict(self, nullptr);
+        cache->inst_dict = dict != nullptr;
+        Py_XDECREF(dict);
+        PyErr_Clear();
+
+        t->trampoline_cache = cache;
+    } else if (cache->epoch != epoch) {
+        for (size_t i = 0; i < cache->size; ++i)
+            cache->entries[i].state = 0;
+        cache->epoch = epoch;
     }
 
-    key = PyUnicode_InternFromString(name);
-    if (!key) {
-        error = "could not intern string";
-        goto fail;
+    // Find the entry associated with 'name' (or an unused one)
+    if (slot < cache->size && (!cache->entries[slot].name ||
+                               trampoline_match(cache->entries[slot], name))) {
+        e = &cache->entries[slot];
+    } else {
+        for (size_t i = 0; i < cache->size; ++i) {
+            if (trampoline_match(cache->entries[i], name)) {
+                e = &cache->entries[i];
+                break;
+            }
+        }
+
+        for (size_t i = 0; !e && i < cache->size; ++i) {
+            if (!cache->entries[i].name)
+                e = &cache->entries[i];
+        }
     }
 
-    value = PyObject_GetAttr((PyObject *) data[0], key);
-    if (!value) {
-        error = "lookup failed";
+    if (!e) {
+        error = "the trampoline ran out of slots (you will need to increase "
+                "the value provided to the NB_TRAMPOLINE() macro)";
         goto fail;
     }
 
-    value_tp = Py_TYPE(value);
-    Py_CLEAR(value);
+    if (e->state == 0) {
+        key = e->key;
+        if (!key) {
+            key = PyUnicode_InternFromString(name);
+            if (!key) {
+                error = "could not intern string";
+                goto fail;
+            }
+            e->key = key;
+            e->name = name;
+        }
 
-    if (value_tp == internals.nb_func || value_tp == internals.nb_method ||
-        value_tp == internals.nb_bound_method) {
-        if (pure) {
-            error = "tried to call a pure virtual function";
+        // Overrides are resolved once per type rather than per instance
+        value = PyObject_GetAttr((PyObject *) Py_TYPE(self), key);
+        if (!value) {
+            error = "lookup failed";
             goto fail;
         }
 
-        Py_DECREF(key);
-        key = Py_None;
-        Py_INCREF(Py_None);
+        value_tp = Py_TYPE(value);
+        Py_DECREF(value);
+
+        e->state = (value_tp == internals.nb_func ||
+                    value_tp == internals.nb_method) ? 2 : 1;
+    }
+
+    if (e->state == 2 && cache->inst_dict) {
+        PyObject *dict = PyObject_GenericGetDict(self, nullptr);
+        if (dict) {
+            shadowed = PyDict_Contains(dict, e->key) == 1;
+            Py_DECREF(dict);
+        }
+        PyErr_Clear();
     }
 
-    data[2 * offset + 1] = (void *) name;
-    data[2 * offset + 2] = key;
+    if (e->state == 2 && pure && !shadowed) {
+        error = "tried to call a pure virtual function";
+        goto fail;
+    }
 
     PyGILState_Release(state);
-    return key != None ? (PyObject *) key : nullptr;
+    return (e->state == 1 || shadowed) ? e->key : nullptr;
 
 fail:
-    type_data *t = nb_type_data(Py_TYPE((PyObject *) data[0]));
+    PyErr_Clear();
     PyGILState_Release(state);
 
     raise("nanobind::detail::get_trampoline('%s::%s()'): %s!",
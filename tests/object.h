@@ -100,7 +100,8 @@ private:
  *
  * Python binding code must invoke `object_init_py` and provide functions that
  * can be used to increase/decrease the Python reference count of an instance
- * (i.e., `Py_INCREF` / `Py_DECREF`).
+ * (i.e., `Py_INCREF` / `Py_DECREF`). nanobind provides the functions
+ * `nb::intrusive_inc_ref_py` and `nb::intrusive_dec_ref_py` for this purpose.
  */
 void object_init_py(void (*object_inc_ref_py)(PyObject *),
                     void (*object_dec_ref_py)(PyObject *));
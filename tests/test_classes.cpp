@@ -40,6 +40,14 @@ struct Struct {
     Struct &self() { return *this; }
 };
 
+struct alignas(64) PooledAligned {
+    int value;
+    PooledAligned(int value) : value(value) {
+        if (((uintptr_t) this) % 64)
+            throw std::runtime_error("data is not aligned!");
+    }
+};
+
 struct PairStruct {
     Struct s1;
     Struct s2;
@@ -241,6 +249,11 @@ NB_MODULE(test_classes_ext, m) {
         .def_readwrite("value", &D::value);
 
     m.def("get_d", [](const D &d) { return d.value; });
+    m.def("get_d_7", [](const D &d1, const D &d2, const D &d3, const D &d4,
+                        const D &d5, const D &d6, const D &d7) {
+        return d1.value + d2.value + d3.value + d4.value + d5.value + d6.value +
+               d7.value;
+    });
 
     struct Int {
         int i;
@@ -250,6 +263,11 @@ NB_MODULE(test_classes_ext, m) {
             i += o.i;
             return *this;
         }
+        Int operator*(int j) const { return {i * j}; }
+        Int operator-() const { return {-i}; }
+        bool operator==(Int o) const { return i == o.i; }
+        bool operator!=(Int o) const { return i != o.i; }
+        bool operator<(Int o) const { return i < o.i; }
     };
 
     // test13_operators
@@ -258,6 +276,17 @@ NB_MODULE(test_classes_ext, m) {
         .def(nb::self + nb::self)
         .def(nb::self += nb::self)
         .def(nb::self - float())
+        .def(nb::self * int())
+        .def("__rmul__", [](const Int &o, int j) { return Int{j * o.i + 1}; },
+             nb::is_operator())
+        .def(-nb::self)
+        .def("__or__", [](const Int &a, const Int &b) { return Int{a.i | b.i}; },
+             nb::is_operator())
+        .def("__ror__", [](const Int &a, const Int &b) { return Int{(b.i | a.i) + 100}; },
+             nb::is_operator())
+        .def(nb::self == nb::self)
+        .def(nb::self != nb::self)
+        .def(nb::self < nb::self)
         .def("__repr__", [](const Int &i) { return std::to_string(i.i); });
 
 
@@ -374,14 +403,75 @@ NB_MODULE(test_classes_ext, m) {
     m.def("none_2", [](Struct *s) { return s == nullptr; }, nb::arg("arg"));
     m.def("none_3", [](Struct *s) { return s == nullptr; }, nb::arg().none());
     m.def("none_4", [](Struct *s) { return s == nullptr; }, nb::arg("arg").none());
+    m.def("none_5", [](Struct &) { return 1; }, nb::arg().none());
+    m.def("none_5", [](nb::handle h) { return h.is_none() ? 2 : 3; }, nb::arg().none());
 
     // test25_is_final
     struct FinalType { };
     nb::class_<FinalType>(m, "FinalType", nb::is_final())
         .def(nb::init<>());
+    m.def("is_final_type", [](const FinalType *) { return true; });
+    m.def("is_final_type", [](nb::handle) { return false; });
 
     // test26_dynamic_attr
     struct StructWithAttr : Struct { };
     nb::class_<StructWithAttr, Struct>(m, "StructWithAttr", nb::dynamic_attr())
         .def(nb::init<int>());
+
+    nb::class_<PooledAligned>(m, "PooledAligned", nb::pooled(4))
+        .def(nb::init<int>())
+        .def_readwrite("value", &PooledAligned::value);
+
+    m.def("pooled_trim", [](size_t keep) {
+        return nb::type_pool_trim(nb::type<PooledAligned>(), keep);
+    });
+
+    struct ValueStruct { int i; };
+    nb::class_<ValueStruct>(m, "ValueStruct", nb::value_type())
+        .def(nb::init<int>())
+        .def_readwrite("i", &ValueStruct::i)
+        .def("self", [](ValueStruct &s) -> ValueStruct & { return s; },
+             nb::rv_policy::reference_internal)
+        .def("copy", [](ValueStruct &s) { return s; });
+
+    struct Fields {
+        bool b = true;
+        int8_t i8 = -8;
+        uint16_t u16 = 16;
+        int64_t i64 = -64;
+        float f = 1.5f;
+        double d = 2.5;
+        const int c = 3;
+        Struct s { 7 };
+        std::string str = "hello";
+    };
+
+    nb::class_<Fields>(m, "Fields")
+        .def(nb::init<>())
+        .def_readwrite("b", &Fields::b)
+        .def_readwrite("i8", &Fields::i8)
+        .def_readwrite("u16", &Fields::u16)
+        .def_readwrite("i64", &Fields::i64, "A 64 bit integer")
+        .def_readwrite("f", &Fields::f)
+        .def_readwrite("d", &Fields::d)
+        .def_readonly("c", &Fields::c)
+        .def_readwrite("s", &Fields::s)
+        .def_readwrite("str", &Fields::str);
+
+    struct PickledStruct {
+        int32_t i;
+        float f;
+        double d;
+    };
+
+    nb::class_<PickledStruct>(m, "PickledStruct", nb::trivial_pickle())
+        .def(nb::init<int32_t, float, double>())
+        .def_readwrite("i", &PickledStruct::i)
+        .def_readwrite("f", &PickledStruct::f)
+        .def_readwrite("d", &PickledStruct::d);
+
+    m.def("memory_stats", []() { return nb::memory_stats(); });
+    m.def("func_stats", []() { return nb::func_stats(); });
+    m.def("reset_func_stats", []() { nb::reset_func_stats(); });
+    m.def("enable_func_stats", [](bool value) { nb::enable_func_stats(value); });
 }
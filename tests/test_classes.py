@@ -260,6 +260,7 @@ def test13_implicitly_convertible():
     assert t.get_d(b) == 102
     assert t.get_d(b2) == 103
     assert t.get_d(d) == 10005
+    assert t.get_d_7(a, b, b2, 1, 2, 3, 4) == 40226
 
 
 def test14_operators():
@@ -460,6 +461,9 @@ def test24_none_arg():
         t.none_2(arg=None)
     assert t.none_3(None) is True
     assert t.none_4(arg=None) is True
+    assert t.none_5(None) == 2
+    assert t.none_5(t.Struct()) == 1
+    assert t.none_5(1) == 3
     assert t.none_0.__doc__ == 'none_0(arg: test_classes_ext.Struct, /) -> bool'
     assert t.none_1.__doc__ == 'none_1(arg: test_classes_ext.Struct) -> bool'
     assert t.none_2.__doc__ == 'none_2(arg: test_classes_ext.Struct) -> bool'
@@ -473,6 +477,10 @@ def test25_is_final():
             pass
     assert "The type 'test_classes_ext.FinalType' prohibits subclassing!" in str(excinfo.value)
 
+    assert t.is_final_type(t.FinalType())
+    assert not t.is_final_type(t.Struct())
+    assert not t.is_final_type(5)
+
 
 def test26_dynamic_attr(clean):
     l = [None] * 100
@@ -504,3 +512,388 @@ def test27_copy_rvp():
     a = t.Struct.create_reference()
     b = t.Struct.create_copy()
     assert a is not b
+
+def test28_stats():
+    a = t.A(1)
+    t.reset_func_stats()
+    t.enable_func_stats(True)
+    try:
+        assert t.get_d(a) == 11
+        assert t.get_d(5) == 10005
+        with pytest.raises(RuntimeError):
+            t.D(1.5)
+    finally:
+        t.enable_func_stats(False)
+    s = t.func_stats()
+    s_get_d = s[t.get_d]
+    assert s_get_d['calls'] == 2
+    assert s_get_d['implicit_conversions'] == 2
+    assert s_get_d['exceptions'] == 0
+    assert s_get_d['time'] > 0
+    # Implicit conversions construct 'D' directly without calling D.__init__
+    s_init = s[t.D.__init__]
+    assert s_init['calls'] == 1
+    assert s_init['exceptions'] == 1
+    assert s_init['attempts'] >= 1
+    assert t.A.__init__ not in s
+    t.reset_func_stats()
+    assert t.func_stats() == {}
+
+def test29_pooled():
+    t.pooled_trim(0)
+    x = [t.PooledAligned(i) for i in range(10)]
+    del x
+    for i in range(100):
+        assert t.PooledAligned(i).value == i
+    y = [t.PooledAligned(i) for i in range(3)]
+    assert [v.value for v in y] == [0, 1, 2]
+    del y
+    assert t.pooled_trim(1) == 3
+    assert t.pooled_trim(0) == 1
+    assert t.pooled_trim(0) == 0
+
+def test30_value_type():
+    a = t.ValueStruct(3)
+    c = a.copy()
+    assert c is not a and c.i == 3
+    c.i = 5
+    assert a.i == 3
+
+    # Internally stored instances are not registered, identity is not preserved
+    b = a.self()
+    assert b is not a and b.i == 3
+    b.i = 4
+    assert a.i == 4
+    del a
+    gc.collect()
+    assert b.i == 4
+    del b, c
+
+def test31_implicit_cache():
+    # Repeated conversions use the memoized outcome per (source, target) type
+    for i in range(3):
+        assert t.get_d(t.A(i)) == 10 + i
+        assert t.get_d(t.B2(i)) == 100 + i
+        assert t.get_d(i) == 10000 + i
+        with pytest.raises(TypeError):
+            t.get_d(t.C(i))
+
+    # Cache entries of Python types are purged when the type is destroyed
+    for i in range(3):
+        class SubA(t.A):
+            pass
+        class Other:
+            pass
+        assert t.get_d(SubA(i)) == 10 + i
+        with pytest.raises(TypeError):
+            t.get_d(Other())
+        del SubA, Other
+        gc.collect()
+
+    # Exceptions raised by a converting constructor produce a warning
+    with pytest.warns(RuntimeWarning, match='implicit conversion from type'):
+        with pytest.raises(TypeError):
+            t.get_d(1.5)
+
+def test32_keep_alive_slot():
+    import weakref
+
+    class Patient:
+        pass
+
+    # Instances with external storage keep their first patient inline
+    n = t.Struct.create_reference()
+    p1, p2 = Patient(), Patient()
+    w1, w2 = weakref.ref(p1), weakref.ref(p2)
+    assert t.keep_alive_arg(p1, n) is n
+    assert t.keep_alive_arg(p2, n) is n
+    assert t.keep_alive_arg(p1, n) is n
+    del p1, p2
+    gc.collect()
+    assert w1() is not None and w2() is not None
+    del n
+    gc.collect()
+    assert w1() is None and w2() is None
+
+
+def test33_trampoline_cache():
+    class Puppy(t.Animal):
+        def what(self):
+            return "woof"
+
+    class Pug(Puppy):
+        pass
+
+    p, q = Puppy(), Pug()
+    assert t.go(p) == 'Animal says woof'
+    assert t.go(q) == 'Animal says woof'
+    assert t.go(Puppy()) == 'Animal says woof'
+
+    # Override resolution is cached per type and refreshed on modification
+    Puppy.name = lambda self: "Puppy"
+    assert t.go(p) == 'Puppy says woof'
+    assert t.go(q) == 'Puppy says woof'
+
+    Pug.what = lambda self: "snort"
+    assert t.go(q) == 'Puppy says snort'
+    assert t.go(p) == 'Puppy says woof'
+
+    del Puppy.name
+    assert t.go(p) == 'Animal says woof'
+    assert t.go(q) == 'Animal says snort'
+
+    # Methods assigned to an instance shadow those of its type
+    q.name = lambda: "Max"
+    assert t.go(q) == 'Max says snort'
+    assert t.go(Pug()) == 'Animal says snort'
+    del q.name
+    assert t.go(q) == 'Animal says snort'
+
+
+def test34_vectorcall_constructor(clean):
+    # Direct calls, calls with an argument tuple, and overload errors
+    assert t.Struct(5).value() == 5
+    assert t.Struct(*(6,)).value() == 6
+    assert t.Struct.__call__(7).value() == 7
+    with pytest.raises(TypeError) as excinfo:
+        t.Struct("x")
+    assert 'incompatible function arguments' in str(excinfo.value)
+
+    class Derived(t.Struct):
+        def __init__(self, value):
+            super().__init__(value + 1)
+
+    assert Derived(1).value() == 2
+
+    # Replacing '__init__' disables the constructor shortcut
+    init = t.Struct.__dict__['__init__']
+    try:
+        t.Struct.__init__ = lambda self, v: init(self, v * 2)
+        assert t.Struct(4).value() == 8
+    finally:
+        t.Struct.__init__ = init
+    assert t.Struct(4).value() == 4
+    del init
+
+    assert_stats(value_constructed=6, destructed=6)
+
+
+def test35_direct_fields(clean):
+    f = t.Fields()
+    d = t.Fields.__dict__
+
+    # Arithmetic and bound-type members use getset descriptors
+    assert type(d['i8']).__name__ == 'getset_descriptor'
+    assert type(d['s']).__name__ == 'getset_descriptor'
+    assert type(d['str']) is property
+    assert d['i64'].__doc__ == 'A 64 bit integer'
+
+    assert f.b is True and f.i8 == -8 and f.u16 == 16 and f.i64 == -64
+    assert f.f == 1.5 and f.d == 2.5 and f.c == 3 and f.str == 'hello'
+
+    f.b = False
+    f.i8 = 127
+    f.u16 = 65535
+    f.i64 = -2**63
+    f.f = 3
+    f.d = 0.25
+    assert f.b is False and f.i8 == 127 and f.u16 == 65535
+    assert f.i64 == -2**63 and f.f == 3.0 and f.d == 0.25
+
+    for name, value in (('b', 1), ('i8', 128), ('u16', -1), ('i64', 1.5),
+                        ('d', 'x')):
+        with pytest.raises(TypeError) as excinfo:
+            setattr(f, name, value)
+        assert 'incompatible value' in str(excinfo.value)
+    assert f.b is False and f.i8 == 127 and f.u16 == 65535
+
+    with pytest.raises(AttributeError):
+        f.c = 4
+    with pytest.raises(AttributeError):
+        del f.i8
+
+    # Bound-type members are returned by reference and assigned by copy
+    s = f.s
+    assert s.value() == 7
+    s.set_value(8)
+    assert f.s.value() == 8
+    f.s = t.Struct(9)
+    assert s.value() == 9
+    with pytest.raises(TypeError):
+        f.s = 1.5
+    del f
+    assert s.value() == 9
+    del s
+    assert_stats(value_constructed=2, copy_assigned=1, destructed=2)
+
+
+def test36_operator_slots():
+    a, b = t.Int(2), t.Int(3)
+
+    # Forward, reflected, unary, and comparison operators
+    assert repr(a * 4) == "8"
+    assert repr(4 * a) == "9"
+    assert repr(-a) == "-2"
+    assert a == t.Int(2) and a != b and not (a != t.Int(2))
+    assert a < b and not (b < a)
+    assert b > a
+    assert (a == "test") is False
+    with pytest.raises(TypeError) as excinfo:
+        a * None
+    assert "unsupported operand type" in str(excinfo.value)
+    with pytest.raises(TypeError):
+        a <= b
+
+    # Python subclasses inherit the operators or override them
+    class Sub(t.Int):
+        pass
+
+    class Override(t.Int):
+        def __add__(self, other):
+            return "override"
+
+        def __rmul__(self, other):
+            return "rmul"
+
+    s = Sub(5)
+    assert repr(s + a) == "7" and repr(a + s) == "7"
+    assert repr(-s) == "-5"
+    o = Override(1)
+    assert o + a == "override"
+    assert repr(a + o) == "3"
+    assert 2 * o == "rmul"
+
+    # Assigning operators to the bound type afterwards
+    sub = t.Int.__dict__['__sub__']
+    try:
+        t.Int.__sub__ = lambda self, other: "sub"
+        assert a - b == "sub"
+    finally:
+        t.Int.__sub__ = sub
+    assert repr(a - 2) == "0"
+
+
+def test37_reimport_and_subinterpreters(clean):
+    import sys
+
+    # Importing the extension again shares the existing bindings
+    s = t.Struct(5)
+    m = sys.modules.pop('test_classes_ext')
+    try:
+        import test_classes_ext as t2
+        assert t2 is not m and t2.Struct is t.Struct
+        assert t2.Struct(5).value() == s.value()
+    finally:
+        sys.modules['test_classes_ext'] = m
+
+    try:
+        import _xxsubinterpreters
+    except ImportError:
+        pytest.skip('sub-interpreters are not supported')
+
+    # Each sub-interpreter registers its own types. This runs in a separate
+    # process, since CPython stops tracking the GIL state of threads once a
+    # sub-interpreter was created.
+    import os, subprocess
+    code = (
+        "import _xxsubinterpreters as interpreters\n"
+        "import test_classes_ext\n"
+        "for i in range(2):\n"
+        "    iid = interpreters.create()\n"
+        "    interpreters.run_string(iid, 'import test_classes_ext as t; "
+        "assert t.Struct(3).value() == 3; "
+        "assert repr(t.Int(1) + t.Int(2)) == \"3\"')\n"
+        "    interpreters.destroy(iid)\n"
+    )
+    env = dict(os.environ, PYTHONPATH=os.pathsep.join(sys.path))
+    result = subprocess.run([sys.executable, '-c', code], env=env,
+                            capture_output=True, text=True)
+    assert result.returncode == 0 and not result.stderr, result.stderr
+
+def test38_trivial_pickle():
+    import copy, pickle
+
+    a = t.PickledStruct(1, 2.5, 3.5)
+    assert bytes(memoryview(a)) == bytes(memoryview(copy.copy(a)))
+
+    for protocol in range(2, pickle.HIGHEST_PROTOCOL + 1):
+        b = pickle.loads(pickle.dumps(a, protocol=protocol))
+        assert type(b) is t.PickledStruct and b is not a
+        assert (b.i, b.f, b.d) == (1, 2.5, 3.5)
+
+    # Pickle protocol 5 transfers the instance data out-of-band
+    if pickle.HIGHEST_PROTOCOL >= 5:
+        buffers = []
+        data = pickle.dumps([a, a, t.PickledStruct(4, 5, 6)], protocol=5,
+                            buffer_callback=buffers.append)
+        assert len(buffers) == 2
+        b, c, d = pickle.loads(data, buffers=buffers)
+        assert c is b and (b.i, d.i) == (1, 4)
+
+    with pytest.raises(ValueError, match='expected 16 bytes, got 3'):
+        t.PickledStruct.__new__(t.PickledStruct).__setstate__(b'abc')
+    with pytest.raises(TypeError, match='already initialized'):
+        a.__setstate__(bytes(memoryview(a)))
+    with pytest.raises(TypeError, match='not initialized'):
+        t.PickledStruct.__new__(t.PickledStruct).__reduce_ex__(2)
+
+def test39_memory_stats(clean):
+    import builtins
+    nb = next(v for k, v in vars(builtins).items() if k.startswith('__nb_stats_v'))
+
+    def counts():
+        s = nb.memory_stats()
+        assert set(s) == {'types', 'inst_c2p', 'type_c2p', 'keep_alive',
+                          'funcs', 'tensor_handles'}
+        assert set(t.memory_stats()) == set(s)
+        assert 0 <= s['inst_c2p']['load_factor'] <= 1
+        assert s['type_c2p']['size'] > 10 and s['funcs'] > 50
+        return s['types'].get(t.Struct, dict.fromkeys(
+            ['internal', 'external', 'internal_bytes', 'external_bytes',
+             'keep_alive'], 0)), s['keep_alive']['size']
+
+    gc.collect()
+    before, nurses = counts()
+    a = [t.Struct(i) for i in range(3)]
+    b = t.Struct.create_reference()
+    t.keep_alive_ret(a[0], t.Struct(4))
+    t.keep_alive_ret(a[0], t.Struct(5))
+
+    after, nurses2 = counts()
+    assert after['internal'] - before['internal'] == 5
+    assert after['external'] - before['external'] == 1
+    assert after['internal_bytes'] - before['internal_bytes'] == 5 * 4
+    assert after['keep_alive'] - before['keep_alive'] == 2
+    assert nurses2 - nurses == 1
+
+    del a, b
+    gc.collect()
+    assert counts() == (before, nurses)
+
+
+def test40_operator_slots_subclass():
+    a = t.Int(2)
+
+    # An inherited reflected operator doesn't take precedence
+    class Sub(t.Int):
+        pass
+
+    class Override(t.Int):
+        def __ror__(self, other):
+            return "ror"
+
+    s, o = Sub(5), Override(5)
+    assert repr(a | s) == "7" and repr(s | a) == "7"
+    assert a | o == "ror" and repr(o | a) == "7"
+
+    # Reassigning an operator also updates the subclasses
+    op = t.Int.__dict__['__or__']
+    t.Int.__or__ = op
+    assert repr(a | s) == "7" and a | o == "ror"
+
+    class SubSub(Sub):
+        def __or__(self, other):
+            return "or"
+
+    assert SubSub(1) | a == "or"
+    assert repr(a | SubSub(1)) == "3"
@@ -5,6 +5,7 @@ namespace nb = nanobind;
 enum class Enum  : uint32_t { A, B, C = (uint32_t) -1 };
 enum class SEnum : int32_t { A, B, C = (int32_t) -1 };
 enum ClassicEnum { Item1, Item2 };
+enum class SparseEnum : int64_t { A = -1000000, B = 7, C = 1ll << 40 };
 
 struct EnumProperty { Enum get_enum() { return Enum::A; } };
 
@@ -27,9 +28,15 @@ NB_MODULE(test_enum_ext, m) {
         .value("Item2", ClassicEnum::Item2)
         .export_values();
 
+    nb::enum_<SparseEnum>(m, "SparseEnum")
+        .value("A", SparseEnum::A)
+        .value("B", SparseEnum::B)
+        .value("C", SparseEnum::C);
+
     m.def("from_enum", [](Enum value) { return (uint32_t) value; });
     m.def("to_enum", [](uint32_t value) { return (Enum) value; });
     m.def("from_enum", [](SEnum value) { return (int32_t) value; });
+    m.def("to_sparse_enum", [](int64_t value) { return (SparseEnum) value; });
 
     // test for issue #39
     nb::class_<EnumProperty>(m, "EnumProperty")
@@ -76,3 +76,40 @@ def test05_enum_property():
     w = t.EnumProperty()
     assert w.read_enum == t.Enum.A
     assert str(w.read_enum) == 'test_enum_ext.Enum.A'
+
+
+def test06_enum_singleton():
+    # C++ -> Python conversion returns the instances created by .value()
+    assert t.to_enum(0) is t.Enum.A
+    assert t.to_enum(0xffffffff) is t.Enum.C
+    assert t.SEnum(-1) is t.SEnum.C
+
+    for v, e in ((-1000000, t.SparseEnum.A), (7, t.SparseEnum.B),
+                 (1 << 40, t.SparseEnum.C)):
+        assert t.to_sparse_enum(v) is e
+        assert t.SparseEnum(v) is e
+        assert repr(e) == 'test_enum_ext.SparseEnum.' + e.__name__
+
+    # Values without an entry still convert, but have no name
+    assert int(t.to_sparse_enum(8)) == 8
+    with pytest.raises(RuntimeError):
+        t.to_sparse_enum(8).__name__
+    with pytest.raises(RuntimeError):
+        t.SparseEnum(8)
+
+
+def test07_enum_subclass_and_range():
+    # Python subclasses share the entries of their base
+    class Sub(t.Enum):
+        pass
+
+    assert Sub(0) is t.Enum.A
+    assert Sub(0xffffffff) is t.Enum.C
+
+    # Values outside the range of the underlying type aren't entries
+    for v in (-1, 1 << 32, 1 << 70):
+        with pytest.raises(RuntimeError):
+            t.Enum(v)
+    with pytest.raises(RuntimeError):
+        t.SEnum(1 << 70)
+
@@ -17,6 +17,21 @@ public:
     virtual const char *what() const noexcept { return "MyError3"; }
 };
 
+class MyError4 : public MyError3 {
+public:
+    virtual const char *what() const noexcept { return "MyError4"; }
+};
+
+class MyError5 : public std::exception {
+public:
+    virtual const char *what() const noexcept { return "MyError5"; }
+};
+
+class MyError6 : public MyError5 {
+public:
+    virtual const char *what() const noexcept { return "MyError6"; }
+};
+
 NB_MODULE(test_exception_ext, m) {
     m.def("raise_generic", [] { throw std::exception(); });
     m.def("raise_bad_alloc", [] { throw std::bad_alloc(); });
@@ -49,4 +64,35 @@ NB_MODULE(test_exception_ext, m) {
 
     nb::exception<MyError3>(m, "MyError3");
     m.def("raise_my_error_3", [] { throw MyError3(); });
+    m.def("raise_my_error_4", [] { throw MyError4(); });
+
+    nb::register_exception_translator<MyError5>(
+        [](const std::exception_ptr &p, void *payload) {
+            try {
+                std::rethrow_exception(p);
+            } catch (const MyError5 &e) {
+                PyErr_SetString((PyObject *) payload, e.what());
+            }
+        }, PyExc_KeyError);
+    m.def("raise_my_error_5", [] { throw MyError5(); });
+
+    // Overridden by the translator registered after it, see test22
+    nb::register_exception_translator<MyError6>(
+        [](const std::exception_ptr &p, void *payload) {
+            try {
+                std::rethrow_exception(p);
+            } catch (const MyError6 &e) {
+                PyErr_SetString((PyObject *) payload, e.what());
+            }
+        }, PyExc_KeyError);
+
+    nb::register_exception_translator(
+        [](const std::exception_ptr &p, void *) {
+            try {
+                std::rethrow_exception(p);
+            } catch (const MyError6 &e) {
+                PyErr_SetString(PyExc_ValueError, e.what());
+            }
+        });
+    m.def("raise_my_error_6", [] { throw MyError6(); });
 }
@@ -93,3 +93,22 @@ def test19_raise_my_error_3():
     with pytest.raises(t.MyError3) as excinfo:
         assert t.raise_my_error_3()
     assert str(excinfo.value) == 'MyError3'
+
+def test20_raise_my_error_4():
+    # Derived types are handled by the translator of the base class
+    with pytest.raises(t.MyError3) as excinfo:
+        assert t.raise_my_error_4()
+    assert str(excinfo.value) == 'MyError4'
+
+def test21_raise_my_error_5():
+    with pytest.raises(KeyError) as excinfo:
+        assert t.raise_my_error_5()
+    assert str(excinfo.value) == "'MyError5'"
+
+def test22_typed_translator_precedence():
+    # Translators registered later take precedence, even over typed ones
+    with pytest.raises(KeyError):
+        t.raise_my_error_5()
+    with pytest.raises(ValueError) as excinfo:
+        t.raise_my_error_6()
+    assert str(excinfo.value) == 'MyError6'
@@ -1,5 +1,10 @@
 #include <nanobind/nanobind.h>
 #include <nanobind/stl/pair.h>
+#include <nanobind/stl/string.h>
+#include <nanobind/async_callback.h>
+#include <chrono>
+#include <thread>
+#include <vector>
 
 namespace nb = nanobind;
 using namespace nb::literals;
@@ -146,4 +151,86 @@ NB_MODULE(test_functions_ext, m) {
     m.def("test_16", [](const char *c) { return nb::bytes(c); });
     m.def("test_17", [](nb::bytes c) { return c.size(); });
     m.def("test_18", [](const char *c, int size) { return nb::bytes(c, size); });
+
+    // Overload chains whose resolution depends on argument values
+    m.def("test_19", [](char) { return 1; });
+    m.def("test_19", [](const char *) { return 2; });
+    m.def("test_19", [](float) { return 3; });
+    m.def("test_20", [](int32_t) { return 1; });
+    m.def("test_20", [](int64_t) { return 2; });
+
+    // Keyword arguments with long names
+    m.def("test_21", [](int tolerance, int max_iter) { return tolerance - max_iter; },
+          "tolerance"_a, "max_iter"_a = 10);
+
+    // Release the GIL after argument conversion
+    m.def("test_22", [](int i) -> int {
+#if defined(Py_LIMITED_API)
+        return i;
+#else
+        return PyGILState_Check() ? -1 : i;
+#endif
+    }, nb::gil_released(), "Return the input argument.");
+
+    m.def("test_22_obj", [](const nb::object &o, std::string s) {
+        return o.ptr() == Py_True ? s : std::string();
+    }, nb::gil_released());
+
+    m.def("test_interned_str", [](const char *s) { return nb::interned_str(s); });
+    m.def("test_intern_name", []() { return nb::borrow(NB_INTERN("shape")); });
+    m.def("test_intern_access", [](nb::handle o, nb::dict d) {
+        nb::setattr(o, NB_INTERN("shape"), nb::cast(5));
+        d[NB_INTERN("shape")] = o.attr(NB_INTERN("shape"));
+        return nb::getattr(o, NB_INTERN("dtype"), nb::none());
+    });
+    m.def("test_cstr_ret", [](int i) { return i ? "ascii" : "n\u00e4\u00efve"; });
+
+    // Functions that are only created upon first access
+    m.def("test_lazy", [](int i) { return i + 1; }, "i"_a = 1, nb::lazy());
+    m.def("test_lazy", [](const char *s) { return std::string(s) + "!"; },
+          nb::lazy());
+    std::string suffix = "?";
+    m.def("test_lazy_2", [suffix](const char *s) { return s + suffix; },
+          nb::lazy(), "Lazy function with a non-trivial capture.");
+    m.def("test_lazy_3", []() { return 3; }, nb::lazy());
+
+    // Callbacks that worker threads queue without acquiring the GIL
+    m.def("test_async", [](nb::async_callback<void(int, const std::string &)> cb,
+                           int threads, int calls, bool drain) -> size_t {
+        {
+            nb::gil_scoped_release release;
+            std::vector<std::thread> workers;
+            for (int i = 0; i < threads; ++i)
+                workers.emplace_back([&cb, i, calls] {
+                    for (int j = 0; j < calls; ++j)
+                        cb(j, std::to_string(i));
+                });
+            for (std::thread &t : workers)
+                t.join();
+        }
+        return drain ? nb::async_drain() : 0;
+    });
+
+    // A worker thread that outlives the call (and possibly the interpreter)
+    m.def("test_async_detached",
+          [](nb::async_callback<void(int, const std::string &)> cb, int calls) {
+        std::thread([cb = std::move(cb), calls] {
+            for (int j = 0; j < calls; ++j) {
+                cb(j, "x");
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }).detach();
+    });
+
+    // Repeated calls of a pre-resolved method
+    m.def("test_bound_call", [](nb::handle self, const char *name, int n) {
+        nb::bound_call f(self, name);
+        nb::object result = nb::none();
+        for (int i = 0; i < n; ++i)
+            result = f(i, "x");
+        return nb::make_tuple(result, f.self().is_valid());
+    });
+    m.def("test_bound_call_func", [](nb::handle func) {
+        return nb::bound_call(func)(1, 2);
+    });
 }
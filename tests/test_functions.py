@@ -203,3 +203,216 @@ def test23_byte_return():
     assert t.test_17(b"four") == 4
     assert t.test_17(b"\x00\x00\x00\x00") == 4
     assert t.test_18("hello world", 5) == b"hello"
+
+
+def test24_overload_cache():
+    # Repeated calls must dispatch consistently with an uncached resolution
+    for i in range(3):
+        assert t.test_19("ab") == 2
+        assert t.test_19("a") == 1
+        assert t.test_19(1.0) == 3
+        assert t.test_19("ab") == 2
+        assert t.test_20(2**40) == 2
+        assert t.test_20(1) == 1
+
+
+def test25_kwargs_non_interned():
+    assert t.test_21(tolerance=5) == -5
+    assert t.test_21(max_iter=2, tolerance=5) == 3
+
+    # Keyword names that were constructed at runtime aren't interned
+    kw = { "".join(["toler", "ance"]): 5, "_".join(["max", "iter"]): 3 }
+    assert t.test_21(**kw) == 2
+
+
+def test26_gil_released():
+    assert t.test_22(5) == 5
+    assert t.test_22.__doc__ == (
+        "test_22(arg: int, /) -> int\n\n"
+        "Return the input argument.\n\n"
+        "Releases the GIL while running.")
+    assert t.test_22_obj(True, "abc") == "abc"
+    assert t.test_22_obj(1, "abc") == ""
+    assert t.test_release_gil.__doc__ == (
+        "test_release_gil() -> bool\n\n"
+        "Releases the GIL while running.")
+
+
+def test27_signature_cache():
+    assert t.test_05.__doc__ is t.test_05.__doc__
+    assert t.test_02.__text_signature__ == "(j=8, k=1)"
+    assert t.test_02.__text_signature__ is t.test_02.__text_signature__
+    assert t.test_22.__text_signature__ == "(arg, /)"
+    assert t.test_05.__text_signature__ is None
+    assert t.test_08.__text_signature__ is None
+
+
+def test28_strings():
+    a = t.test_interned_str('column_' + str(1))
+    b = t.test_interned_str('column_' + str(1))
+    assert a == 'column_1' and a is b
+    long = 'x' * 1000 + str(5)
+    assert t.test_interned_str(long) == long
+    assert t.test_interned_str('äö') == 'äö'
+    assert t.test_intern_name() == 'shape'
+    assert t.test_intern_name() is t.test_intern_name()
+
+    class A:
+        pass
+    a, d = A(), {}
+    assert t.test_intern_access(a, d) is None
+    assert a.shape == 5 and d == {'shape': 5}
+    a.dtype = 'float32'
+    assert t.test_intern_access(a, d) == 'float32'
+    assert t.test_cstr_ret(1) == 'ascii'
+    assert t.test_cstr_ret(0) == 'näïve'
+
+
+def test29_lazy_functions():
+    assert 'test_lazy' not in t.__dict__ and 'test_lazy' in dir(t)
+    assert 'test_lazy_2' in dir(t)
+    assert t.test_lazy() == 2 and t.test_lazy(i=5) == 6
+    assert t.test_lazy('hi') == 'hi!'
+    assert 'test_lazy' in t.__dict__
+    assert t.test_lazy is t.test_lazy
+    assert t.test_lazy_2('hi') == 'hi?'
+    assert t.test_lazy_2.__doc__.endswith('Lazy function with a non-trivial capture.')
+
+    with pytest.raises(AttributeError) as excinfo:
+        t.does_not_exist
+    assert "has no attribute 'does_not_exist'" in str(excinfo.value)
+    assert not hasattr(t, 'does_not_exist')
+
+def test30_async_callback():
+    import builtins, sys
+    nb = next(v for k, v in vars(builtins).items() if k.startswith('__nb_stats_v'))
+    calls = []
+
+    # Calls queued by worker threads are run in one batch
+    assert t.test_async(lambda i, s: calls.append((s, i)), 4, 100, True) == 400
+    assert len(calls) == 400
+    for s in '0123':
+        assert [i for s2, i in calls if s2 == s] == list(range(100))
+    assert nb.drain_callbacks() == 0
+
+    # Otherwise, the calls run once the interpreter handles pending calls
+    calls.clear()
+    t.test_async(lambda i, s: calls.append(i), 1, 10, False)
+    assert calls == list(range(10))
+
+    # Exceptions are reported via sys.unraisablehook
+    errors = []
+    hook, sys.unraisablehook = sys.unraisablehook, errors.append
+    try:
+        t.test_async(lambda i, s: 1 / i, 1, 2, True)
+    finally:
+        sys.unraisablehook = hook
+    assert len(errors) == 1 and errors[0].exc_type is ZeroDivisionError
+
+    assert t.test_async.__doc__.startswith(
+        'test_async(arg0: Callable[[int, str], None], arg1: int, arg2: int, '
+        'arg3: bool, /) -> int')
+
+
+def test31_bound_call():
+    class A:
+        def __init__(self):
+            self.calls = []
+
+        def f(self, i, s):
+            self.calls.append((i, s))
+            return i * 2
+
+    # Python methods are split into the function and 'self'
+    a = A()
+    assert t.test_bound_call(a, 'f', 3) == (4, True)
+    assert a.calls == [(0, 'x'), (1, 'x'), (2, 'x')]
+
+    # Other callables are called as they are
+    calls = []
+    a.g = lambda i, s: calls.append(i)
+    assert t.test_bound_call(a, 'g', 2) == (None, False)
+    assert calls == [0, 1]
+    assert t.test_bound_call_func(lambda a, b: a - b) == -1
+
+    with pytest.raises(AttributeError):
+        t.test_bound_call(a, 'h', 1)
+    with pytest.raises(TypeError):
+        t.test_bound_call_func(lambda: None)
+
+
+def test32_async_callback_subinterpreter():
+    try:
+        import _xxsubinterpreters
+    except ImportError:
+        pytest.skip('sub-interpreters are not supported')
+
+    # Calls are queued and run in the interpreter that created the callback
+    # (in a separate process, see test37 of test_classes.py)
+    import os, subprocess, sys
+    code = (
+        "import _xxsubinterpreters as interpreters\n"
+        "import test_functions_ext as t\n"
+        "calls = []\n"
+        "iid = interpreters.create()\n"
+        "interpreters.run_string(iid, 'import test_functions_ext as t; "
+        "calls = []; t.test_async(lambda i, s: calls.append(i), 2, 50, False); "
+        "assert sorted(calls) == sorted(2 * list(range(50)))')\n"
+        "interpreters.destroy(iid)\n"
+        "t.test_async(lambda i, s: calls.append(i), 1, 10, False)\n"
+        "assert calls == list(range(10))\n"
+    )
+    env = dict(os.environ, PYTHONPATH=os.pathsep.join(sys.path))
+    result = subprocess.run([sys.executable, '-c', code], env=env,
+                            capture_output=True, text=True)
+    assert result.returncode == 0 and not result.stderr, result.stderr
+
+
+def test32_async_callback_shutdown():
+    # Calls queued during shutdown run from an atexit handler, later ones and
+    # the release of the callable are skipped (in a separate process)
+    import os, subprocess, sys
+    code = (
+        "import atexit, time, test_functions_ext as t\n"
+        "atexit.register(time.sleep, 0.5)\n"
+        "t.test_async_detached(lambda i, s: None, 30)\n"
+    )
+    env = dict(os.environ, PYTHONPATH=os.pathsep.join(sys.path))
+    result = subprocess.run([sys.executable, '-c', code], env=env,
+                            capture_output=True, text=True)
+    assert result.returncode == 0 and not result.stderr, result.stderr
+
+
+def test33_intern_subinterpreter():
+    try:
+        import _xxsubinterpreters
+    except ImportError:
+        pytest.skip('sub-interpreters are not supported')
+
+    # Each interpreter creates its own NB_INTERN() strings
+    import os, subprocess, sys
+    code = (
+        "import _xxsubinterpreters as interpreters\n"
+        "import test_functions_ext as t\n"
+        "assert t.test_intern_name() == 'shape'\n"
+        "iid = interpreters.create()\n"
+        "interpreters.run_string(iid, 'import test_functions_ext as t; "
+        "assert t.test_intern_name() == \"shape\"; "
+        "assert t.test_intern_name() is t.test_intern_name()')\n"
+        "interpreters.destroy(iid)\n"
+        "assert t.test_intern_name() is t.test_intern_name()\n"
+    )
+    env = dict(os.environ, PYTHONPATH=os.pathsep.join(sys.path))
+    result = subprocess.run([sys.executable, '-c', code], env=env,
+                            capture_output=True, text=True)
+    assert result.returncode == 0 and not result.stderr, result.stderr
+
+
+def test34_lazy_star_import():
+    # Star imports create and import pending functions
+    assert 'test_lazy_3' not in vars(t) and 'test_lazy_3' in t.__all__
+    assert not any(name.startswith('_') for name in t.__all__)
+    ns = {}
+    exec('from test_functions_ext import *', ns)
+    assert ns['test_lazy_3']() == 3 and 'test_lazy_3' in vars(t)
+    assert ns['test_lazy'] is t.test_lazy and 'test_async' in ns
@@ -28,7 +28,7 @@ struct UniqueWrapper { std::unique_ptr<Example> value; };
 struct UniqueWrapper2 { std::unique_ptr<Example, nb::deleter<Example>> value; };
 
 NB_MODULE(test_holders_ext, m) {
-    nb::class_<Example>(m, "Example")
+    nb::class_<Example>(m, "Example", nb::dynamic_attr())
         .def(nb::init<int>())
         .def_readwrite("value", &Example::value)
         .def_static("make", &Example::make)
@@ -42,7 +42,9 @@ NB_MODULE(test_holders_ext, m) {
         .def_property("value",
             [](SharedWrapper &t) { return t.value->value; },
             [](SharedWrapper &t, int value) { t.value->value = value; }
-        );
+        )
+        .def_property_readonly("use_count",
+            [](SharedWrapper &t) { return t.value.use_count(); });
 
     m.def("query_shared_1", [](Example *shared) { return shared->value; });
     m.def("query_shared_2",
@@ -143,3 +143,40 @@ def test07_uniqueptr_passthrough(clean):
             assert t.passthrough_unique(t.Example(1)).value == 1
     assert t.passthrough_unique_2(t.Example(1)).value == 1
     assert t.stats() == (2, 2)
+
+
+def test08_sharedptr_control_block(clean):
+    # Repeated conversions of the same instance share one control block
+    e = t.Example(7)
+    w1 = t.SharedWrapper(e)
+    w2 = t.SharedWrapper(e)
+    assert w1.use_count == 2 and w2.use_count == 2
+    del w1
+    assert w2.use_count == 1
+    del w2
+    gc.collect()
+    assert t.stats() == (1, 0)
+
+    # .. and a new one is created once the previous one has expired
+    w3 = t.SharedWrapper(e)
+    assert w3.use_count == 1
+    assert w3.ptr is e
+    del w3, e
+    gc.collect()
+    assert t.stats() == (1, 1)
+
+    # Instances returned by C++ also share one control block, which keeps
+    # the Python instance alive
+    e = t.Example.make_shared(8)
+    e.tag = 'tag'
+    w1 = t.SharedWrapper(e)
+    w2 = t.SharedWrapper(e)
+    assert w1.use_count == 2
+    del e
+    gc.collect()
+    assert w1.use_count == 2
+    assert w2.value == 8
+    assert w1.ptr is w2.ptr and w1.ptr.tag == 'tag'
+    del w1, w2
+    gc.collect()
+    assert t.stats() == (2, 2)
@@ -3,6 +3,9 @@
 #include <nanobind/trampoline.h>
 #include "object.h"
 #include "object_py.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 namespace nb = nanobind;
 using namespace nb::literals;
@@ -24,6 +27,10 @@ public:
 
     static Test *create_raw() { return new Test(); }
     static ref<Test> create_ref() { return new Test(); }
+    static Test *create_static() {
+        static Test *instance = new Test();
+        return instance;
+    }
 };
 
 class PyTest : Test {
@@ -53,7 +60,45 @@ NB_MODULE(test_intrusive_ext, m) {
         .def(nb::init<>())
         .def("value", &Test::value)
         .def_static("create_raw", &Test::create_raw)
-        .def_static("create_ref", &Test::create_ref);
+        .def_static("create_ref", &Test::create_ref)
+        .def_static("create_static", &Test::create_static);
+
+    m.def("make_immortal", [](nb::handle h) { nb::inst_make_immortal(h); });
+    m.def("is_immortal", [](nb::handle h) { return nb::inst_immortal(h); });
+
+    // Reference count change by the hooks while holding/not holding the GIL
+    m.def("hook_refcount_delta", [](nb::handle h, bool release) {
+        Py_ssize_t before = Py_REFCNT(h.ptr()), after;
+        if (release) {
+            nb::gil_scoped_release guard;
+            nb::intrusive_inc_ref_py(h.ptr());
+        } else {
+            nb::intrusive_inc_ref_py(h.ptr());
+        }
+        after = Py_REFCNT(h.ptr());
+        if (release) {
+            nb::gil_scoped_release guard;
+            nb::intrusive_dec_ref_py(h.ptr());
+        } else {
+            nb::intrusive_dec_ref_py(h.ptr());
+        }
+        return after - before;
+    });
+
+    // Do the hooks wait for the GIL while another thread holds it?
+    m.def("hook_waits_for_gil", [](nb::handle h) {
+        std::atomic<bool> done { false };
+        std::thread thread([&] {
+            nb::intrusive_inc_ref_py(h.ptr());
+            nb::intrusive_dec_ref_py(h.ptr());
+            done = true;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        bool waited = !done;
+        nb::gil_scoped_release guard;
+        thread.join();
+        return waited;
+    });
 
     m.def("reset", [] {
         test_constructed = 0;
@@ -1,6 +1,7 @@
 import test_intrusive_ext as t
 import pytest
 import gc
+import sys
 
 @pytest.fixture
 def clean():
@@ -61,3 +62,39 @@ def test04_subclass(clean):
     gc.collect()
     gc.collect()
     assert t.stats() == (1, 1)
+
+
+def test05_immortal(clean):
+    o = t.Test.create_static()
+    assert not t.is_immortal(o)
+    t.make_immortal(o)
+    t.make_immortal(o)
+    assert t.is_immortal(o)
+
+    # The wrapper survives, and the hooks don't touch its refcount
+    assert t.hook_refcount_delta(o, False) == 0
+    assert t.hook_refcount_delta(o, True) == 0
+    rc = sys.getrefcount(o)
+    assert t.get_value_1(o) == 123 and t.get_value_2(o) == 123
+    assert sys.getrefcount(o) == rc
+    i = id(o)
+    del o
+    gc.collect()
+    gc.collect()
+    o = t.Test.create_static()
+    assert id(o) == i and t.is_immortal(o)
+    assert t.stats() == (1, 0)
+
+
+def test06_hooks(clean):
+    o = t.Test()
+    assert t.hook_refcount_delta(o, False) == 1
+    assert t.hook_refcount_delta(o, True) == 1
+
+    refcount = sys.getrefcount(o)
+    assert t.hook_waits_for_gil(o)
+    assert sys.getrefcount(o) == refcount
+
+    del o
+    gc.collect()
+    assert t.stats() == (1, 1)
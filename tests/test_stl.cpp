@@ -2,12 +2,15 @@
 #include <nanobind/stl/pair.h>
 #include <nanobind/stl/vector.h>
 #include <nanobind/stl/function.h>
+#include <nanobind/stl/future.h>
 #include <nanobind/stl/list.h>
 #include <nanobind/stl/string.h>
 #include <nanobind/stl/string_view.h>
 #include <nanobind/stl/optional.h>
 #include <nanobind/stl/variant.h>
 #include <nanobind/stl/map.h>
+#include <chrono>
+#include <thread>
 
 NB_MAKE_OPAQUE(NB_TYPE(std::vector<float, std::allocator<float>>))
 
@@ -17,6 +20,13 @@ static int default_constructed = 0, value_constructed = 0, copy_constructed = 0,
            move_constructed = 0, copy_assigned = 0, move_assigned = 0,
            destructed = 0;
 
+struct Adder {
+    int k;
+    int operator()(int l) const { return k + l; }
+};
+
+static int times_two(int x) { return 2 * x; }
+
 struct Movable {
     int value = 5;
 
@@ -29,6 +39,12 @@ struct Movable {
     ~Movable() { destructed++; }
 };
 
+struct MovableLess {
+    bool operator()(const Movable &a, const Movable &b) const {
+        return a.value < b.value;
+    }
+};
+
 struct Copyable {
     int value = 5;
 
@@ -41,6 +57,22 @@ struct Copyable {
 
 void fail() { throw std::exception(); }
 
+struct Tagged { int value; };
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+// Custom caster of a bound type that returns plain integers to Python
+template <> struct type_caster<Tagged> : type_caster_base<Tagged> {
+    template <typename T>
+    static handle from_cpp(T &&value, rv_policy, cleanup_list *) noexcept {
+        return PyLong_FromLong(value.value);
+    }
+};
+
+NAMESPACE_END(detail)
+NAMESPACE_END(NB_NAMESPACE)
+
 NB_MODULE(test_stl_ext, m) {
     m.def("stats", []{
         nb::dict d;
@@ -225,6 +257,12 @@ NB_MODULE(test_stl_ext, m) {
             x.emplace(std::string(1, 'a' + i), i);
         return x;
     });
+    m.def("map_return_movable_key", [](){
+        std::map<Movable, int, MovableLess> x;
+        for (int i = 0; i < 3; ++i)
+            x.emplace(Movable(i), i);
+        return x;
+    });
     m.def("map_return_copyable_value", [](){
         std::map<std::string, Copyable> x;
         for (int i = 0; i < 10; ++i) {
@@ -273,4 +311,117 @@ NB_MODULE(test_stl_ext, m) {
             if (x[key]->value != i) fail();
         }
     }, nb::arg("x"));
+
+    // ----- test55 ------ */
+    m.def("vec_sum_f64", [](const std::vector<double> &x) {
+        double sum = 0;
+        for (double v : x)
+            sum += v;
+        return sum;
+    });
+    m.def("vec_i32", [](const std::vector<int32_t> &x) { return x; });
+    m.def("vec_u8", [](const std::vector<uint8_t> &x) { return x; });
+    m.def("vec_i32_noconvert", [](const std::vector<int32_t> &x) { return x; },
+          nb::arg("x").noconvert());
+
+    // ----- test56 ------ */
+    m.def("map_return_str", [](int n) {
+        std::map<std::string, int> x;
+        for (int i = 0; i < n; ++i)
+            x[std::string(1 + i % 70, 'a' + i % 26)] = i;
+        return x;
+    });
+
+    // ----- test57 ------ */
+    m.def("return_adder", []() -> std::function<int(int)> { return Adder{ 5 }; });
+    m.def("times_two", &times_two);
+    m.def("function_target", [](std::function<int(int)> f) {
+        if (f.target<Adder>())
+            return "adder";
+        else if (f.target<int (*)(int)>())
+            return "function_pointer";
+        else
+            return "python";
+    });
+
+    // ----- test58 ------ */
+    m.def("vec_return_movable_copy", [](){
+        std::vector<Movable> x;
+        x.reserve(10);
+        for (int i = 0; i < 10; ++i)
+            x.emplace_back(i);
+        return x;
+    }, nb::rv_policy::copy);
+
+    m.def("list_return_movable_copy", [](){
+        std::list<Movable> x;
+        for (int i = 0; i < 10; ++i)
+            x.emplace_back(i);
+        return x;
+    }, nb::rv_policy::copy);
+
+    m.def("map_return_movable_copy", [](){
+        std::map<std::string, Movable> x;
+        for (int i = 0; i < 10; ++i)
+            x.emplace(std::string(1, 'a' + i), i);
+        return x;
+    }, nb::rv_policy::copy);
+
+    m.def("pair_return_movable_copy", [](){
+        return std::pair<Movable, Movable>(Movable(1), Movable(2));
+    }, nb::rv_policy::copy);
+
+    // ----- test59 ------ */
+    m.def("variant_index",
+          [](std::variant<double, int, bool, std::string, Copyable *, Movable> &x) {
+              return x.index();
+          });
+
+    // Asynchronous functions returning std::future<T>
+    m.def("future_add", [](int a, int b, int delay_ms) {
+        return std::async(std::launch::async, [=] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+            return a + b;
+        });
+    });
+    m.def("future_void", [] { return std::async(std::launch::async, [] { }); });
+    m.def("future_movable", [] {
+        return std::async(std::launch::async, [] { return Movable(8); });
+    });
+    m.def("future_error", [] {
+        return std::async(std::launch::async, []() -> int {
+            throw std::out_of_range("future error");
+        });
+    });
+
+    // Futures completed via nb::async_promise<T>
+    m.def("promise_add", [](int a, int b, int delay_ms) {
+        nb::async_promise<int> p;
+        nb::object f = p.get_future();
+        std::thread([p = std::move(p), a, b, delay_ms]() mutable {
+            std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+            p.set_value(a + b);
+        }).detach();
+        return f;
+    });
+    m.def("promise_void", [] {
+        nb::async_promise<void> p;
+        nb::object f = p.get_future();
+        p.set_value();
+        return f;
+    });
+    m.def("promise_error", [] {
+        nb::async_promise<int> p;
+        nb::object f = p.get_future();
+        std::thread([p = std::move(p)]() mutable {
+            p.set_exception(
+                std::make_exception_ptr(std::out_of_range("promise error")));
+        }).detach();
+        return f;
+    });
+    m.def("promise_broken", [] { return nb::async_promise<Movable>().get_future(); });
+
+    // ----- test63 ------ */
+    nb::class_<Tagged>(m, "Tagged");
+    m.def("vec_tagged", [] { return std::vector<Tagged>{ { 1 }, { 2 } }; });
 }
@@ -474,6 +474,13 @@ def test48_map_return_movable_value(clean):
         "map_return_movable_value() -> dict[str, test_stl_ext.Movable]"
     )
 
+def test48_map_return_movable_key(clean):
+    # The keys of a returned map are moved rather than copied
+    d = t.map_return_movable_key()
+    assert sorted((k.value, v) for k, v in d.items()) == [(0, 0), (1, 1), (2, 2)]
+    del d
+    assert_stats(value_constructed=3, move_constructed=6, destructed=9)
+
 def test49_map_return_copyable_value(clean):
     for i, (k, v) in enumerate(sorted(t.map_return_copyable_value().items())):
         assert k == chr(ord("a") + i)
@@ -511,3 +518,170 @@ def test54_map_movable_in_ptr(clean):
     assert t.map_movable_in_ptr.__doc__ == (
         "map_movable_in_ptr(x: dict[str, test_stl_ext.Movable]) -> None"
     )
+
+def test55_vec_arithmetic():
+    import array
+
+    assert t.vec_sum_f64([1.0, 2.5, 3]) == 6.5
+    assert t.vec_sum_f64((1.0, 2.0)) == 3.0
+    assert t.vec_sum_f64([]) == 0
+    assert t.vec_i32([1, 2, -3]) == [1, 2, -3]
+    assert t.vec_i32(range(4)) == [0, 1, 2, 3]
+
+    # Buffer protocol inputs are copied in bulk (with conversion if needed)
+    assert t.vec_sum_f64(array.array('d', [1, 2, 3])) == 6.0
+    assert t.vec_sum_f64(array.array('f', [1, 2, 3])) == 6.0
+    assert t.vec_i32(array.array('i', [4, 5, 6])) == [4, 5, 6]
+    assert t.vec_i32(array.array('q', [4, 5, 6])) == [4, 5, 6]
+    assert t.vec_i32(memoryview(array.array('i', range(6)))[::2]) == [0, 2, 4]
+    assert t.vec_u8(b'\x01\x02\xff') == [1, 2, 255]
+    assert t.vec_i32_noconvert(array.array('i', [7, 8])) == [7, 8]
+
+    with pytest.raises(TypeError):
+        t.vec_i32(array.array('q', [1 << 40]))
+    with pytest.raises(TypeError):
+        t.vec_i32(array.array('d', [1.5]))
+    # Without implicit conversions, mismatched buffers are loaded elementwise
+    assert t.vec_i32_noconvert(array.array('q', [7, 8])) == [7, 8]
+    with pytest.raises(TypeError):
+        t.vec_i32([1, 'a'])
+    with pytest.raises(TypeError):
+        t.vec_u8([-1])
+
+def test56_map_return_str_keys():
+    d1, d2 = t.map_return_str(3), t.map_return_str(3)
+    assert d1 == {'a': 0, 'bb': 1, 'ccc': 2} and d1 == d2
+    for k1, k2 in zip(d1, d2):
+        # Short keys are shared between conversions
+        assert k1 is k2
+
+    d = t.map_return_str(100)
+    assert len(d) == 100
+    assert all(len(k) == 1 + v % 70 for k, v in d.items())
+
+def test57_function_unwrap():
+    # nanobind functions created from C++ callables are passed through as-is
+    f = t.return_adder()
+    assert f(1) == 6
+    assert t.function_target(f) == 'adder'
+    assert t.call_function(f, 3) == 8
+    assert t.function_target(t.times_two) == 'function_pointer'
+    assert t.call_function(t.times_two, 3) == 6
+    assert t.function_target(lambda x: x) == 'python'
+
+
+def test58_rvalue_container_moves(clean):
+    # Elements of returned containers are moved even if a copy was requested
+    assert [v.value for v in t.vec_return_movable_copy()] == list(range(10))
+    assert_stats(value_constructed=10, move_constructed=10, destructed=20)
+    t.reset()
+
+    assert [v.value for v in t.list_return_movable_copy()] == list(range(10))
+    assert_stats(value_constructed=10, move_constructed=10, destructed=20)
+    t.reset()
+
+    s = sorted((k, v.value) for k, v in t.map_return_movable_copy().items())
+    assert s == [(chr(ord('a') + i), i) for i in range(10)]
+    assert_stats(value_constructed=10, move_constructed=10, destructed=20)
+    t.reset()
+
+    assert [v.value for v in t.pair_return_movable_copy()] == [1, 2]
+    assert_stats(value_constructed=2, move_constructed=4, destructed=6)
+
+
+def test59_variant_dispatch(clean):
+    # Exact type matches select the corresponding alternative
+    assert t.variant_index(1.5) == 0
+    assert t.variant_index(1) == 1
+    assert t.variant_index(True) == 2
+    assert t.variant_index("a") == 3
+    assert t.variant_index(t.Copyable()) == 4
+    assert t.variant_index(t.Movable()) == 5
+
+    # An exact match that fails to convert falls back to the ordered search
+    assert t.variant_index(1 << 40) == 0
+
+    with pytest.raises(TypeError):
+        t.variant_index([])
+
+
+def test60_future(clean):
+    import asyncio, time
+
+    async def run():
+        assert await t.future_add(1, 2, 0) == 3
+        assert await t.future_void() is None
+        assert (await t.future_movable()).value == 8
+        with pytest.raises(IndexError, match='future error'):
+            await t.future_error()
+
+        # The C++ futures are waited upon without blocking the event loop
+        start = time.monotonic()
+        results = await asyncio.gather(*[t.future_add(i, 1, 200)
+                                         for i in range(20)])
+        assert results == list(range(1, 21))
+        assert time.monotonic() - start < 2
+
+        # Cancelling discards the result
+        f = t.future_add(1, 2, 50)
+        f.cancel()
+        with pytest.raises(asyncio.CancelledError):
+            await f
+        await asyncio.sleep(0.1)
+
+    asyncio.run(run())
+
+    # The number of moves depends on the std::future implementation
+    gc.collect()
+    stats = t.stats()
+    assert stats['value_constructed'] == 1 and stats['copy_constructed'] == 0
+    assert stats['destructed'] == 1 + stats['move_constructed']
+
+    # Awaitables require a running event loop
+    with pytest.raises(RuntimeError):
+        t.future_add(1, 2, 0)
+    assert t.future_add.__doc__.startswith(
+        'future_add(arg0: int, arg1: int, arg2: int, /) -> Awaitable[int]')
+
+
+def test61_promise(clean):
+    import asyncio
+
+    async def run():
+        assert await t.promise_add(1, 2, 0) == 3
+        results = await asyncio.gather(*[t.promise_add(i, 1, 50)
+                                         for i in range(20)])
+        assert results == list(range(1, 21))
+        assert await t.promise_void() is None
+        with pytest.raises(IndexError, match='promise error'):
+            await t.promise_error()
+        with pytest.raises(RuntimeError):
+            await t.promise_broken()
+
+    asyncio.run(run())
+
+    with pytest.raises(RuntimeError):
+        t.promise_add(1, 2, 0)
+
+
+def test62_future_shutdown():
+    # Futures that complete during or after shutdown are discarded
+    import os, subprocess, sys
+    code = (
+        "import asyncio, atexit, time, test_stl_ext as t\n"
+        "atexit.register(time.sleep, 0.3)\n"
+        "futures = []\n"
+        "async def run():\n"
+        "    futures.extend([t.future_add(1, 2, 100), t.promise_add(1, 2, 100),\n"
+        "                    t.future_add(1, 2, 0), t.future_add(1, 2, 1000)])\n"
+        "asyncio.run(run())\n"
+    )
+    env = dict(os.environ, PYTHONPATH=os.pathsep.join(sys.path))
+    result = subprocess.run([sys.executable, '-c', code], env=env,
+                            capture_output=True, text=True)
+    assert result.returncode == 0 and not result.stderr, result.stderr
+
+
+def test63_vector_custom_caster():
+    # Custom casters of bound types are used for each element
+    assert t.vec_tagged() == [1, 2]
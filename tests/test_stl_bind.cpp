@@ -0,0 +1,70 @@
+#include <nanobind/stl/bind_vector.h>
+#include <nanobind/stl/bind_map.h>
+#include <nanobind/stl/string.h>
+#include <nanobind/make_iterator.h>
+#include <map>
+#include <unordered_map>
+
+namespace nb = nanobind;
+
+struct El {
+    El(int v) : a(v) { }
+    int a;
+};
+
+NB_MODULE(test_stl_bind_ext, m) {
+    nb::bind_vector<std::vector<int>>(m, "VectorInt");
+    nb::bind_vector<std::vector<bool>>(m, "VectorBool");
+
+    nb::class_<El>(m, "El")
+        .def(nb::init<int>())
+        .def_readwrite("a", &El::a);
+
+    nb::bind_vector<std::vector<El>>(m, "VectorEl");
+
+    m.def("vector_el", [](size_t n) {
+        std::vector<El> v;
+        for (size_t i = 0; i < n; ++i)
+            v.emplace_back((int) i);
+        return v;
+    });
+
+    m.def("sum_el", [](const std::vector<El> &v) {
+        int sum = 0;
+        for (const El &e : v)
+            sum += e.a;
+        return sum;
+    });
+
+    nb::bind_map<std::map<std::string, double>>(m, "MapStringDouble");
+    nb::bind_map<std::unordered_map<int, El>>(m, "UnorderedMapIntEl");
+
+    m.def("map_int_el", []() {
+        std::unordered_map<int, El> m;
+        m.emplace(1, El(10));
+        m.emplace(2, El(20));
+        return m;
+    });
+
+    m.def("iter_el", [](std::vector<El> &v) {
+        return nb::make_iterator(nb::type<std::vector<El>>(), "ElIterator",
+                                 v.begin(), v.end());
+    }, nb::keep_alive<0, 1>());
+
+    m.def("iter_keys", [](std::map<std::string, double> &v) {
+        return nb::make_key_iterator(nb::type<std::map<std::string, double>>(),
+                                     "KeyIterator2", v.begin(), v.end());
+    }, nb::keep_alive<0, 1>());
+
+    m.def("iter_el_chunked", [](std::vector<El> &v, size_t chunk_size) {
+        return nb::make_chunked_iterator(nb::type<std::vector<El>>(),
+                                         "ElChunkIterator", v.begin(), v.end(),
+                                         chunk_size);
+    }, nb::keep_alive<0, 1>());
+
+    m.def("iter_int_chunked", [](std::vector<int> &v, size_t chunk_size) {
+        return nb::make_chunked_iterator<nb::numpy>(
+            nb::type<std::vector<int>>(), "IntChunkIterator", v.begin(),
+            v.end(), chunk_size);
+    }, nb::keep_alive<0, 1>());
+}
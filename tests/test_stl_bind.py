@@ -0,0 +1,131 @@
+import test_stl_bind_ext as t
+import pytest
+import gc
+
+try:
+    import numpy as np
+    def needs_numpy(x):
+        return x
+except:
+    needs_numpy = pytest.mark.skip(reason="NumPy is required")
+
+
+def test01_vector_int():
+    v = t.VectorInt()
+    assert len(v) == 0 and not v
+    v.append(1)
+    v.extend([2, 3])
+    assert len(v) == 3 and v
+    assert v[0] == 1 and v[-1] == 3
+    assert list(v) == [1, 2, 3]
+    v[1] = 5
+    del v[0]
+    assert list(v) == [5, 3]
+    v.insert(0, 7)
+    assert v.pop() == 3
+    assert list(v) == [7, 5]
+    with pytest.raises(IndexError):
+        v[2]
+    assert list(t.VectorInt([4, 5, 6])) == [4, 5, 6]
+    assert list(t.VectorInt(v)) == [7, 5]
+    with pytest.raises(RuntimeError):
+        t.VectorInt([1, 'a'])
+    v.clear()
+    assert len(v) == 0
+
+
+def test02_vector_el_reference():
+    v = t.vector_el(4)
+    assert isinstance(v, t.VectorEl)
+    assert t.sum_el(v) == 6
+
+    # Element accesses are views into the container
+    e = v[2]
+    e.a = 100
+    assert v[2].a == 100
+    assert t.sum_el(v) == 104
+
+    # .. which keep the container alive
+    del v
+    gc.collect()
+    assert e.a == 100
+    assert [x.a for x in t.vector_el(3)] == [0, 1, 2]
+
+
+def test03_map():
+    m = t.MapStringDouble()
+    m['a'] = 1.0
+    m['b'] = 2.5
+    assert len(m) == 2
+    assert 'a' in m and 'c' not in m and 5 not in m
+    assert m['b'] == 2.5
+    with pytest.raises(KeyError):
+        m['c']
+    assert list(m) == ['a', 'b']
+    assert list(m.keys()) == ['a', 'b']
+    assert list(m.values()) == [1.0, 2.5]
+    assert list(m.items()) == [('a', 1.0), ('b', 2.5)]
+    del m['a']
+    assert list(m) == ['b']
+    m.clear()
+    assert not m
+
+
+def test04_map_reference():
+    m = t.map_int_el()
+    assert sorted(m) == [1, 2]
+    m[1].a = 11
+    assert m[1].a == 11
+    values = m.items()
+    del m
+    gc.collect()
+    assert sorted((k, v.a) for k, v in values) == [(1, 11), (2, 20)]
+
+
+def test05_make_iterator():
+    v = t.vector_el(5)
+    it = t.iter_el(v)
+    assert iter(it) is it
+    del v
+    gc.collect()
+
+    # Elements reference the (still alive) container
+    els = list(it)
+    assert [e.a for e in els] == [0, 1, 2, 3, 4]
+    v = t.vector_el(1)
+    next(t.iter_el(v)).a = 7
+    assert v[0].a == 7
+
+    m = t.MapStringDouble()
+    m["a"] = 1.0
+    m["b"] = 2.0
+    assert list(t.iter_keys(m)) == ["a", "b"]
+
+
+def test06_make_chunked_iterator():
+    v = t.vector_el(5)
+    chunks = list(t.iter_el_chunked(v, 2))
+    assert [tuple(e.a for e in c) for c in chunks] == [(0, 1), (2, 3), (4,)]
+    assert all(type(c) is tuple for c in chunks)
+    assert list(t.iter_el_chunked(t.vector_el(0), 2)) == []
+
+    with pytest.raises(RuntimeError):
+        t.iter_el_chunked(v, 0)
+
+
+@needs_numpy
+def test07_make_chunked_iterator_tensor():
+    v = t.VectorInt()
+    v.extend(range(10))
+    chunks = list(t.iter_int_chunked(v, 4))
+    assert all(isinstance(c, np.ndarray) for c in chunks)
+    assert [c.tolist() for c in chunks] == [[0, 1, 2, 3], [4, 5, 6, 7], [8, 9]]
+
+
+def test08_vector_bool():
+    v = t.VectorBool([True, False])
+    v.append(True)
+    assert list(v) == [True, False, True]
+    v[1] = True
+    assert v[1] is True and v.pop(0) is True
+    assert len(v) == 2
@@ -1,6 +1,11 @@
 #include <nanobind/nanobind.h>
 #include <nanobind/tensor.h>
+#include <nanobind/parallel.h>
 #include <algorithm>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <set>
 
 namespace nb = nanobind;
 
@@ -8,6 +13,30 @@ using namespace nb::literals;
 
 int destruct_count = 0;
 
+struct Particle {
+    double x;
+    float pos[3];
+    int32_t id;
+    bool active;
+};
+
+NB_MAKE_RECORD(Particle)
+
+struct Unregistered {
+    int32_t value;
+};
+
+NB_MAKE_RECORD(Unregistered)
+
+/// Byte container that counts the destruction of its payload
+struct CountedBytes : std::vector<uint8_t> {
+    bool owner = true;
+    using std::vector<uint8_t>::vector;
+    CountedBytes(CountedBytes &&o) noexcept
+        : std::vector<uint8_t>(std::move(o)) { o.owner = false; }
+    ~CountedBytes() { destruct_count += owner; }
+};
+
 NB_MODULE(test_tensor_ext, m) {
     m.def("get_shape", [](const nb::tensor<> &t) {
         nb::list l;
@@ -16,6 +45,24 @@ NB_MODULE(test_tensor_ext, m) {
         return l;
     }, "array"_a.noconvert());
 
+    m.def("get_dtype", [](const nb::tensor<> &t) {
+        return nb::make_tuple(t.dtype().code, t.dtype().bits, t.dtype().lanes);
+    });
+
+    m.def("sum_const_u8", [](nb::tensor<const uint8_t, nb::shape<nb::any>> t) {
+        size_t result = 0;
+        for (size_t i = 0; i < t.shape(0); ++i)
+            result += t(i);
+        return result;
+    });
+
+    m.def("count_const_bool", [](nb::tensor<const bool, nb::shape<nb::any>> t) {
+        size_t result = 0;
+        for (size_t i = 0; i < t.shape(0); ++i)
+            result += t(i);
+        return result;
+    });
+
     m.def("check_float", [](const nb::tensor<> &t) {
         return t.dtype() == nb::dtype<float>();
     });
@@ -100,6 +147,15 @@ NB_MODULE(test_tensor_ext, m) {
     });
     m.def("passthrough", [](nb::tensor<> a) { return a; });
 
+    m.def("ret_numpy_const", [](bool f_order) {
+        static const float data[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+        size_t shape[2] = { 2, 4 };
+        int64_t strides[2] = { 1, 2 };
+
+        return nb::tensor<nb::numpy, const float, nb::shape<2, 4>>(
+            (void *) data, 2, shape, nb::handle(), f_order ? strides : nullptr);
+    });
+
     m.def("ret_numpy", []() {
         float *f = new float[8] { 1, 2, 3, 4, 5, 6, 7, 8 };
         size_t shape[2] = { 2, 4 };
@@ -137,4 +193,248 @@ NB_MODULE(test_tensor_ext, m) {
 
             return nb::tensor<nb::numpy, float>(f, 0, shape, deleter);
         });
+
+    m.def("vec_add", nb::vectorize([](double a, double b) { return a + b; }));
+    m.def("vec_fma", nb::vectorize<nb::numpy>(
+        [](float a, float b, float c) { return a * b + c; }));
+
+    m.def("flatten", [](nb::tensor<double, nb::c_contig, nb::device::cpu> t) {
+        size_t size = 1;
+        for (size_t i = 0; i < t.ndim(); ++i)
+            size *= t.shape(i);
+        nb::list l;
+        for (size_t i = 0; i < size; ++i)
+            l.append(((const double *) t.data())[i]);
+        return l;
+    }, "array"_a.noconvert());
+
+    m.def("flatten_c", [](nb::tensor<float, nb::c_contig, nb::device::cpu> t) {
+        size_t size = 1;
+        for (size_t i = 0; i < t.ndim(); ++i)
+            size *= t.shape(i);
+        nb::list l;
+        for (size_t i = 0; i < size; ++i)
+            l.append(((const float *) t.data())[i]);
+        return l;
+    });
+
+    m.def("flatten_f", [](nb::tensor<int32_t, nb::f_contig, nb::device::cpu> t) {
+        size_t size = 1;
+        for (size_t i = 0; i < t.ndim(); ++i)
+            size *= t.shape(i);
+        nb::list l;
+        for (size_t i = 0; i < size; ++i)
+            l.append(((const int32_t *) t.data())[i]);
+        return l;
+    });
+
+    using view_3x3 = nb::detail::tensor_view<float, nb::shape<3, 3>, 'C'>;
+    using view_nx2_f = nb::detail::tensor_view<float, nb::shape<nb::any, 2>, 'F'>;
+    static_assert(view_3x3::static_stride(0) == 3 && view_3x3::static_stride(1) == 1);
+    static_assert(view_nx2_f::static_stride(0) == 1 && view_nx2_f::static_stride(1) == 0);
+
+    m.def("view_trace", [](nb::tensor<float, nb::shape<3, 3>, nb::c_contig,
+                                      nb::device::cpu> t) {
+        auto v = t.view();
+        float result = 0.f;
+        for (size_t i = 0; i < v.shape<0>(); ++i)
+            result += v(i, i);
+        return result;
+    });
+
+    m.def("view_sum", [](nb::tensor<float, nb::shape<nb::any, nb::any>,
+                                    nb::c_contig, nb::device::cpu> t) {
+        float result = 0.f;
+        for (float value : t.view())
+            result += value;
+        return result;
+    });
+
+    m.def("view_transpose", [](nb::tensor<int32_t, nb::shape<nb::any, nb::any>,
+                                          nb::f_contig, nb::device::cpu> t) {
+        auto v = t.view();
+        nb::list l;
+        for (size_t j = 0; j < v.shape(1); ++j)
+            for (size_t i = 0; i < v.shape(0); ++i)
+                l.append(v(i, j));
+        return l;
+    });
+
+    m.def("view_f_created", []() {
+        static float data[6] = { 0, 1, 2, 3, 4, 5 };
+        size_t shape[2] = { 2, 3 };
+        nb::tensor<float, nb::shape<2, 3>, nb::f_contig> t(data, 2, shape);
+        return nb::make_tuple(t.stride(0), t.stride(1), t(1, 2),
+                              t.view()(1, 2), t.view()(1, 0));
+    });
+
+    m.def("view_mismatch", []() {
+        static float data[6] = { 0, 1, 2, 3, 4, 5 };
+        size_t shape[2] = { 2, 3 };
+        int64_t strides[2] = { 1, 2 };
+        nb::tensor<float, nb::shape<2, 3>, nb::c_contig> t(data, 2, shape,
+                                                           nb::handle(), strides);
+        float value = t(1, 2);
+        (void) t.view();
+        return value;
+    });
+
+    m.def("view_strided", [](nb::tensor<double, nb::shape<nb::any>> t) {
+        auto v = t.view();
+        nb::list l;
+        for (size_t i = 0; i < v.shape(0); ++i)
+            l.append(v(i));
+        return l;
+    });
+
+    m.def("parallel_scale", [](nb::tensor<float, nb::shape<nb::any, nb::any>,
+                                          nb::c_contig, nb::device::cpu> t,
+                               float scale) {
+        auto v = t.view();
+        nb::parallel_for(t, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                for (size_t j = 0; j < v.shape(1); ++j)
+                    v(i, j) *= scale;
+        }, 1);
+    });
+
+    m.def("parallel_sum", [](size_t begin, size_t end, size_t grain) {
+        std::atomic<uint64_t> sum { 0 };
+        std::atomic<bool> gil_held { false };
+        std::mutex mutex;
+        std::set<std::thread::id> threads;
+
+        nb::parallel_for(begin, end, [&](size_t b, size_t e) {
+            uint64_t partial = 0;
+            for (size_t i = b; i < e; ++i)
+                partial += i;
+            sum += partial;
+#if !defined(Py_LIMITED_API)
+            if (PyGILState_Check())
+                gil_held = true;
+#endif
+            std::lock_guard<std::mutex> guard(mutex);
+            threads.insert(std::this_thread::get_id());
+        }, grain);
+
+#if defined(Py_LIMITED_API)
+        // The stable ABI can't tell whether the GIL is held
+        (void) gil_held;
+        return nb::make_tuple(sum.load(), nb::none(), threads.size());
+#else
+        return nb::make_tuple(sum.load(), gil_held.load(), threads.size());
+#endif
+    });
+
+    m.def("parallel_nested", [](size_t n) {
+        std::atomic<size_t> count { 0 };
+        nb::parallel_for(0, n, [&](size_t b, size_t e) {
+            for (size_t i = b; i < e; ++i)
+                nb::parallel_for(0, n, [&](size_t b2, size_t e2) {
+                    count += e2 - b2;
+                });
+        });
+        return count.load();
+    });
+
+    m.def("parallel_raise", [](size_t n, size_t where) {
+        nb::parallel_for(0, n, [&](size_t b, size_t e) {
+            if (where >= b && where < e)
+                throw std::runtime_error("failure at " + std::to_string(where));
+        });
+    });
+
+    m.def("parallel_threads", []() { return nb::detail::parallel_threads(); });
+
+    m.def("get_shape_stream", [](nb::tensor<nb::dlpack_stream<2>> t) {
+        nb::list l;
+        for (size_t i = 0; i < t.ndim(); ++i)
+            l.append(t.shape(i));
+        return l;
+    });
+
+    nb::record_dtype<Particle>(nb::record_field("x", &Particle::x),
+                               nb::record_field("pos", &Particle::pos),
+                               nb::record_field("id", &Particle::id));
+
+    auto make_particles = [](size_t n) {
+        std::vector<Particle> v(n);
+        for (size_t i = 0; i < n; ++i)
+            v[i] = Particle{ (double) i, { 1.f, 2.f, (float) i }, (int32_t) i * 10, true };
+        return v;
+    };
+
+    m.def("ret_particles", [make_particles](size_t n) {
+        return nb::tensor_from_vector(make_particles(n));
+    });
+
+    m.def("ret_particles_numpy", [make_particles](size_t n) {
+        return nb::tensor_from_vector<nb::numpy>(make_particles(n));
+    });
+
+    m.def("ret_unregistered", []() {
+        return nb::tensor_from_vector(std::vector<Unregistered>(2));
+    });
+
+    m.def("ret_vector", [](size_t n) {
+        std::vector<double> v(n);
+        for (size_t i = 0; i < n; ++i)
+            v[i] = (double) i;
+        return nb::tensor_from_vector(std::move(v));
+    });
+
+    m.def("ret_allocated", [](size_t n, size_t alignment) {
+        auto t = nb::tensor<float, nb::shape<nb::any, 2>>::allocate({ n, 2 }, alignment);
+        if ((uintptr_t) t.data() % alignment != 0)
+            throw std::runtime_error("misaligned storage!");
+        for (size_t i = 0; i < n; ++i) {
+            t(i, 0) = (float) i;
+            t(i, 1) = (float) -(int) i;
+        }
+        return t;
+    });
+
+    m.def("allocated_f_layout", [](size_t n) {
+        auto t = nb::tensor<float, nb::shape<nb::any, 2>, nb::f_contig>::allocate({ n, 2 });
+        for (size_t i = 0; i < n; ++i) {
+            t(i, 0) = (float) i;
+            t(i, 1) = (float) -(int) i;
+        }
+        nb::list l;
+        for (size_t i = 0; i < 2 * n; ++i)
+            l.append(((const float *) t.data())[i]);
+        return nb::make_tuple(t.stride(0), t.stride(1), l);
+    });
+
+    m.def("ret_vector_numpy", [](size_t n) {
+        return nb::tensor_from_vector<nb::numpy>(std::vector<int32_t>(n, 7));
+    });
+
+    m.def("ret_bytes_buffer", [](size_t n) {
+        std::vector<uint8_t> v(n);
+        for (size_t i = 0; i < n; ++i)
+            v[i] = (uint8_t) i;
+        return nb::bytes_buffer(std::move(v));
+    });
+
+    m.def("ret_counted_buffer", [](size_t n) {
+        return nb::bytes_buffer(CountedBytes(n, 1));
+    });
+
+    m.def("ret_string_buffer", [](const char *s) {
+        return nb::bytes_buffer(std::string(s));
+    });
+
+    m.def("fill_out",
+          [](nb::tensor<nb::numpy, float, nb::shape<nb::any>, nb::device::cpu> out,
+             float value) {
+              for (size_t i = 0; i < out.shape(0); ++i)
+                  out(i) = value;
+              return out;
+          }, "out"_a.noconvert(), "value"_a);
+
+    m.def("pass_readonly",
+          [](nb::tensor<nb::numpy, const float, nb::shape<nb::any>> a) {
+              return a;
+          });
 }
@@ -3,6 +3,7 @@ import pytest
 import warnings
 import gc
 import importlib
+import array
 
 try:
     import numpy as np
@@ -335,3 +336,353 @@ def test18_return_array_scalar():
     del x
     gc.collect()
     assert t.destruct_count() - dc == 1
+
+
+def test19_vectorize():
+    a = array.array('d', [1, 2, 3])
+    assert t.flatten(t.vec_add(a, 10)) == [11, 12, 13]
+    assert t.flatten(t.vec_add(a, a)) == [2, 4, 6]
+    assert t.get_shape(t.vec_add(1.5, 2)) == []
+    assert t.flatten(t.vec_add(1.5, 2)) == [3.5]
+
+    m = memoryview(array.array('d', [0, 10, 20, 30, 40, 50])).cast('B').cast('d', (2, 3))
+    r = t.vec_add(m, a)
+    assert t.get_shape(r) == [2, 3]
+    assert t.flatten(t.vec_add(m, a)) == [1, 12, 23, 31, 42, 53]
+
+    with pytest.raises(RuntimeError) as excinfo:
+        t.vec_add(a, array.array('d', [1, 2]))
+    assert 'incompatible shapes' in str(excinfo.value)
+
+    with pytest.raises(TypeError):
+        t.vec_add(a, 'hello')
+
+    assert 'Union[float, tensor[dtype=float64, device=\'cpu\']]' in t.vec_add.__doc__
+
+
+@needs_numpy
+def test20_vectorize_numpy():
+    a = np.arange(6, dtype=np.float32).reshape(2, 3)
+    b = np.array([1, 2, 3], dtype=np.float32)
+    r = t.vec_fma(a, b, 1)
+    assert isinstance(r, np.ndarray)
+    assert np.array_equal(r, a * b + 1)
+    assert np.array_equal(t.vec_fma(a.T, 2, 0), a.T * 2)
+
+
+def test21_tensor_from_vector():
+    c = t.ret_vector(5)
+    assert 'dltensor' in repr(c)
+    assert t.flatten(c) == [0.0, 1.0, 2.0, 3.0, 4.0]
+    assert t.flatten(t.ret_vector(0)) == []
+    assert t.ret_vector.__doc__ == \
+        'ret_vector(arg: int, /) -> tensor[dtype=float64, shape=(*)]'
+
+
+@needs_numpy
+def test22_tensor_from_vector_numpy():
+    a = t.ret_vector_numpy(1000)
+    assert a.dtype == np.int32 and a.shape == (1000,)
+    assert np.all(a == 7)
+
+
+def test23_import_cache():
+    # Conversion strategies are memoized per Python type
+    class Wrapper:
+        def __init__(self, n):
+            self.n = n
+        def __dlpack__(self):
+            return t.ret_vector(self.n)
+
+    for i in range(3):
+        assert t.flatten(Wrapper(i)) == [float(j) for j in range(i)]
+
+    class Buffer(array.array):
+        pass
+
+    for i in range(3):
+        assert t.flatten(Buffer('d', [i, 1])) == [float(i), 1.0]
+
+    # Entries of destroyed types are purged (the address may be reused)
+    del Wrapper, Buffer
+    gc.collect()
+
+    class Other:
+        pass
+
+    for i in range(3):
+        with pytest.raises(TypeError):
+            t.flatten(Other())
+
+
+@needs_numpy
+def test24_out_parameter():
+    a = np.zeros(4, dtype=np.float32)
+    for i in range(3):
+        # The function writes into 'a' and returns the same array
+        assert t.fill_out(a, i) is a
+        assert np.all(a == i)
+
+    # Arrays requiring a conversion are rejected
+    with pytest.raises(TypeError):
+        t.fill_out(np.zeros(4, dtype=np.float64), 1)
+
+    # Repeated returns reuse the cached conversion function
+    for i in range(3):
+        assert t.ret_numpy().shape == (2, 4)
+
+    # Tensors returned as read-only aren't forwarded as the writable source
+    b = t.pass_readonly(a)
+    assert b is not a and not b.flags.writeable
+    assert np.all(b == a)
+
+
+def test25_native_conversion():
+    # dtype conversion
+    assert t.flatten_c(array.array('d', [1, 2, 3])) == [1.0, 2.0, 3.0]
+    assert t.flatten_c(array.array('h', [4, -5])) == [4.0, -5.0]
+
+    # Strided -> contiguous
+    m = memoryview(array.array('f', range(6)))[::2]
+    assert t.flatten_c(m) == [0.0, 2.0, 4.0]
+
+    # Relayout into Fortran order combined with a dtype conversion
+    m = memoryview(array.array('q', range(6))).cast('B').cast('q', (2, 3))
+    assert t.flatten_f(m) == [0, 3, 1, 4, 2, 5]
+
+    # Float -> int and overflowing values are not converted
+    with pytest.raises(TypeError):
+        t.flatten_f(array.array('d', [1, 2]))
+    with pytest.raises(TypeError):
+        t.flatten_f(array.array('q', [1 << 40]))
+
+    # Conversions to float round to the nearest representable value
+    import struct
+    f32 = lambda v: struct.unpack('f', struct.pack('f', v))[0]
+    assert t.flatten_c(array.array('d', [0.1])) == [f32(0.1)] != [0.1]
+    assert t.flatten_c(array.array('q', [(1 << 40) + 1])) == [float(1 << 40)]
+
+
+def test26_handle_pool():
+    # Handles of small tensors are recycled, larger ranks use separate blocks
+    for i in range(100):
+        n = i % 7
+        assert t.flatten(t.ret_vector(n)) == [float(j) for j in range(n)]
+        shape = (1,) * n + (2,)
+        m = memoryview(array.array('d', [i, 1])).cast('B').cast('d', shape)
+        assert t.get_shape(m) == list(shape)
+        assert t.flatten(m) == [float(i), 1.0]
+
+
+def test27_allocate():
+    # Sizes cover pooled size classes and unpooled (> 1 MiB) storage
+    for n in [0, 1, 5, 100, 1000, 200000]:
+        for alignment in [1, 64, 256]:
+            assert t.get_shape(t.ret_allocated(n, alignment)) == [n, 2]
+            if n <= 5:
+                ref = sum([[float(i), float(-i)] for i in range(n)], [])
+                assert t.flatten_c(t.ret_allocated(n, alignment)) == ref
+
+    for alignment in [0, 3, 512]:
+        with pytest.raises(RuntimeError) as excinfo:
+            t.ret_allocated(1, alignment)
+        assert 'alignment' in str(excinfo.value)
+
+    # The size computation must not wrap around
+    for n in [2**61, 2**63]:
+        with pytest.raises(RuntimeError) as excinfo:
+            t.ret_allocated(n, 64)
+        assert 'too large' in str(excinfo.value)
+
+    assert t.allocated_f_layout(3) == (1, 3, [0.0, 1.0, 2.0, 0.0, -1.0, -2.0])
+
+
+def test28_view():
+    m = memoryview(array.array('f', range(9))).cast('B').cast('f', (3, 3))
+    assert t.view_trace(m) == 12.0
+    assert t.view_sum(m) == 36.0
+    assert t.view_sum(t.ret_allocated(0, 64)) == 0.0
+    assert t.view_sum(t.ret_allocated(3, 64)) == 0.0
+
+    m = memoryview(array.array('i', range(6))).cast('B').cast('i', (2, 3))
+    assert t.view_transpose(m) == [0, 3, 1, 4, 2, 5]
+
+    m = memoryview(array.array('d', range(6)))[1::2]
+    assert t.view_strided(m) == [1.0, 3.0, 5.0]
+
+    assert t.view_f_created() == (1, 2, 5.0, 5.0, 1.0)
+    with pytest.raises(RuntimeError) as excinfo:
+        t.view_mismatch()
+    assert 'does not match its annotations' in str(excinfo.value)
+
+
+def test29_parallel_for():
+    import os
+    os.environ.setdefault('NB_NUM_THREADS', '4')
+    threads = t.parallel_threads()
+    assert threads >= 1
+
+    n = 100000
+    total, gil_held, used = t.parallel_sum(0, n, 1)
+    assert total == n * (n - 1) // 2 and not gil_held
+    assert 1 <= used <= threads
+
+    # Offset ranges, empty ranges and ranges below the grain size
+    assert t.parallel_sum(10, 20, 1)[0] == sum(range(10, 20))
+    assert t.parallel_sum(5, 5, 1)[0] == 0
+    assert t.parallel_sum(0, 10, 100) in ((45, True, 1), (45, None, 1))
+
+    assert t.parallel_nested(100) == 10000
+
+    for where in [0, 55555, 99999]:
+        with pytest.raises(RuntimeError) as excinfo:
+            t.parallel_raise(n, where)
+        assert str(excinfo.value) == 'failure at %i' % where
+
+    a = array.array('f', range(12))
+    t.parallel_scale(memoryview(a).cast('B').cast('f', (4, 3)), 2.0)
+    assert list(a) == [2.0 * i for i in range(12)]
+
+
+def test30_dlpack_stream():
+    class Producer:
+        def __init__(self, device_type, accept_stream=True):
+            self.device_type = device_type
+            self.accept_stream = accept_stream
+            self.calls = []
+
+        def __dlpack_device__(self):
+            return (self.device_type, 0)
+
+        def __dlpack__(self, **kwargs):
+            if kwargs and not self.accept_stream:
+                raise TypeError("unsupported")
+            self.calls.append(kwargs.get('stream'))
+            return t.ret_allocated(3, 64)
+
+    # The stream is only passed to producers of CUDA/ROCm tensors
+    p = Producer(2)
+    assert t.get_shape_stream(p) == [3, 2]
+    assert p.calls == [2]
+
+    p = Producer(1)
+    assert t.get_shape_stream(p) == [3, 2]
+    assert p.calls == [None]
+
+    # Producers that don't support the 'stream' argument are still accepted
+    p = Producer(2, accept_stream=False)
+    assert t.get_shape_stream(p) == [3, 2]
+    assert p.calls == [None]
+
+    # Without the annotation, '__dlpack__' is called without arguments
+    p = Producer(2)
+    assert t.get_shape(p) == [3, 2]
+    assert p.calls == [None]
+
+
+
+@needs_numpy
+def test31_readonly_buffer():
+    for i in range(10):
+        x = t.ret_numpy_const(False)
+        assert not x.flags.writeable
+        assert np.all(x == [[1, 2, 3, 4], [5, 6, 7, 8]])
+        with pytest.raises(ValueError):
+            x[0, 0] = 0
+
+    x = t.ret_numpy_const(True)
+    assert not x.flags.writeable and x.flags.f_contiguous
+    assert np.all(x == [[1, 3, 5, 7], [2, 4, 6, 8]])
+
+
+def test32_buffer_formats():
+    import ctypes, mmap, sys
+
+    # Byte order prefixes and platform-dependent sizes
+    assert t.get_dtype((ctypes.c_double * 3)()) == (2, 64, 1)
+    assert t.get_dtype((ctypes.c_long * 3)()) == (0, ctypes.sizeof(ctypes.c_long) * 8, 1)
+    foreign = ctypes.c_int32.__ctype_be__ if sys.byteorder == 'little' \
+        else ctypes.c_int32.__ctype_le__
+    with pytest.raises(TypeError):
+        t.get_dtype((foreign * 3)())
+
+    # Booleans
+    assert t.get_dtype((ctypes.c_bool * 3)()) == (6, 8, 1)
+    assert t.count_const_bool(memoryview(b'\x01\x00\x01').cast('?')) == 2
+
+    # Read-only memory is only accepted by tensors of const scalars
+    assert t.sum_const_u8(b'\x01\x02\x03') == 6
+    assert t.sum_const_u8(bytearray(b'\x01\x02')) == 3
+    with pytest.raises(TypeError):
+        t.get_shape(b'\x01\x02\x03')
+
+    m = mmap.mmap(-1, 16)
+    m.write(b'\x05' * 16)
+    assert t.sum_const_u8(m) == 80
+    assert t.get_shape(m) == [16]
+    del m
+
+
+@needs_numpy
+def test33_buffer_formats_numpy():
+    # Formats that are only produced by NumPy's buffer protocol implementation
+    for dtype, dt in [(np.complex64, (5, 64, 1)), (np.complex128, (5, 128, 1)),
+                      (np.float16, (2, 16, 1)), (np.bool_, (6, 8, 1))]:
+        a = np.zeros(3, dtype=dtype)
+        assert t.get_dtype(memoryview(a)) == dt
+
+
+def test34_record_dtype():
+    import struct
+    mv = memoryview(t.ret_particles(3))
+    assert mv.format == 'T{=d:x:=(3)f:pos:=i:id:xxxxxxxx}'
+    assert mv.itemsize == 32 and mv.shape == (3,) and mv.nbytes == 96
+    data = mv.tobytes()
+    for i in range(3):
+        assert struct.unpack_from('=d3fi', data, 32 * i) == (i, 1.0, 2.0, i, i * 10)
+
+    # The record dtype code is never exported via DLPack
+    with pytest.raises(TypeError) as excinfo:
+        t.ret_particles(3).__dlpack__()
+    assert 'DLPack' in str(excinfo.value)
+
+    with pytest.raises(TypeError) as excinfo:
+        t.ret_unregistered()
+    assert 'nb::record_dtype()' in str(excinfo.value)
+
+
+@needs_numpy
+def test35_record_dtype_numpy():
+    a = t.ret_particles_numpy(3)
+    assert a.dtype.names == ('x', 'pos', 'id')
+    assert a.dtype.itemsize == 32
+    assert np.all(a['x'] == [0, 1, 2])
+    assert a['pos'].shape == (3, 3)
+    assert np.all(a['id'] == [0, 10, 20])
+
+
+def test36_bytes_buffer():
+    b = t.ret_bytes_buffer(300)
+    mv = memoryview(b)
+    assert mv.readonly and mv.format == 'B' and mv.nbytes == 300
+    assert mv.tobytes() == bytes(i % 256 for i in range(300))
+    assert bytes(b) == mv.tobytes()
+    with pytest.raises(TypeError):
+        mv[0] = 1
+    del b
+    assert mv[299] == 43
+
+    assert bytes(t.ret_string_buffer('hi')) == b'hi'
+
+    gc.collect()
+    dc = t.destruct_count()
+    mv = memoryview(t.ret_counted_buffer(4))
+    assert dc == t.destruct_count()
+    assert mv.tobytes() == b'\x01' * 4
+    del mv
+    gc.collect()
+    assert t.destruct_count() - dc == 1
+
+    assert bytes(t.ret_bytes_buffer(0)) == b''
+    assert t.ret_string_buffer.__doc__ == \
+        'ret_string_buffer(arg: str, /) -> object'